@@ -11,6 +11,7 @@
 #include <allocs.h>
 #include <config.h>
 #include <iostream>
+#include <throw.h>
 #include <type_traits>
 
 
@@ -35,11 +36,17 @@ public:
 
     [[nodiscard]] _MYSTL_CONSTEXPR_SINCE_CXX20 value_type* allocate(size_type __n) {
         static_assert(sizeof(value_type) >= 0, "cannot allocate memory for an incomplete type");
-        if (__n > std::allocator_traits<allocator>::max_size(*this)) throw std::bad_array_new_length();
+        if (__n > std::allocator_traits<allocator>::max_size(*this)) mystl::__throw_bad_array_new_length();
         // std::cout << "[mystl::allocator]: allocate " << __n << std::endl;
         return static_cast<value_type*>(alloc::allocate(__n * sizeof(value_type)));
     }
 
+    // 失败时返回空指针而不是抛出异常，供容器的 try_* 系列使用
+    [[nodiscard]] value_type* try_allocate(size_type __n) noexcept {
+        if (__n > std::allocator_traits<allocator>::max_size(*this)) return nullptr;
+        return static_cast<value_type*>(alloc::try_allocate(__n * sizeof(value_type)));
+    }
+
     _MYSTL_CONSTEXPR_SINCE_CXX20 void deallocate(value_type* __p, size_type __n) noexcept {
         alloc::deallocate(__p, __n);
         // std::cout << "[mystl::allocator]: deallocate " << __n << std::endl;
@@ -105,6 +112,13 @@ struct is_allocator<T,
 template <typename T>
 constexpr bool is_allocator_v = is_allocator<T>::value;
 
+// 分配器是否提供不抛出异常的 try_allocate(n)，失败时返回空指针
+template <typename T, typename = void>
+struct __has_try_allocate : std::false_type {};
+
+template <typename T>
+struct __has_try_allocate<T, std::void_t<decltype(std::declval<T&>().try_allocate(std::size_t(1)))>> : std::true_type {};
+
 _MYSTL_END_NAMESPACE_MYSTL
 
 #endif // _MYSTL_ALLOCATOR_H
@@ -11,6 +11,7 @@
 #define _MYSTL_ALLOCS_H
 
 #include <config.h>
+#include <new>
 
 _MYSTL_BEGIN_NAMESPACE_MYSTL
 
@@ -19,6 +20,9 @@ class alloc {
 public:
     [[nodiscard]] static void* allocate(size_t size) { return ::operator new(size); }
 
+    // 失败时返回空指针
+    [[nodiscard]] static void* try_allocate(size_t size) noexcept { return ::operator new(size, std::nothrow); }
+
     static void deallocate(void* ptr, size_t bytes) noexcept { return ::operator delete(ptr); }
 };
 
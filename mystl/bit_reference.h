@@ -0,0 +1,234 @@
+//===-------------------------------------===//
+//
+// bit_reference.h
+// 按位存储的容器使用的代理引用与迭代器
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_BIT_REFERENCE_H
+#define _MYSTL_BIT_REFERENCE_H
+
+#include <climits>
+#include <config.h>
+#include <iterator.h>
+#include <memory>
+#include <type_traits>
+#if _MYSTL_CXX_VERSION >= 20
+#    include <bit>
+#endif
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+template <class _StoragePointer, bool _IsConst>
+class __bit_iterator;
+
+// 统计一个字中 1 的个数
+template <class _Word>
+inline _MYSTL_CONSTEXPR_SINCE_CXX14 unsigned __popcount(_Word __w) noexcept {
+    static_assert(std::is_unsigned_v<_Word>, "__popcount requires an unsigned word type");
+#if _MYSTL_CXX_VERSION >= 20
+    return static_cast<unsigned>(std::popcount(__w));
+#else
+    return static_cast<unsigned>(__builtin_popcountll(static_cast<unsigned long long>(__w)));
+#endif
+}
+
+// 一个字中最低位的 1 的位置
+// Precondition: __w != 0
+template <class _Word>
+inline _MYSTL_CONSTEXPR_SINCE_CXX14 unsigned __countr_zero(_Word __w) noexcept {
+    static_assert(std::is_unsigned_v<_Word>, "__countr_zero requires an unsigned word type");
+#if _MYSTL_CXX_VERSION >= 20
+    return static_cast<unsigned>(std::countr_zero(__w));
+#else
+    return static_cast<unsigned>(__builtin_ctzll(static_cast<unsigned long long>(__w)));
+#endif
+}
+
+// 指向某个字中的某一位的代理引用
+template <class _StoragePointer>
+class __bit_reference {
+public:
+    using __storage_type = typename std::pointer_traits<_StoragePointer>::element_type;
+
+private:
+    _StoragePointer __seg_;
+    __storage_type __mask_;
+
+    template <class, bool>
+    friend class __bit_iterator;
+    template <class, class>
+    friend class vector;
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_reference(_StoragePointer __s, __storage_type __m) noexcept : __seg_(__s), __mask_(__m) {}
+
+public:
+    __bit_reference() = delete;
+
+    __bit_reference(const __bit_reference&) = default;
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 operator bool() const noexcept { return static_cast<bool>(*__seg_ & __mask_); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator~() const noexcept { return !static_cast<bool>(*this); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_reference& operator=(bool __x) noexcept {
+        if (__x) {
+            *__seg_ |= __mask_;
+        } else {
+            *__seg_ &= ~__mask_;
+        }
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_reference& operator=(const __bit_reference& __x) noexcept { return operator=(static_cast<bool>(__x)); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void flip() noexcept { *__seg_ ^= __mask_; }
+};
+
+// 代理引用是纯右值，swap 需要按值接收
+template <class _StoragePointer>
+inline _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(__bit_reference<_StoragePointer> __x, __bit_reference<_StoragePointer> __y) noexcept {
+    bool __t = __x;
+    __x      = __y;
+    __y      = __t;
+}
+
+template <class _StoragePointer>
+inline _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(__bit_reference<_StoragePointer> __x, bool& __y) noexcept {
+    bool __t = __x;
+    __x      = __y;
+    __y      = __t;
+}
+
+template <class _StoragePointer>
+inline _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(bool& __x, __bit_reference<_StoragePointer> __y) noexcept {
+    bool __t = __x;
+    __x      = __y;
+    __y      = __t;
+}
+
+// 按位的随机访问迭代器
+// __seg_ 指向当前的字，__ctz_ 为字内的位偏移
+template <class _StoragePointer, bool _IsConst>
+class __bit_iterator {
+public:
+    using __storage_type    = std::remove_const_t<typename std::pointer_traits<_StoragePointer>::element_type>;
+    using difference_type   = typename std::pointer_traits<_StoragePointer>::difference_type;
+    using value_type        = bool;
+    using pointer           = void;
+    using reference         = std::conditional_t<_IsConst, bool, __bit_reference<_StoragePointer>>;
+    using iterator_category = random_access_iterator_tag;
+
+    static constexpr unsigned __bits_per_word = sizeof(__storage_type) * CHAR_BIT;
+
+private:
+    _StoragePointer __seg_;
+    unsigned __ctz_;
+
+    template <class, bool>
+    friend class __bit_iterator;
+    template <class, class>
+    friend class vector;
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator(_StoragePointer __s, unsigned __ctz) noexcept : __seg_(__s), __ctz_(__ctz) {}
+
+public:
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator() noexcept : __seg_(), __ctz_(0) {}
+
+    // 从非 const 迭代器构造 const 迭代器
+    template <class _OtherPointer, bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator(const __bit_iterator<_OtherPointer, _OtherConst>& __it) noexcept
+        : __seg_(__it.__seg_), __ctz_(__it.__ctz_) {}
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference operator*() const noexcept {
+        if constexpr (_IsConst) {
+            return static_cast<bool>(*__seg_ & (__storage_type(1) << __ctz_));
+        } else {
+            return reference(__seg_, __storage_type(1) << __ctz_);
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator& operator++() noexcept {
+        if (__ctz_ != __bits_per_word - 1) {
+            ++__ctz_;
+        } else {
+            __ctz_ = 0;
+            ++__seg_;
+        }
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator operator++(int) noexcept {
+        __bit_iterator __tmp(*this);
+        ++(*this);
+        return __tmp;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator& operator--() noexcept {
+        if (__ctz_ != 0) {
+            --__ctz_;
+        } else {
+            __ctz_ = __bits_per_word - 1;
+            --__seg_;
+        }
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator operator--(int) noexcept {
+        __bit_iterator __tmp(*this);
+        --(*this);
+        return __tmp;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator& operator+=(difference_type __n) noexcept {
+        difference_type __bit = static_cast<difference_type>(__ctz_) + __n;
+        if (__bit >= 0) {
+            __seg_ += __bit / __bits_per_word;
+        } else {
+            __seg_ -= (static_cast<difference_type>(__bits_per_word) - 1 - __bit) / __bits_per_word;
+        }
+        __ctz_ = static_cast<unsigned>(__bit & (__bits_per_word - 1));
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator& operator-=(difference_type __n) noexcept { return *this += -__n; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator operator+(difference_type __n) const noexcept {
+        __bit_iterator __tmp(*this);
+        __tmp += __n;
+        return __tmp;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator operator-(difference_type __n) const noexcept {
+        __bit_iterator __tmp(*this);
+        __tmp -= __n;
+        return __tmp;
+    }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 __bit_iterator operator+(difference_type __n, const __bit_iterator& __it) noexcept { return __it + __n; }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 difference_type operator-(const __bit_iterator& __x, const __bit_iterator& __y) noexcept {
+        return (__x.__seg_ - __y.__seg_) * static_cast<difference_type>(__bits_per_word) + static_cast<difference_type>(__x.__ctz_) -
+               static_cast<difference_type>(__y.__ctz_);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference operator[](difference_type __n) const noexcept { return *(*this + __n); }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator==(const __bit_iterator& __x, const __bit_iterator& __y) noexcept {
+        return __x.__seg_ == __y.__seg_ && __x.__ctz_ == __y.__ctz_;
+    }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator!=(const __bit_iterator& __x, const __bit_iterator& __y) noexcept { return !(__x == __y); }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator<(const __bit_iterator& __x, const __bit_iterator& __y) noexcept { return __y - __x > 0; }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator>(const __bit_iterator& __x, const __bit_iterator& __y) noexcept { return __y < __x; }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator<=(const __bit_iterator& __x, const __bit_iterator& __y) noexcept { return !(__y < __x); }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator>=(const __bit_iterator& __x, const __bit_iterator& __y) noexcept { return !(__x < __y); }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_BIT_REFERENCE_H
@@ -0,0 +1,393 @@
+//===-------------------------------------===//
+//
+// concurrent_vector.h
+// 只追加的并发 vector，多个线程可以同时 push_back，同时读取已发布的元素
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_CONCURRENT_VECTOR_H
+#define _MYSTL_CONCURRENT_VECTOR_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <atomic>
+#include <climits>
+#include <config.h>
+#include <cstring>
+#include <hardening.h>
+#include <iterator.h>
+#include <memory>
+#include <new>
+#include <segmented_vector.h>
+#include <throw.h>
+#include <type_traits>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 块的划分与 segmented_vector 相同，第 k 个块的大小为 __first_block << k，块一旦分配就不再移动
+// push_back 通过对 __size_ 的一次 fetch_add 获得下标，不重试也不等待其他线程，因此是无等待的
+// 获得第 k 个块第一个下标的线程在发布自己的元素后预先分配第 k + 1 个块，填满第 k 个块之前后续的块通常已经就绪；
+// 块仍未分配时，到达的线程各自分配并通过一次 compare_exchange 决定使用谁的块，失败者释放自己的块
+// 每个块的头部有与元素一一对应的发布标志，元素构造完成后以 release 写入标志，
+// 读者以 acquire 读取标志 (is_published)，只有已发布的元素可以被并发读取
+// 构造抛出异常的位置永远不会被发布，析构时跳过
+// 容器本身的析构、clear 与 swap 不能与其他操作并发
+template <typename _Tp, class _Allocator = mystl::allocator<_Tp>>
+class concurrent_vector {
+    template <bool _IsConst>
+    class __iterator;
+
+public:
+    using value_type      = _Tp;
+    using allocator_type  = _Allocator;
+    using alloc_traits    = std::allocator_traits<allocator_type>;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = typename alloc_traits::size_type;
+    using difference_type = typename alloc_traits::difference_type;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = __iterator<false>;
+    using const_iterator  = __iterator<true>;
+
+    static_assert(std::is_same_v<typename allocator_type::value_type, value_type>, "Allocator::value_type must be same type as value_type");
+    static_assert(alignof(value_type) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "concurrent_vector does not support over-aligned types");
+
+private:
+    using __byte_allocator = typename alloc_traits::template rebind_alloc<unsigned char>;
+    using __byte_traits    = std::allocator_traits<__byte_allocator>;
+
+    static constexpr unsigned __first_shift  = sizeof(value_type) >= 256 ? 0 : mystl::__log2(256 / sizeof(value_type));
+    static constexpr size_type __first_block = size_type(1) << __first_shift;
+    static constexpr unsigned __max_blocks   = sizeof(size_type) * CHAR_BIT - __first_shift;
+
+    // 每个块为一次分配：前部为 __block_size(k) 个发布标志 (按 alignof(value_type) 对齐)，后部为元素
+    std::atomic<unsigned char*> __blocks_[__max_blocks] = {};
+    std::atomic<size_type> __size_{0};
+    __byte_allocator __alloc_;
+
+public:
+    //
+    // construct/destroy
+    //
+    concurrent_vector() noexcept(std::is_nothrow_default_constructible<__byte_allocator>::value) {}
+
+    explicit concurrent_vector(const allocator_type& __a) noexcept : __alloc_(__a) {}
+
+    concurrent_vector(const concurrent_vector&)            = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+
+    ~concurrent_vector() { __release(); }
+
+    allocator_type get_allocator() const noexcept { return allocator_type(__alloc_); }
+
+    //
+    // 并发追加
+    //
+    // 返回指向新元素的迭代器，新元素在返回前已经发布
+    template <class... _Args>
+    iterator emplace_back(_Args&&... __args) {
+        size_type __i = __reserve_indices(1);
+        __construct_and_publish(__i, std::forward<_Args>(__args)...);
+        __preallocate_next(__i, 1);
+        return iterator(this, __i);
+    }
+
+    iterator push_back(const value_type& __x) { return emplace_back(__x); }
+
+    iterator push_back(value_type&& __x) { return emplace_back(std::move(__x)); }
+
+    // 一次预留连续的 __n 个位置并逐个构造，返回指向第一个新元素的迭代器
+    // 其他线程的追加不会插入到这 __n 个元素之间
+    iterator grow_by(size_type __n) { return __grow_by(__n); }
+
+    iterator grow_by(size_type __n, const value_type& __x) { return __grow_by(__n, __x); }
+
+    // 预先分配块使容量不小于 __n，可以与追加并发
+    void reserve(size_type __n) {
+        if (__n > max_size()) { mystl::__throw_length_error("concurrent_vector"); }
+        for (unsigned __k = 0; __capacity_of(__k) < __n; ++__k) { __get_block(__k); }
+    }
+
+    //
+    // 并发读取
+    //
+    // 已经预留的位置数，其中可能有尚未完成构造的元素
+    size_type size() const noexcept { return __size_.load(std::memory_order_acquire); }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    size_type max_size() const noexcept { return __capacity_of(__max_blocks - 1); }
+
+    // 下标为 __i 的元素是否已经构造完成，返回 true 时读取该元素是安全的
+    bool is_published(size_type __i) const noexcept {
+        if (__i >= size()) return false;
+        const unsigned char* __b = __blocks_[__block_of(__i)].load(std::memory_order_acquire);
+        return __b != nullptr && __load_flag(__b, __offset_of(__i));
+    }
+
+    // Precondition: is_published(__n)
+    reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(is_published(__n), "concurrent_vector::operator[]: element not published");
+        return *__locate(__n);
+    }
+
+    const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(is_published(__n), "concurrent_vector::operator[]: element not published");
+        return *__locate(__n);
+    }
+
+    reference at(size_type __n) {
+        if (!is_published(__n)) { mystl::__throw_out_of_range("concurrent_vector"); }
+        return *__locate(__n);
+    }
+
+    const_reference at(size_type __n) const {
+        if (!is_published(__n)) { mystl::__throw_out_of_range("concurrent_vector"); }
+        return *__locate(__n);
+    }
+
+    // 按下标顺序对调用时已发布的元素调用 __f，跳过尚未发布的位置
+    template <class _Fn>
+    void for_each_published(_Fn __f) const {
+        size_type __n = size();
+        for (unsigned __k = 0; __n > 0 && __k < __max_blocks; ++__k) {
+            size_type __cnt          = std::min(__n, __block_size(__k));
+            const unsigned char* __b = __blocks_[__k].load(std::memory_order_acquire);
+            if (__b != nullptr) {
+                const_pointer __data = __data_of(__b, __k);
+                for (size_type __j = 0; __j < __cnt; ++__j) {
+                    if (__load_flag(__b, __j)) { __f(__data[__j]); }
+                }
+            }
+            __n -= __cnt;
+        }
+    }
+
+    // 迭代器遍历 [0, size())，解引用前需要确认元素已发布，单线程或追加结束后使用
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, size()); }
+
+    const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+    //
+    // 非并发操作
+    //
+    // 析构所有元素，保留已分配的块
+    void clear() noexcept {
+        size_type __n = size();
+        for (size_type __i = 0; __i < __n; ++__i) {
+            unsigned char* __b = __blocks_[__block_of(__i)].load(std::memory_order_relaxed);
+            if (__b != nullptr && __load_flag(__b, __offset_of(__i))) {
+                std::destroy_at(__locate(__i));
+                std::atomic_ref<unsigned char>(__b[__offset_of(__i)]).store(0, std::memory_order_relaxed);
+            }
+        }
+        __size_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_type __block_size(unsigned __k) noexcept { return __first_block << __k; }
+
+    static constexpr size_type __capacity_of(unsigned __nblocks) noexcept { return __first_block * ((size_type(1) << __nblocks) - 1); }
+
+    static unsigned __block_of(size_type __i) noexcept { return mystl::__log2(__i + __first_block) - __first_shift; }
+
+    static size_type __offset_of(size_type __i) noexcept {
+        size_type __j = __i + __first_block;
+        return __j - (size_type(1) << mystl::__log2(__j));
+    }
+
+    // 标志区按 alignof(value_type) 取整后的字节数
+    static constexpr size_type __flag_bytes(unsigned __k) noexcept {
+        return (__block_size(__k) + alignof(value_type) - 1) / alignof(value_type) * alignof(value_type);
+    }
+
+    static constexpr size_type __alloc_bytes(unsigned __k) noexcept { return __flag_bytes(__k) + __block_size(__k) * sizeof(value_type); }
+
+    static pointer __data_of(unsigned char* __b, unsigned __k) noexcept { return reinterpret_cast<pointer>(__b + __flag_bytes(__k)); }
+
+    static const_pointer __data_of(const unsigned char* __b, unsigned __k) noexcept {
+        return reinterpret_cast<const_pointer>(__b + __flag_bytes(__k));
+    }
+
+    static bool __load_flag(const unsigned char* __b, size_type __j) noexcept {
+        return std::atomic_ref<unsigned char>(const_cast<unsigned char&>(__b[__j])).load(std::memory_order_acquire) != 0;
+    }
+
+    // Precondition: 下标 __i 所在的块已经分配
+    pointer __locate(size_type __i) const noexcept {
+        unsigned __k = __block_of(__i);
+        return __data_of(__blocks_[__k].load(std::memory_order_acquire), __k) + __offset_of(__i);
+    }
+
+    // 预留连续的 __n 个下标并返回第一个
+    // 单次请求超出剩余的容量时不修改 __size_ 直接抛出 length_error；只有与其他超出 max_size() 的 grow_by 并发时，
+    // fetch_add 之后才可能越界，此时撤销自己的增量并抛出 length_error，size() 在撤销之前短暂偏大
+    size_type __reserve_indices(size_type __n) {
+        if (__n > max_size() - std::min(max_size(), size())) { mystl::__throw_length_error("concurrent_vector"); }
+        size_type __first = __size_.fetch_add(__n, std::memory_order_relaxed);
+        if (__first > max_size() - __n) {
+            __size_.fetch_sub(__n, std::memory_order_relaxed);
+            mystl::__throw_length_error("concurrent_vector");
+        }
+        return __first;
+    }
+
+    // 返回第 __k 个块，未分配时分配，多个线程同时分配时只保留一个
+    unsigned char* __get_block(unsigned __k) {
+        unsigned char* __b = __blocks_[__k].load(std::memory_order_acquire);
+        if (__b != nullptr) return __b;
+
+        unsigned char* __new_block = __byte_traits::allocate(__alloc_, __alloc_bytes(__k));
+        std::memset(__new_block, 0, __block_size(__k));
+        if (__blocks_[__k].compare_exchange_strong(__b, __new_block, std::memory_order_acq_rel, std::memory_order_acquire)) {
+            return __new_block;
+        }
+        __byte_traits::deallocate(__alloc_, __new_block, __alloc_bytes(__k));
+        return __b;
+    }
+
+    // [__first, __first + __n) 包含某个块的第一个下标时预先分配其后的块
+    // 调用者的元素已经发布，分配失败不影响本次追加，之后由需要该块的线程重新分配
+    void __preallocate_next(size_type __first, size_type __n) noexcept {
+        unsigned __k = __block_of(__first);
+        if (__offset_of(__first) != 0) { ++__k; }
+        unsigned __last = __block_of(__first + __n - 1) + 1;
+        for (; __k < __last && __k + 1 < __max_blocks; ++__k) {
+            if (__blocks_[__k + 1].load(std::memory_order_relaxed) != nullptr) { continue; }
+#if _MYSTL_HAS_EXCEPTIONS
+            try {
+#endif
+                __get_block(__k + 1);
+#if _MYSTL_HAS_EXCEPTIONS
+            } catch (...) {}
+#endif
+        }
+    }
+
+    template <class... _Args>
+    void __construct_and_publish(size_type __i, _Args&&... __args) {
+        unsigned __k       = __block_of(__i);
+        size_type __off    = __offset_of(__i);
+        unsigned char* __b = __get_block(__k);
+        ::new (static_cast<void*>(__data_of(__b, __k) + __off)) value_type(std::forward<_Args>(__args)...);
+        std::atomic_ref<unsigned char>(__b[__off]).store(1, std::memory_order_release);
+    }
+
+    template <class... _Args>
+    iterator __grow_by(size_type __n, const _Args&... __args) {
+        size_type __first = __reserve_indices(__n);
+        for (size_type __i = __first; __i < __first + __n; ++__i) { __construct_and_publish(__i, __args...); }
+        if (__n != 0) { __preallocate_next(__first, __n); }
+        return iterator(this, __first);
+    }
+
+    void __release() noexcept {
+        clear();
+        for (unsigned __k = 0; __k < __max_blocks; ++__k) {
+            unsigned char* __b = __blocks_[__k].load(std::memory_order_relaxed);
+            if (__b != nullptr) {
+                __byte_traits::deallocate(__alloc_, __b, __alloc_bytes(__k));
+                __blocks_[__k].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    template <bool _IsConst>
+    class __iterator {
+        using __container = std::conditional_t<_IsConst, const concurrent_vector, concurrent_vector>;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = _Tp;
+        using difference_type   = typename concurrent_vector::difference_type;
+        using pointer           = std::conditional_t<_IsConst, const value_type*, value_type*>;
+        using reference         = std::conditional_t<_IsConst, const value_type&, value_type&>;
+
+        __iterator() noexcept : __v_(nullptr), __i_(0) {}
+
+        template <bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+        __iterator(const __iterator<_OtherConst>& __it) noexcept : __v_(__it.__v_), __i_(__it.__i_) {}
+
+        reference operator*() const noexcept { return (*__v_)[__i_]; }
+
+        pointer operator->() const noexcept { return std::addressof((*__v_)[__i_]); }
+
+        reference operator[](difference_type __n) const noexcept { return (*__v_)[__i_ + __n]; }
+
+        // 元素在容器中的下标
+        size_type index() const noexcept { return __i_; }
+
+        __iterator& operator++() noexcept {
+            ++__i_;
+            return *this;
+        }
+
+        __iterator operator++(int) noexcept {
+            __iterator __tmp(*this);
+            ++__i_;
+            return __tmp;
+        }
+
+        __iterator& operator--() noexcept {
+            --__i_;
+            return *this;
+        }
+
+        __iterator operator--(int) noexcept {
+            __iterator __tmp(*this);
+            --__i_;
+            return __tmp;
+        }
+
+        __iterator& operator+=(difference_type __n) noexcept {
+            __i_ += __n;
+            return *this;
+        }
+
+        __iterator& operator-=(difference_type __n) noexcept {
+            __i_ -= __n;
+            return *this;
+        }
+
+        friend __iterator operator+(__iterator __it, difference_type __n) noexcept { return __it += __n; }
+
+        friend __iterator operator+(difference_type __n, __iterator __it) noexcept { return __it += __n; }
+
+        friend __iterator operator-(__iterator __it, difference_type __n) noexcept { return __it -= __n; }
+
+        friend difference_type operator-(const __iterator& __x, const __iterator& __y) noexcept {
+            return static_cast<difference_type>(__x.__i_) - static_cast<difference_type>(__y.__i_);
+        }
+
+        friend bool operator==(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ == __y.__i_; }
+
+        friend bool operator!=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ != __y.__i_; }
+
+        friend bool operator<(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ < __y.__i_; }
+
+        friend bool operator>(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ > __y.__i_; }
+
+        friend bool operator<=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ <= __y.__i_; }
+
+        friend bool operator>=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ >= __y.__i_; }
+
+    private:
+        template <bool>
+        friend class __iterator;
+        friend class concurrent_vector;
+
+        __container* __v_;
+        size_type __i_;
+
+        __iterator(__container* __v, size_type __i) noexcept : __v_(__v), __i_(__i) {}
+    };
+};
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_CONCURRENT_VECTOR_H
@@ -54,7 +54,32 @@
 #    define _MYSTL_HAS_EXCEPTIONS 0
 #endif // __cpp_exceptions
 
-#if defined(__clang__) && __clang_major__ >= 8
+// vector 扩容统计，定义为 1 时开启，见 vector_telemetry.h
+#ifndef _MYSTL_VECTOR_TELEMETRY
+#    define _MYSTL_VECTOR_TELEMETRY 0
+#endif
+
+// vector 自动收缩，定义为 1 时开启，见 vector_shrink.h
+#ifndef _MYSTL_VECTOR_SHRINK_POLICY
+#    define _MYSTL_VECTOR_SHRINK_POLICY 0
+#endif
+
+// 运行期检查的强度，见 hardening.h
+// none: 不检查；fast: 只检查开销很小且违反后会破坏内存的前置条件；debug: 检查全部前置条件
+// 未指定时与 assert 一致，定义了 NDEBUG 为 none，否则为 debug
+#define _MYSTL_HARDENING_MODE_NONE  0
+#define _MYSTL_HARDENING_MODE_FAST  1
+#define _MYSTL_HARDENING_MODE_DEBUG 2
+
+#ifndef _MYSTL_HARDENING_MODE
+#    ifdef NDEBUG
+#        define _MYSTL_HARDENING_MODE _MYSTL_HARDENING_MODE_NONE
+#    else
+#        define _MYSTL_HARDENING_MODE _MYSTL_HARDENING_MODE_DEBUG
+#    endif
+#endif
+
+#if (defined(__clang__) && __clang_major__ >= 8) || (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 9)
 #    define IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
 #else
 #    define IS_CONSTANT_EVALUATED() false
@@ -48,7 +48,7 @@ template <class _Rollback>
 struct __exception_guard_noexceptions {
     __exception_guard_noexceptions() = delete;
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 explicit __exception_guard_noexceptions(_Rollback __rollback) : __completed_(false) {}
+    _MYSTL_CONSTEXPR_SINCE_CXX20 explicit __exception_guard_noexceptions(_Rollback) : __completed_(false) {}
 
     _MYSTL_CONSTEXPR_SINCE_CXX20
     __exception_guard_noexceptions(__exception_guard_noexceptions&& other) noexcept(std::is_nothrow_move_constructible_v<_Rollback>)
@@ -0,0 +1,233 @@
+//===-------------------------------------===//
+//
+// eytzinger_index.h
+// 以 Eytzinger (BFS) 顺序存放有序键的只读索引，查找时预取后续几层的节点
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_EYTZINGER_INDEX_H
+#define _MYSTL_EYTZINGER_INDEX_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <config.h>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <sorted_search.h>
+#include <type_traits>
+#include <vector.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+template <class _Compare, class = void>
+struct __is_transparent : std::false_type {};
+
+template <class _Compare>
+struct __is_transparent<_Compare, std::void_t<typename _Compare::is_transparent>> : std::true_type {};
+
+// 由有序区间构建的静态索引，用于周期性重建的只读查找表
+// 键按完全二叉树的层序存放，节点 k (从 1 开始) 的子节点为 2k 与 2k + 1，查找路径上前几层的节点集中在少数缓存行中，
+// 而有序数组上的二分查找前几步就跨越了整个数组，键的数量超出缓存后每一步都是一次缓存缺失
+// 节点 k 往下 log2(__block) 层的后代在存储中连续，下降时提前预取它们，使访存与比较重叠
+// 查找的结果是键在原有序区间中的下标 (rank)，可以用于访问与原区间平行存放的值
+// 比较器提供 is_transparent 时，lower_bound/contains 接受可以与 key_type 比较的任意类型
+template <class _Key, class _Compare = std::less<_Key>, class _Allocator = mystl::allocator<_Key>>
+class eytzinger_index {
+public:
+    using key_type       = _Key;
+    using key_compare    = _Compare;
+    using allocator_type = _Allocator;
+    using size_type      = size_t;
+
+private:
+    using __rank_allocator = typename std::allocator_traits<allocator_type>::template rebind_alloc<size_type>;
+
+    // 一个缓存行中的键数，节点 k 往下若干层的后代 [k * __block, k * __block + __block) 占据一个缓存行
+    static constexpr size_type __block = sizeof(key_type) >= 64 ? 1 : 64 / sizeof(key_type);
+
+    // 同时进行的查找数，见 lower_bound_batch
+    static constexpr size_type __batch = 16;
+
+    mystl::vector<key_type, allocator_type> __tree_;    // __tree_[k - 1] 为节点 k
+    mystl::vector<size_type, __rank_allocator> __rank_; // __rank_[k - 1] 为节点 k 在原区间中的下标
+    size_type __levels_ = 0;                            // 树的层数，即 bit_width(size())
+    key_compare __comp_;
+
+public:
+    //
+    // construct
+    //
+    eytzinger_index() = default;
+
+    explicit eytzinger_index(const key_compare& __comp) : __comp_(__comp) {}
+
+    // Precondition: [__first, __last) 已经按 __comp 排序，可以有重复的键
+    template <class _RandomAccessIterator>
+    eytzinger_index(_RandomAccessIterator __first, _RandomAccessIterator __last, const key_compare& __comp = key_compare()) : __comp_(__comp) {
+        assign(__first, __last);
+    }
+
+    // Precondition: __sorted 已经按 __comp 排序
+    template <class _Alloc>
+    explicit eytzinger_index(const mystl::vector<key_type, _Alloc>& __sorted, const key_compare& __comp = key_compare())
+        : eytzinger_index(__sorted.begin(), __sorted.end(), __comp) {}
+
+    // 用新的有序区间重建索引，容量足够时复用已有的存储
+    // Precondition: [__first, __last) 已经按 key_comp() 排序
+    template <class _RandomAccessIterator>
+    void assign(_RandomAccessIterator __first, _RandomAccessIterator __last) {
+        static_assert(std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<_RandomAccessIterator>::iterator_category>,
+                      "eytzinger_index requires random access iterators");
+        size_type __n = static_cast<size_type>(__last - __first);
+        __tree_.clear();
+        __rank_.resize(__n);
+        __levels_ = 0;
+        while ((size_type(1) << __levels_) <= __n) { ++__levels_; }
+        // 中序遍历得到每个节点对应的下标，再按层序拷贝键
+        __fill_rank(0, 1);
+        __tree_.reserve(__n);
+        for (size_type __k = 0; __k < __n; ++__k) { __tree_.emplace_back_unchecked(__first[__rank_[__k]]); }
+    }
+
+    template <class _Alloc>
+    void assign(const mystl::vector<key_type, _Alloc>& __sorted) {
+        assign(__sorted.begin(), __sorted.end());
+    }
+
+    //
+    // 容量
+    //
+    [[nodiscard]] bool empty() const noexcept { return __tree_.empty(); }
+
+    size_type size() const noexcept { return __tree_.size(); }
+
+    void clear() noexcept {
+        __tree_.clear();
+        __rank_.clear();
+        __levels_ = 0;
+    }
+
+    void swap(eytzinger_index& __other) noexcept {
+        using std::swap;
+        __tree_.swap(__other.__tree_);
+        __rank_.swap(__other.__rank_);
+        swap(__levels_, __other.__levels_);
+        swap(__comp_, __other.__comp_);
+    }
+
+    friend void swap(eytzinger_index& __x, eytzinger_index& __y) noexcept { __x.swap(__y); }
+
+    //
+    // 查找
+    //
+    key_compare key_comp() const { return __comp_; }
+
+    // 原区间中第一个不小于 __k 的键的下标，不存在时返回 size()
+    size_type lower_bound(const key_type& __k) const { return __lower_bound(__k); }
+
+    template <class _Kp, class _Cp = key_compare, std::enable_if_t<__is_transparent<_Cp>::value, int> = 0>
+    size_type lower_bound(const _Kp& __k) const {
+        return __lower_bound(__k);
+    }
+
+    bool contains(const key_type& __k) const { return __contains(__k); }
+
+    template <class _Kp, class _Cp = key_compare, std::enable_if_t<__is_transparent<_Cp>::value, int> = 0>
+    bool contains(const _Kp& __k) const {
+        return __contains(__k);
+    }
+
+    // 批量查找，对 [__first, __last) 中的每个键依次向 __out 写入 lower_bound 的结果，返回写入结束的位置
+    // 每次同时下降 __batch 个互不相关的查找，各自的缓存缺失可以同时进行，键的数量远超缓存时明显快于逐个查找
+    template <class _RandomAccessIterator, class _OutputIterator>
+    _OutputIterator lower_bound_batch(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __out) const {
+        return __batch_search(__first, __last, __out, [this](size_type __node, const auto&) { return __node_rank(__node); });
+    }
+
+    // 批量判断 [__first, __last) 中的每个键是否存在，结果依次写入 __out
+    template <class _RandomAccessIterator, class _OutputIterator>
+    _OutputIterator contains_batch(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __out) const {
+        return __batch_search(__first, __last, __out, [this](size_type __node, const auto& __k) { return __node_contains(__node, __k); });
+    }
+
+private:
+    // 按中序遍历以 __k 为根的子树，第 __i 个访问到的节点对应原区间中下标为 __i 的键
+    // 递归深度为树的层数
+    size_type __fill_rank(size_type __i, size_type __k) {
+        if (__k <= __rank_.size()) {
+            __i              = __fill_rank(__i, 2 * __k);
+            __rank_[__k - 1] = __i++;
+            __i              = __fill_rank(__i, 2 * __k + 1);
+        }
+        return __i;
+    }
+
+    // 预取节点 __k 往下 log2(__block) 层的后代，存储未按缓存行对齐时它们可能跨越两个缓存行，因此预取首尾两个键
+    void __prefetch_descendants(size_type __k) const noexcept {
+        const key_type* __t = __tree_.data();
+        mystl::__prefetch_read(__t, (__k * __block - 1) * sizeof(key_type));
+        mystl::__prefetch_read(__t, (__k * __block + __block - 2) * sizeof(key_type));
+    }
+
+    // 从节点 __k 下降一层，比较结果直接作为下标的最低位，不产生分支
+    // Precondition: __k <= size()
+    template <class _Kp>
+    size_type __descend(size_type __k, const _Kp& __x) const {
+        __prefetch_descendants(__k);
+        return 2 * __k + (__comp_(__tree_[__k - 1], __x) ? 1 : 0);
+    }
+
+    // 下降结束后，下标的二进制表示中末尾的 1 对应最后几次向右的移动，去掉它们以及最后一次向左的移动得到答案节点
+    // 从未向左移动时返回 0，表示所有的键都小于查找的键
+    static size_type __answer(size_type __k) noexcept { return __k >> (__builtin_ctzll(~static_cast<unsigned long long>(__k)) + 1); }
+
+    size_type __node_rank(size_type __node) const noexcept { return __node == 0 ? size() : __rank_[__node - 1]; }
+
+    template <class _Kp>
+    bool __node_contains(size_type __node, const _Kp& __x) const {
+        return __node != 0 && !__comp_(__x, __tree_[__node - 1]);
+    }
+
+    template <class _Kp>
+    size_type __find_node(const _Kp& __x) const {
+        size_type __k = 1;
+        while (__k <= size()) { __k = __descend(__k, __x); }
+        return __answer(__k);
+    }
+
+    template <class _Kp>
+    size_type __lower_bound(const _Kp& __x) const {
+        return __node_rank(__find_node(__x));
+    }
+
+    template <class _Kp>
+    bool __contains(const _Kp& __x) const {
+        return __node_contains(__find_node(__x), __x);
+    }
+
+    // 每 __batch 个键一组，逐层推进组内所有查找
+    // 前 __levels_ - 1 层是满的，所有查找都执行，只有最后一层需要检查节点是否存在
+    template <class _RandomAccessIterator, class _OutputIterator, class _Result>
+    _OutputIterator __batch_search(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __out, _Result __result) const {
+        size_type __m = static_cast<size_type>(__last - __first);
+        size_type __k[__batch];
+        for (size_type __i = 0; __i < __m; __i += __batch) {
+            size_type __g = std::min(__batch, __m - __i);
+            for (size_type __j = 0; __j < __g; ++__j) { __k[__j] = 1; }
+            for (size_type __d = 1; __d < __levels_; ++__d) {
+                for (size_type __j = 0; __j < __g; ++__j) { __k[__j] = __descend(__k[__j], __first[__i + __j]); }
+            }
+            for (size_type __j = 0; __j < __g; ++__j) {
+                if (__k[__j] <= size()) { __k[__j] = __descend(__k[__j], __first[__i + __j]); }
+                *__out = __result(__answer(__k[__j]), __first[__i + __j]);
+                ++__out;
+            }
+        }
+        return __out;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_EYTZINGER_INDEX_H
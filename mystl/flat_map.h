@@ -0,0 +1,492 @@
+//===-------------------------------------===//
+//
+// flat_map.h
+// 以两个有序 vector 分别存储键与值的映射，查找使用无分支二分查找
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_FLAT_MAP_H
+#define _MYSTL_FLAT_MAP_H
+
+#include <algorithm>
+#include <config.h>
+#include <exception_guard.h>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <sorted_search.h>
+#include <throw.h>
+#include <type_traits>
+#include <utility>
+#include <vector.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 键与值分别存放在 _KeyContainer 与 _MappedContainer 中，两者下标一一对应
+// 查找只访问键的数组，值不会占用查找路径上的缓存行
+// 元素的引用是代理类型 std::pair<const key_type&, mapped_type&>，迭代器的 operator-> 返回持有该代理的对象
+// 插入与删除需要移动插入点之后的元素，批量插入应使用 insert(first, last) 或 insert(sorted_unique, first, last)
+template <class _Key, class _Tp, class _Compare = std::less<_Key>, class _KeyContainer = mystl::vector<_Key>,
+          class _MappedContainer = mystl::vector<_Tp>>
+class flat_map {
+    template <bool _IsConst>
+    class __iterator;
+
+public:
+    using key_type              = _Key;
+    using mapped_type           = _Tp;
+    using value_type            = std::pair<key_type, mapped_type>;
+    using key_compare           = _Compare;
+    using reference             = std::pair<const key_type&, mapped_type&>;
+    using const_reference       = std::pair<const key_type&, const mapped_type&>;
+    using size_type             = size_t;
+    using difference_type       = ptrdiff_t;
+    using iterator              = __iterator<false>;
+    using const_iterator        = __iterator<true>;
+    using key_container_type    = _KeyContainer;
+    using mapped_container_type = _MappedContainer;
+
+    static_assert(std::is_same_v<key_type, typename key_container_type::value_type>, "key_container_type::value_type must be same type as key_type");
+    static_assert(std::is_same_v<mapped_type, typename mapped_container_type::value_type>,
+                  "mapped_container_type::value_type must be same type as mapped_type");
+
+    // 底层容器，extract 返回，replace 接收
+    struct containers {
+        key_container_type keys;
+        mapped_container_type values;
+    };
+
+    class value_compare {
+    public:
+        bool operator()(const_reference __x, const_reference __y) const { return __comp_(__x.first, __y.first); }
+
+    private:
+        friend class flat_map;
+
+        key_compare __comp_;
+
+        value_compare(key_compare __c) : __comp_(__c) {}
+    };
+
+private:
+    containers __c_;
+    key_compare __comp_;
+
+public:
+    //
+    // construct
+    //
+    flat_map() = default;
+
+    explicit flat_map(const key_compare& __comp) : __c_(), __comp_(__comp) {}
+
+    // 按键排序并去重，重复的键保留最先出现的元素
+    // Precondition: __keys.size() == __values.size()
+    flat_map(key_container_type __keys, mapped_container_type __values, const key_compare& __comp = key_compare())
+        : __c_{std::move(__keys), std::move(__values)}, __comp_(__comp) {
+        __sort_and_unique();
+    }
+
+    // Precondition: __keys 已经按 __comp 排序且没有重复的键，__keys.size() == __values.size()
+    flat_map(sorted_unique_t, key_container_type __keys, mapped_container_type __values, const key_compare& __comp = key_compare())
+        : __c_{std::move(__keys), std::move(__values)}, __comp_(__comp) {}
+
+    template <class _InputIterator>
+    flat_map(_InputIterator __first, _InputIterator __last, const key_compare& __comp = key_compare()) : __c_(), __comp_(__comp) {
+        insert(__first, __last);
+    }
+
+    template <class _InputIterator>
+    flat_map(sorted_unique_t, _InputIterator __first, _InputIterator __last, const key_compare& __comp = key_compare()) : __c_(), __comp_(__comp) {
+        insert(sorted_unique, __first, __last);
+    }
+
+    flat_map(std::initializer_list<value_type> __il, const key_compare& __comp = key_compare()) : flat_map(__il.begin(), __il.end(), __comp) {}
+
+    flat_map(sorted_unique_t, std::initializer_list<value_type> __il, const key_compare& __comp = key_compare())
+        : flat_map(sorted_unique, __il.begin(), __il.end(), __comp) {}
+
+    flat_map& operator=(std::initializer_list<value_type> __il) {
+        clear();
+        insert(__il);
+        return *this;
+    }
+
+    //
+    // 迭代器
+    //
+    iterator begin() noexcept { return iterator(__c_.keys.begin(), __c_.values.begin()); }
+
+    const_iterator begin() const noexcept { return const_iterator(__c_.keys.begin(), __c_.values.begin()); }
+
+    iterator end() noexcept { return iterator(__c_.keys.end(), __c_.values.end()); }
+
+    const_iterator end() const noexcept { return const_iterator(__c_.keys.end(), __c_.values.end()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    //
+    // 容量
+    //
+    [[nodiscard]] bool empty() const noexcept { return __c_.keys.empty(); }
+
+    size_type size() const noexcept { return __c_.keys.size(); }
+
+    size_type max_size() const noexcept { return std::min<size_type>(__c_.keys.max_size(), __c_.values.max_size()); }
+
+    //
+    // 元素访问
+    //
+    mapped_type& operator[](const key_type& __k) { return try_emplace(__k).first->second; }
+
+    mapped_type& operator[](key_type&& __k) { return try_emplace(std::move(__k)).first->second; }
+
+    mapped_type& at(const key_type& __k) {
+        iterator __it = find(__k);
+        if (__it == end()) { mystl::__throw_out_of_range("flat_map::at"); }
+        return __it->second;
+    }
+
+    const mapped_type& at(const key_type& __k) const {
+        const_iterator __it = find(__k);
+        if (__it == end()) { mystl::__throw_out_of_range("flat_map::at"); }
+        return __it->second;
+    }
+
+    //
+    // 修改
+    //
+    template <class... _Args>
+    std::pair<iterator, bool> emplace(_Args&&... __args) {
+        value_type __x(std::forward<_Args>(__args)...);
+        return try_emplace(std::move(__x.first), std::move(__x.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& __x) { return try_emplace(__x.first, __x.second); }
+
+    std::pair<iterator, bool> insert(value_type&& __x) { return try_emplace(std::move(__x.first), std::move(__x.second)); }
+
+    // 键不存在时以 __args 构造值，键已存在时不做任何事
+    template <class... _Args>
+    std::pair<iterator, bool> try_emplace(const key_type& __k, _Args&&... __args) {
+        return __try_emplace(__k, std::forward<_Args>(__args)...);
+    }
+
+    template <class... _Args>
+    std::pair<iterator, bool> try_emplace(key_type&& __k, _Args&&... __args) {
+        return __try_emplace(std::move(__k), std::forward<_Args>(__args)...);
+    }
+
+    template <class _Mp>
+    std::pair<iterator, bool> insert_or_assign(const key_type& __k, _Mp&& __obj) {
+        auto __r = try_emplace(__k, std::forward<_Mp>(__obj));
+        if (!__r.second) { __r.first->second = std::forward<_Mp>(__obj); }
+        return __r;
+    }
+
+    // 新元素排序后与原有元素归并，复杂度 O(n + m log m)
+    template <class _InputIterator>
+    void insert(_InputIterator __first, _InputIterator __last) {
+        mystl::vector<value_type> __tmp(__first, __last);
+        std::stable_sort(__tmp.begin(), __tmp.end(), [this](const value_type& __x, const value_type& __y) { return __comp_(__x.first, __y.first); });
+        __merge(__tmp);
+    }
+
+    // Precondition: [__first, __last) 已经按键排序且没有重复的键
+    // 与原有元素一次归并到新的容器中，复杂度 O(n + m)
+    // 失败时 *this 不变，条件见 __merge
+    template <class _InputIterator>
+    void insert(sorted_unique_t, _InputIterator __first, _InputIterator __last) {
+        mystl::vector<value_type> __tmp(__first, __last);
+        __merge(__tmp);
+    }
+
+    void insert(std::initializer_list<value_type> __il) { insert(__il.begin(), __il.end()); }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> __il) { insert(sorted_unique, __il.begin(), __il.end()); }
+
+    // 取出底层容器，之后 *this 为空
+    containers extract() && {
+        containers __tmp = std::move(__c_);
+        clear();
+        return __tmp;
+    }
+
+    // Precondition: __keys 已经按 key_comp() 排序且没有重复的键，__keys.size() == __values.size()
+    void replace(key_container_type&& __keys, mapped_container_type&& __values) {
+        __c_.keys   = std::move(__keys);
+        __c_.values = std::move(__values);
+    }
+
+    iterator erase(iterator __pos) { return erase(const_iterator(__pos)); }
+
+    iterator erase(const_iterator __pos) { return erase(__pos, __pos + 1); }
+
+    iterator erase(const_iterator __first, const_iterator __last) {
+        auto __f = __first.__k_ - __c_.keys.cbegin(), __l = __last.__k_ - __c_.keys.cbegin();
+        __c_.keys.erase(__c_.keys.begin() + __f, __c_.keys.begin() + __l);
+        __c_.values.erase(__c_.values.begin() + __f, __c_.values.begin() + __l);
+        return begin() + __f;
+    }
+
+    size_type erase(const key_type& __k) {
+        iterator __it = find(__k);
+        if (__it == end()) return 0;
+        erase(__it);
+        return 1;
+    }
+
+    void swap(flat_map& __other) noexcept {
+        using std::swap;
+        swap(__c_.keys, __other.__c_.keys);
+        swap(__c_.values, __other.__c_.values);
+        swap(__comp_, __other.__comp_);
+    }
+
+    void clear() noexcept {
+        __c_.keys.clear();
+        __c_.values.clear();
+    }
+
+    //
+    // 查找
+    //
+    key_compare key_comp() const { return __comp_; }
+
+    value_compare value_comp() const { return value_compare(__comp_); }
+
+    const key_container_type& keys() const noexcept { return __c_.keys; }
+
+    const mapped_container_type& values() const noexcept { return __c_.values; }
+
+    iterator lower_bound(const key_type& __k) { return begin() + __lower_bound_index(__k); }
+
+    const_iterator lower_bound(const key_type& __k) const { return begin() + __lower_bound_index(__k); }
+
+    iterator upper_bound(const key_type& __k) { return begin() + __upper_bound_index(__k); }
+
+    const_iterator upper_bound(const key_type& __k) const { return begin() + __upper_bound_index(__k); }
+
+    iterator find(const key_type& __k) { return begin() + __find_index(__k); }
+
+    const_iterator find(const key_type& __k) const { return begin() + __find_index(__k); }
+
+    bool contains(const key_type& __k) const { return __find_index(__k) != size(); }
+
+    size_type count(const key_type& __k) const { return contains(__k) ? 1 : 0; }
+
+    std::pair<iterator, iterator> equal_range(const key_type& __k) {
+        size_type __i = __lower_bound_index(__k);
+        return {begin() + __i, begin() + __i + __matches(__i, __k)};
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(const key_type& __k) const {
+        size_type __i = __lower_bound_index(__k);
+        return {begin() + __i, begin() + __i + __matches(__i, __k)};
+    }
+
+    friend bool operator==(const flat_map& __x, const flat_map& __y) {
+        return std::equal(__x.__c_.keys.begin(), __x.__c_.keys.end(), __y.__c_.keys.begin(), __y.__c_.keys.end()) &&
+               std::equal(__x.__c_.values.begin(), __x.__c_.values.end(), __y.__c_.values.begin(), __y.__c_.values.end());
+    }
+
+    friend bool operator!=(const flat_map& __x, const flat_map& __y) { return !(__x == __y); }
+
+    friend void swap(flat_map& __x, flat_map& __y) noexcept { __x.swap(__y); }
+
+private:
+    size_type __lower_bound_index(const key_type& __k) const {
+        return static_cast<size_type>(mystl::__branchless_lower_bound(__c_.keys.begin(), size(), __k, __comp_) - __c_.keys.begin());
+    }
+
+    size_type __upper_bound_index(const key_type& __k) const {
+        return static_cast<size_type>(mystl::__branchless_upper_bound(__c_.keys.begin(), size(), __k, __comp_) - __c_.keys.begin());
+    }
+
+    bool __matches(size_type __i, const key_type& __k) const { return __i != size() && !__comp_(__k, __c_.keys[__i]); }
+
+    size_type __find_index(const key_type& __k) const {
+        size_type __i = __lower_bound_index(__k);
+        return __matches(__i, __k) ? __i : size();
+    }
+
+    // 键与值在同一下标插入，值插入失败时撤销键的插入
+    template <class _Kp, class... _Args>
+    std::pair<iterator, bool> __try_emplace(_Kp&& __k, _Args&&... __args) {
+        size_type __i = __lower_bound_index(__k);
+        if (__matches(__i, __k)) { return {begin() + __i, false}; }
+        __c_.keys.insert(__c_.keys.begin() + __i, std::forward<_Kp>(__k));
+        auto __guard = mystl::__make_exception_guard([&] { __c_.keys.erase(__c_.keys.begin() + __i); });
+        __c_.values.emplace(__c_.values.begin() + __i, std::forward<_Args>(__args)...);
+        __guard.__complete();
+        return {begin() + __i, true};
+    }
+
+    // 将按键有序的 __tmp 与原有元素归并到新的容器中，键重复时保留原有元素或最先出现的新元素
+    // 新元素先全部放入 __tmp，容量一次预留，归并过程中不再分配
+    // 键与值的移动构造都不抛出异常时移出原有元素，否则拷贝原有元素，比较器不抛出异常时中途失败不会修改 *this
+    // 与 move_if_noexcept 相同，不能拷贝的类型仍然移动，此时只保证基本的异常安全
+    static constexpr bool __move_on_merge =
+        (std::is_nothrow_move_constructible_v<key_type> && std::is_nothrow_move_constructible_v<mapped_type>) ||
+        !(std::is_copy_constructible_v<key_type> && std::is_copy_constructible_v<mapped_type>);
+
+    void __merge(mystl::vector<value_type>& __tmp) {
+        containers __out;
+        __out.keys.reserve(size() + __tmp.size());
+        __out.values.reserve(size() + __tmp.size());
+        size_type __i = 0, __j = 0, __n = size(), __m = __tmp.size();
+        while (__i < __n || __j < __m) {
+            if (__j < __m && (__i == __n || __comp_(__tmp[__j].first, __c_.keys[__i]))) {
+                if (__out.keys.empty() || __comp_(__out.keys.back(), __tmp[__j].first)) {
+                    __out.keys.push_back(std::move(__tmp[__j].first));
+                    __out.values.push_back(std::move(__tmp[__j].second));
+                }
+                ++__j;
+            } else if constexpr (__move_on_merge) {
+                __out.keys.push_back(std::move(__c_.keys[__i]));
+                __out.values.push_back(std::move(__c_.values[__i]));
+                ++__i;
+            } else {
+                __out.keys.push_back(std::as_const(__c_.keys[__i]));
+                __out.values.push_back(std::as_const(__c_.values[__i]));
+                ++__i;
+            }
+        }
+        __c_ = std::move(__out);
+    }
+
+    // 构造时的排序与去重，按键对下标排序后依次取出
+    void __sort_and_unique() {
+        mystl::vector<size_type> __idx(size());
+        std::iota(__idx.begin(), __idx.end(), size_type(0));
+        std::stable_sort(__idx.begin(), __idx.end(), [this](size_type __a, size_type __b) { return __comp_(__c_.keys[__a], __c_.keys[__b]); });
+        containers __out;
+        __out.keys.reserve(size());
+        __out.values.reserve(size());
+        for (size_type __j : __idx) {
+            if (__out.keys.empty() || __comp_(__out.keys.back(), __c_.keys[__j])) {
+                __out.keys.push_back(std::move(__c_.keys[__j]));
+                __out.values.push_back(std::move(__c_.values[__j]));
+            }
+        }
+        __c_ = std::move(__out);
+    }
+
+    template <bool _IsConst>
+    class __iterator {
+        using __key_iter    = typename key_container_type::const_iterator;
+        using __mapped_iter = std::conditional_t<_IsConst, typename mapped_container_type::const_iterator, typename mapped_container_type::iterator>;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = typename flat_map::value_type;
+        using difference_type   = typename flat_map::difference_type;
+        using reference         = std::conditional_t<_IsConst, typename flat_map::const_reference, typename flat_map::reference>;
+
+        // operator-> 返回的临时对象，持有代理引用
+        struct pointer {
+            reference __ref_;
+
+            const reference* operator->() const noexcept { return std::addressof(__ref_); }
+        };
+
+        __iterator() = default;
+
+        template <bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+        __iterator(const __iterator<_OtherConst>& __it) noexcept : __k_(__it.__k_), __v_(__it.__v_) {}
+
+        reference operator*() const noexcept { return reference(*__k_, *__v_); }
+
+        pointer operator->() const noexcept { return pointer{**this}; }
+
+        reference operator[](difference_type __n) const noexcept { return *(*this + __n); }
+
+        __iterator& operator++() noexcept {
+            ++__k_;
+            ++__v_;
+            return *this;
+        }
+
+        __iterator operator++(int) noexcept {
+            __iterator __tmp(*this);
+            ++*this;
+            return __tmp;
+        }
+
+        __iterator& operator--() noexcept {
+            --__k_;
+            --__v_;
+            return *this;
+        }
+
+        __iterator operator--(int) noexcept {
+            __iterator __tmp(*this);
+            --*this;
+            return __tmp;
+        }
+
+        __iterator& operator+=(difference_type __n) noexcept {
+            __k_ += __n;
+            __v_ += __n;
+            return *this;
+        }
+
+        __iterator& operator-=(difference_type __n) noexcept { return *this += -__n; }
+
+        friend __iterator operator+(__iterator __it, difference_type __n) noexcept { return __it += __n; }
+
+        friend __iterator operator+(difference_type __n, __iterator __it) noexcept { return __it += __n; }
+
+        friend __iterator operator-(__iterator __it, difference_type __n) noexcept { return __it -= __n; }
+
+        friend difference_type operator-(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ - __y.__k_; }
+
+        friend bool operator==(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ == __y.__k_; }
+
+        friend bool operator!=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ != __y.__k_; }
+
+        friend bool operator<(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ < __y.__k_; }
+
+        friend bool operator>(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ > __y.__k_; }
+
+        friend bool operator<=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ <= __y.__k_; }
+
+        friend bool operator>=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__k_ >= __y.__k_; }
+
+    private:
+        template <bool>
+        friend class __iterator;
+        friend class flat_map;
+
+        __key_iter __k_;
+        __mapped_iter __v_;
+
+        __iterator(__key_iter __k, __mapped_iter __v) noexcept : __k_(__k), __v_(__v) {}
+    };
+};
+
+template <class _Key, class _Tp, class _Compare, class _KeyContainer, class _MappedContainer, class _Predicate>
+size_t erase_if(flat_map<_Key, _Tp, _Compare, _KeyContainer, _MappedContainer>& __m, _Predicate __pred) {
+    auto __c = std::move(__m).extract();
+    size_t __j = 0, __n = __c.keys.size();
+    for (size_t __i = 0; __i < __n; ++__i) {
+        if (!__pred(std::pair<const _Key&, _Tp&>(__c.keys[__i], __c.values[__i]))) {
+            if (__i != __j) {
+                __c.keys[__j]   = std::move(__c.keys[__i]);
+                __c.values[__j] = std::move(__c.values[__i]);
+            }
+            ++__j;
+        }
+    }
+    __c.keys.erase(__c.keys.begin() + __j, __c.keys.end());
+    __c.values.erase(__c.values.begin() + __j, __c.values.end());
+    __m.replace(std::move(__c.keys), std::move(__c.values));
+    return __n - __j;
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_FLAT_MAP_H
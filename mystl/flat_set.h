@@ -0,0 +1,229 @@
+//===-------------------------------------===//
+//
+// flat_set.h
+// 以有序 vector 存储的集合，查找使用无分支二分查找
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_FLAT_SET_H
+#define _MYSTL_FLAT_SET_H
+
+#include <algorithm>
+#include <config.h>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <sorted_search.h>
+#include <utility>
+#include <vector.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 元素按 _Compare 排序后连续存放在 _KeyContainer 中，几千个元素以内的查找只访问少量缓存行
+// 插入与删除需要移动插入点之后的元素，批量插入应使用 insert(first, last) 或 insert(sorted_unique, first, last)
+// 迭代器只能读取元素，任何插入与删除都会使全部迭代器失效
+template <class _Key, class _Compare = std::less<_Key>, class _KeyContainer = mystl::vector<_Key>>
+class flat_set {
+public:
+    using key_type        = _Key;
+    using value_type      = _Key;
+    using key_compare     = _Compare;
+    using value_compare   = _Compare;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = typename _KeyContainer::size_type;
+    using difference_type = typename _KeyContainer::difference_type;
+    using iterator        = typename _KeyContainer::const_iterator;
+    using const_iterator  = typename _KeyContainer::const_iterator;
+    using container_type  = _KeyContainer;
+
+    static_assert(std::is_same_v<key_type, typename container_type::value_type>, "container_type::value_type must be same type as key_type");
+
+private:
+    container_type __keys_;
+    key_compare __comp_;
+
+public:
+    //
+    // construct
+    //
+    flat_set() = default;
+
+    explicit flat_set(const key_compare& __comp) : __keys_(), __comp_(__comp) {}
+
+    // 对 __cont 排序并去重
+    explicit flat_set(container_type __cont, const key_compare& __comp = key_compare()) : __keys_(std::move(__cont)), __comp_(__comp) {
+        __sort_and_unique(0);
+    }
+
+    // Precondition: __cont 已经按 __comp 排序且没有重复的元素
+    flat_set(sorted_unique_t, container_type __cont, const key_compare& __comp = key_compare()) : __keys_(std::move(__cont)), __comp_(__comp) {}
+
+    template <class _InputIterator>
+    flat_set(_InputIterator __first, _InputIterator __last, const key_compare& __comp = key_compare()) : __keys_(), __comp_(__comp) {
+        insert(__first, __last);
+    }
+
+    template <class _InputIterator>
+    flat_set(sorted_unique_t, _InputIterator __first, _InputIterator __last, const key_compare& __comp = key_compare())
+        : __keys_(__first, __last), __comp_(__comp) {}
+
+    flat_set(std::initializer_list<value_type> __il, const key_compare& __comp = key_compare()) : flat_set(__il.begin(), __il.end(), __comp) {}
+
+    flat_set(sorted_unique_t, std::initializer_list<value_type> __il, const key_compare& __comp = key_compare())
+        : flat_set(sorted_unique, __il.begin(), __il.end(), __comp) {}
+
+    flat_set& operator=(std::initializer_list<value_type> __il) {
+        clear();
+        insert(__il);
+        return *this;
+    }
+
+    //
+    // 迭代器
+    //
+    iterator begin() const noexcept { return __keys_.begin(); }
+
+    iterator end() const noexcept { return __keys_.end(); }
+
+    const_iterator cbegin() const noexcept { return __keys_.begin(); }
+
+    const_iterator cend() const noexcept { return __keys_.end(); }
+
+    //
+    // 容量
+    //
+    [[nodiscard]] bool empty() const noexcept { return __keys_.empty(); }
+
+    size_type size() const noexcept { return __keys_.size(); }
+
+    size_type max_size() const noexcept { return __keys_.max_size(); }
+
+    //
+    // 修改
+    //
+    template <class... _Args>
+    std::pair<iterator, bool> emplace(_Args&&... __args) {
+        return __insert_unique(value_type(std::forward<_Args>(__args)...));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& __x) { return __insert_unique(__x); }
+
+    std::pair<iterator, bool> insert(value_type&& __x) { return __insert_unique(std::move(__x)); }
+
+    // 新元素追加到末尾排序后与原有元素归并，复杂度 O(n + m log m)
+    template <class _InputIterator>
+    void insert(_InputIterator __first, _InputIterator __last) {
+        size_type __old = size();
+        __keys_.insert(__keys_.end(), __first, __last);
+        __sort_and_unique(__old);
+    }
+
+    // Precondition: [__first, __last) 已经排序且没有重复的元素，与原有元素的归并为 O(n + m)
+    template <class _InputIterator>
+    void insert(sorted_unique_t, _InputIterator __first, _InputIterator __last) {
+        size_type __old = size();
+        __keys_.insert(__keys_.end(), __first, __last);
+        __merge_unique(__old);
+    }
+
+    void insert(std::initializer_list<value_type> __il) { insert(__il.begin(), __il.end()); }
+
+    void insert(sorted_unique_t, std::initializer_list<value_type> __il) { insert(sorted_unique, __il.begin(), __il.end()); }
+
+    // 取出底层容器，之后 *this 为空
+    container_type extract() && {
+        container_type __tmp = std::move(__keys_);
+        __keys_.clear();
+        return __tmp;
+    }
+
+    // Precondition: __cont 已经按 key_comp() 排序且没有重复的元素
+    void replace(container_type&& __cont) { __keys_ = std::move(__cont); }
+
+    iterator erase(const_iterator __pos) { return __keys_.erase(__pos); }
+
+    iterator erase(const_iterator __first, const_iterator __last) { return __keys_.erase(__first, __last); }
+
+    size_type erase(const key_type& __k) {
+        iterator __it = find(__k);
+        if (__it == end()) return 0;
+        erase(__it);
+        return 1;
+    }
+
+    void swap(flat_set& __other) noexcept {
+        using std::swap;
+        swap(__keys_, __other.__keys_);
+        swap(__comp_, __other.__comp_);
+    }
+
+    void clear() noexcept { __keys_.clear(); }
+
+    //
+    // 查找
+    //
+    key_compare key_comp() const { return __comp_; }
+
+    value_compare value_comp() const { return __comp_; }
+
+    iterator lower_bound(const key_type& __k) const { return mystl::__branchless_lower_bound(begin(), size(), __k, __comp_); }
+
+    iterator upper_bound(const key_type& __k) const { return mystl::__branchless_upper_bound(begin(), size(), __k, __comp_); }
+
+    iterator find(const key_type& __k) const {
+        iterator __it = lower_bound(__k);
+        return __it != end() && !__comp_(__k, *__it) ? __it : end();
+    }
+
+    bool contains(const key_type& __k) const { return find(__k) != end(); }
+
+    size_type count(const key_type& __k) const { return contains(__k) ? 1 : 0; }
+
+    std::pair<iterator, iterator> equal_range(const key_type& __k) const {
+        iterator __it = lower_bound(__k);
+        return {__it, __it != end() && !__comp_(__k, *__it) ? __it + 1 : __it};
+    }
+
+    friend bool operator==(const flat_set& __x, const flat_set& __y) { return std::equal(__x.begin(), __x.end(), __y.begin(), __y.end()); }
+
+    friend bool operator!=(const flat_set& __x, const flat_set& __y) { return !(__x == __y); }
+
+    friend void swap(flat_set& __x, flat_set& __y) noexcept { __x.swap(__y); }
+
+private:
+    template <class _Vp>
+    std::pair<iterator, bool> __insert_unique(_Vp&& __x) {
+        iterator __it = lower_bound(__x);
+        if (__it != end() && !__comp_(__x, *__it)) { return {__it, false}; }
+        return {__keys_.insert(__it, std::forward<_Vp>(__x)), true};
+    }
+
+    // [0, __mid) 已经有序且唯一，对 [__mid, size()) 排序后归并
+    void __sort_and_unique(size_type __mid) {
+        std::stable_sort(__keys_.begin() + __mid, __keys_.end(), __comp_);
+        __merge_unique(__mid);
+    }
+
+    // [0, __mid) 与 [__mid, size()) 分别有序，归并后删除重复的元素，重复时保留靠前的元素
+    void __merge_unique(size_type __mid) {
+        auto __first = __keys_.begin();
+        std::inplace_merge(__first, __first + __mid, __keys_.end(), __comp_);
+        auto __last = std::unique(__first, __keys_.end(), [this](const value_type& __a, const value_type& __b) { return !__comp_(__a, __b); });
+        __keys_.erase(__last, __keys_.end());
+    }
+};
+
+template <class _Key, class _Compare, class _KeyContainer, class _Predicate>
+typename flat_set<_Key, _Compare, _KeyContainer>::size_type erase_if(flat_set<_Key, _Compare, _KeyContainer>& __s, _Predicate __pred) {
+    _KeyContainer __keys = std::move(__s).extract();
+    auto __old_size      = __keys.size();
+    __keys.erase(std::remove_if(__keys.begin(), __keys.end(), __pred), __keys.end());
+    auto __removed = __old_size - __keys.size();
+    __s.replace(std::move(__keys));
+    return __removed;
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_FLAT_SET_H
@@ -0,0 +1,50 @@
+//===-------------------------------------===//
+//
+// hardening.h
+// 前置条件检查，检查的强度由 config.h 中的 _MYSTL_HARDENING_MODE 决定
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_HARDENING_H
+#define _MYSTL_HARDENING_H
+
+#include <config.h>
+#include <cstdio>
+#include <cstdlib>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// debug 模式下检查失败时输出位置与信息后终止
+[[noreturn]] inline void __hardening_failure(const char* __file, unsigned __line, const char* __expr, const char* __msg) noexcept {
+    std::fprintf(stderr, "%s:%u: assertion %s failed: %s\n", __file, __line, __expr, __msg);
+    std::abort();
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+// _MYSTL_ASSERT 检查开销为 O(1) 且违反后会破坏内存的前置条件，例如下标越界、对空容器调用 front/back/pop_back，
+// 在 fast 与 debug 模式下开启
+// _MYSTL_ASSERT_DEBUG 检查其余前置条件，例如迭代器是否属于该容器、两个容器的分配器是否相等，只在 debug 模式下开启
+// fast 模式失败时直接执行 __builtin_trap，不引入格式化输出的代码，debug 模式输出失败的位置
+// none 模式下两者都展开为 ((void)0)，表达式不会被求值，与没有检查的代码完全相同
+#if _MYSTL_HARDENING_MODE == _MYSTL_HARDENING_MODE_DEBUG
+#    define _MYSTL_HARDENING_FAIL(__expr, __msg) ::mystl::__hardening_failure(__FILE__, __LINE__, #__expr, __msg)
+#else
+#    define _MYSTL_HARDENING_FAIL(__expr, __msg) __builtin_trap()
+#endif
+
+#define _MYSTL_HARDENING_CHECK(__expr, __msg) (__builtin_expect(static_cast<bool>(__expr), 1) ? (void)0 : _MYSTL_HARDENING_FAIL(__expr, __msg))
+
+#if _MYSTL_HARDENING_MODE >= _MYSTL_HARDENING_MODE_FAST
+#    define _MYSTL_ASSERT(__expr, __msg) _MYSTL_HARDENING_CHECK(__expr, __msg)
+#else
+#    define _MYSTL_ASSERT(__expr, __msg) ((void)0)
+#endif
+
+#if _MYSTL_HARDENING_MODE >= _MYSTL_HARDENING_MODE_DEBUG
+#    define _MYSTL_ASSERT_DEBUG(__expr, __msg) _MYSTL_HARDENING_CHECK(__expr, __msg)
+#else
+#    define _MYSTL_ASSERT_DEBUG(__expr, __msg) ((void)0)
+#endif
+
+#endif // _MYSTL_HARDENING_H
@@ -0,0 +1,430 @@
+//===-------------------------------------===//
+//
+// incremental_vector.h
+// 渐进式扩容的 vector，扩容时不一次迁移全部元素，单次 push_back 的最坏耗时与 size() 无关
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_INCREMENTAL_VECTOR_H
+#define _MYSTL_INCREMENTAL_VECTOR_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <config.h>
+#include <exception_guard.h>
+#include <hardening.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <limits>
+#include <memory>
+#include <throw.h>
+#include <type_traits>
+#include <uninitialized_algorithms.h>
+#include <utility>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// vector 扩容时在一次调用中迁移全部元素，数百 MB 的 vector 会产生数百毫秒的停顿
+// incremental_vector 扩容时只分配新空间，旧空间暂时保留：
+//     [0, __moved_) 已经迁移到新空间，[__moved_, __old_size_) 仍在旧空间，[__old_size_, size()) 在新空间
+// 之后每次 push_back/emplace_back 额外迁移至多 max(migration_step(), ⌈剩余 / 新空间空余⌉) 个元素，
+// 容量翻倍时保证新空间写满之前迁移完成，也可以在空闲时调用 migrate_step 主动推进
+// 迁移期间元素不连续，下标访问多一次比较，data() 会先完成迁移
+// 扩容本身不移动元素，已有元素的引用直到被迁移前都保持有效
+template <typename _Tp, class _Allocator = mystl::allocator<_Tp>>
+class incremental_vector {
+    template <bool _IsConst>
+    class __iterator;
+
+public:
+    using value_type      = _Tp;
+    using allocator_type  = _Allocator;
+    using alloc_traits    = std::allocator_traits<allocator_type>;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using size_type       = typename alloc_traits::size_type;
+    using difference_type = typename alloc_traits::difference_type;
+    using pointer         = typename alloc_traits::pointer;
+    using const_pointer   = typename alloc_traits::const_pointer;
+    using iterator        = __iterator<false>;
+    using const_iterator  = __iterator<true>;
+
+    static_assert(std::is_same_v<typename allocator_type::value_type, value_type>, "Allocator::value_type must be same type as value_type");
+
+    // 每次修改操作至少迁移的元素数
+    static constexpr size_type default_migration_step = 16;
+
+private:
+    pointer __begin_      = nullptr;
+    size_type __size_     = 0;
+    size_type __cap_      = 0;
+    pointer __old_        = nullptr; // 迁移中的旧空间，没有迁移时为空
+    size_type __old_cap_  = 0;
+    size_type __moved_    = 0;
+    size_type __old_size_ = 0;
+    size_type __step_     = default_migration_step;
+    allocator_type __alloc_;
+
+public:
+    //
+    // construct/copy/destroy
+    //
+    incremental_vector() noexcept(std::is_nothrow_default_constructible<allocator_type>::value) {}
+
+    explicit incremental_vector(const allocator_type& __a) noexcept : __alloc_(__a) {}
+
+    incremental_vector(std::initializer_list<value_type> __il, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        auto __guard = mystl::__make_exception_guard([this] { __release(); });
+        reserve(__il.size());
+        for (const value_type& __x : __il) { emplace_back(__x); }
+        __guard.__complete();
+    }
+
+    incremental_vector(const incremental_vector& __other)
+        : __step_(__other.__step_), __alloc_(alloc_traits::select_on_container_copy_construction(__other.__alloc_)) {
+        auto __guard = mystl::__make_exception_guard([this] { __release(); });
+        reserve(__other.size());
+        for (const value_type& __x : __other) { emplace_back(__x); }
+        __guard.__complete();
+    }
+
+    incremental_vector(incremental_vector&& __other) noexcept : __alloc_(std::move(__other.__alloc_)) { __steal(__other); }
+
+    ~incremental_vector() { __release(); }
+
+    incremental_vector& operator=(const incremental_vector& __other) {
+        if (this != std::addressof(__other)) {
+            incremental_vector __tmp(__other);
+            swap(__tmp);
+        }
+        return *this;
+    }
+
+    incremental_vector& operator=(incremental_vector&& __other) noexcept {
+        if (this != std::addressof(__other)) {
+            __release();
+            __alloc_ = std::move(__other.__alloc_);
+            __steal(__other);
+        }
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return __alloc_; }
+
+    //
+    // 迭代器，迁移期间同样有效，但扩容或迁移后失效
+    //
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    iterator end() noexcept { return iterator(this, __size_); }
+
+    const_iterator end() const noexcept { return const_iterator(this, __size_); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    //
+    // 容量
+    //
+    size_type size() const noexcept { return __size_; }
+
+    size_type capacity() const noexcept { return __cap_; }
+
+    [[nodiscard]] bool empty() const noexcept { return __size_ == 0; }
+
+    size_type max_size() const noexcept {
+        return std::min<size_type>(alloc_traits::max_size(__alloc_), std::numeric_limits<difference_type>::max());
+    }
+
+    // 扩容为渐进式，与 push_back 的扩容相同
+    void reserve(size_type __n) {
+        if (__n > __cap_) {
+            if (__n > max_size()) { mystl::__throw_length_error("incremental_vector"); }
+            __grow(__n);
+        }
+    }
+
+    //
+    // 迁移控制
+    //
+    // 是否有元素仍在旧空间中
+    bool migrating() const noexcept { return __old_ != nullptr; }
+
+    size_type migration_step() const noexcept { return __step_; }
+
+    // Precondition: __n > 0
+    void set_migration_step(size_type __n) noexcept {
+        _MYSTL_ASSERT_DEBUG(__n > 0, "incremental_vector::set_migration_step: step must be positive");
+        __step_ = __n;
+    }
+
+    // 迁移至多 __n 个元素，返回是否仍有元素未迁移，例如在请求之间的空闲时间调用
+    bool migrate_step(size_type __n) {
+        if (__old_) { __migrate(__n); }
+        return migrating();
+    }
+
+    void finish_migration() {
+        if (__old_) { __migrate(__old_size_ - __moved_); }
+    }
+
+    //
+    // 元素访问
+    //
+    reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(__n < __size_, "incremental_vector[] index out of bounds");
+        return *__locate(__n);
+    }
+
+    const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(__n < __size_, "incremental_vector[] index out of bounds");
+        return *__locate(__n);
+    }
+
+    reference at(size_type __n) {
+        if (__n >= __size_) { mystl::__throw_out_of_range("incremental_vector"); }
+        return *__locate(__n);
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= __size_) { mystl::__throw_out_of_range("incremental_vector"); }
+        return *__locate(__n);
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    reference back() noexcept { return (*this)[__size_ - 1]; }
+
+    const_reference back() const noexcept { return (*this)[__size_ - 1]; }
+
+    // 完成迁移后返回连续存储的首地址
+    pointer data() {
+        finish_migration();
+        return __begin_;
+    }
+
+    //
+    // 修改
+    //
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        if (__size_ == __cap_) {
+            if (__old_) {
+                // 正常情况下新空间写满前已经迁移完成，参数可能引用旧空间中的元素，先构造再完成迁移
+                value_type __tmp(std::forward<_Args>(__args)...);
+                finish_migration();
+                __grow(__recommend(__size_ + 1));
+                alloc_traits::construct(__alloc_, std::to_address(__begin_ + __size_), std::move(__tmp));
+            } else {
+                // 扩容不移动元素，参数引用的元素仍然有效
+                __grow(__recommend(__size_ + 1));
+                alloc_traits::construct(__alloc_, std::to_address(__begin_ + __size_), std::forward<_Args>(__args)...);
+            }
+        } else {
+            alloc_traits::construct(__alloc_, std::to_address(__begin_ + __size_), std::forward<_Args>(__args)...);
+        }
+        ++__size_;
+        if (__old_) { __migrate(__budget()); }
+        return __begin_[__size_ - 1];
+    }
+
+    void push_back(const_reference __x) { emplace_back(__x); }
+
+    void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    void pop_back() noexcept {
+        _MYSTL_ASSERT(__size_ > 0, "incremental_vector::pop_back called on an empty container");
+        --__size_;
+        alloc_traits::destroy(__alloc_, std::to_address(__locate(__size_)));
+        if (__old_ && __size_ < __old_size_) {
+            // 被删除的元素在旧空间中
+            __old_size_ = __size_;
+            if (__old_size_ == __moved_) { __release_old(); }
+        }
+    }
+
+    void clear() noexcept {
+        while (__size_ > 0) { pop_back(); }
+    }
+
+    void swap(incremental_vector& __other) noexcept {
+        using std::swap;
+        swap(__begin_, __other.__begin_);
+        swap(__size_, __other.__size_);
+        swap(__cap_, __other.__cap_);
+        swap(__old_, __other.__old_);
+        swap(__old_cap_, __other.__old_cap_);
+        swap(__moved_, __other.__moved_);
+        swap(__old_size_, __other.__old_size_);
+        swap(__step_, __other.__step_);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) { swap(__alloc_, __other.__alloc_); }
+    }
+
+    friend void swap(incremental_vector& __x, incremental_vector& __y) noexcept { __x.swap(__y); }
+
+private:
+    // 没有迁移时 __old_size_ == __moved_ == 0，只需一次无符号比较
+    pointer __locate(size_type __i) const noexcept { return __i - __moved_ < __old_size_ - __moved_ ? __old_ + __i : __begin_ + __i; }
+
+    size_type __recommend(size_type __new_size) const {
+        const size_type __ms = max_size();
+        if (__new_size > __ms) { mystl::__throw_length_error("incremental_vector"); }
+        if (__cap_ >= __ms / 2) { return __ms; }
+        return std::max<size_type>(2 * __cap_, __new_size);
+    }
+
+    // 本次操作需要迁移的元素数，保证新空间写满之前迁移完成
+    size_type __budget() const noexcept {
+        size_type __remaining = __old_size_ - __moved_;
+        size_type __free      = __cap_ - __size_;
+        if (__free == 0) return __remaining;
+        return std::max(__step_, (__remaining + __free - 1) / __free);
+    }
+
+    // 分配新空间，原有元素留在旧空间中等待迁移
+    // Precondition: !migrating() 或调用前已经 finish_migration()
+    void __grow(size_type __new_cap) {
+        finish_migration();
+        pointer __new_begin = alloc_traits::allocate(__alloc_, __new_cap);
+        if (__size_ == 0) {
+            if (__begin_) { alloc_traits::deallocate(__alloc_, __begin_, __cap_); }
+        } else {
+            __old_      = __begin_;
+            __old_cap_  = __cap_;
+            __old_size_ = __size_;
+            __moved_    = 0;
+        }
+        __begin_ = __new_begin;
+        __cap_   = __new_cap;
+    }
+
+    // 迁移 [__moved_, __moved_ + __n)，失败时这些元素仍在旧空间中
+    void __migrate(size_type __n) {
+        __n = std::min(__n, __old_size_ - __moved_);
+        mystl::__uninitialized_allocator_relocate(__alloc_, __old_ + __moved_, __old_ + __moved_ + __n, __begin_ + __moved_);
+        __moved_ += __n;
+        if (__moved_ == __old_size_) { __release_old(); }
+    }
+
+    void __release_old() noexcept {
+        alloc_traits::deallocate(__alloc_, __old_, __old_cap_);
+        __old_      = nullptr;
+        __old_cap_  = 0;
+        __moved_    = 0;
+        __old_size_ = 0;
+    }
+
+    void __release() noexcept {
+        clear();
+        if (__begin_) { alloc_traits::deallocate(__alloc_, __begin_, __cap_); }
+        __begin_ = nullptr;
+        __cap_   = 0;
+    }
+
+    void __steal(incremental_vector& __other) noexcept {
+        __begin_    = std::exchange(__other.__begin_, nullptr);
+        __size_     = std::exchange(__other.__size_, 0);
+        __cap_      = std::exchange(__other.__cap_, 0);
+        __old_      = std::exchange(__other.__old_, nullptr);
+        __old_cap_  = std::exchange(__other.__old_cap_, 0);
+        __moved_    = std::exchange(__other.__moved_, 0);
+        __old_size_ = std::exchange(__other.__old_size_, 0);
+        __step_     = __other.__step_;
+    }
+
+    template <bool _IsConst>
+    class __iterator {
+        using __container = std::conditional_t<_IsConst, const incremental_vector, incremental_vector>;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = _Tp;
+        using difference_type   = typename incremental_vector::difference_type;
+        using pointer           = std::conditional_t<_IsConst, const value_type*, value_type*>;
+        using reference         = std::conditional_t<_IsConst, const value_type&, value_type&>;
+
+        __iterator() noexcept : __v_(nullptr), __i_(0) {}
+
+        template <bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+        __iterator(const __iterator<_OtherConst>& __it) noexcept : __v_(__it.__v_), __i_(__it.__i_) {}
+
+        reference operator*() const noexcept { return (*__v_)[__i_]; }
+
+        pointer operator->() const noexcept { return std::addressof((*__v_)[__i_]); }
+
+        reference operator[](difference_type __n) const noexcept { return (*__v_)[__i_ + __n]; }
+
+        __iterator& operator++() noexcept {
+            ++__i_;
+            return *this;
+        }
+
+        __iterator operator++(int) noexcept {
+            __iterator __tmp(*this);
+            ++__i_;
+            return __tmp;
+        }
+
+        __iterator& operator--() noexcept {
+            --__i_;
+            return *this;
+        }
+
+        __iterator operator--(int) noexcept {
+            __iterator __tmp(*this);
+            --__i_;
+            return __tmp;
+        }
+
+        __iterator& operator+=(difference_type __n) noexcept {
+            __i_ += __n;
+            return *this;
+        }
+
+        __iterator& operator-=(difference_type __n) noexcept {
+            __i_ -= __n;
+            return *this;
+        }
+
+        friend __iterator operator+(__iterator __it, difference_type __n) noexcept { return __it += __n; }
+
+        friend __iterator operator+(difference_type __n, __iterator __it) noexcept { return __it += __n; }
+
+        friend __iterator operator-(__iterator __it, difference_type __n) noexcept { return __it -= __n; }
+
+        friend difference_type operator-(const __iterator& __x, const __iterator& __y) noexcept {
+            return static_cast<difference_type>(__x.__i_) - static_cast<difference_type>(__y.__i_);
+        }
+
+        friend bool operator==(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ == __y.__i_; }
+
+        friend bool operator!=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ != __y.__i_; }
+
+        friend bool operator<(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ < __y.__i_; }
+
+        friend bool operator>(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ > __y.__i_; }
+
+        friend bool operator<=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ <= __y.__i_; }
+
+        friend bool operator>=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ >= __y.__i_; }
+
+    private:
+        template <bool>
+        friend class __iterator;
+        friend class incremental_vector;
+
+        __container* __v_;
+        size_type __i_;
+
+        __iterator(__container* __v, size_type __i) noexcept : __v_(__v), __i_(__i) {}
+    };
+};
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_INCREMENTAL_VECTOR_H
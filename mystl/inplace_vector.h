@@ -0,0 +1,474 @@
+//===-------------------------------------===//
+//
+// inplace_vector.h
+// 容量在编译期确定的 vector，元素全部存放在对象内部，不使用分配器
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_INPLACE_VECTOR_H
+#define _MYSTL_INPLACE_VECTOR_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <config.h>
+#include <cstdint>
+#include <exception_guard.h>
+#include <hardening.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <new>
+#include <throw.h>
+#include <type_traits>
+#include <uninitialized_algorithms.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 根据容量选择能够表示 [0, _Np] 的最小整数类型存储 size，使对象的大小尽可能紧凑且可预测
+template <size_t _Np>
+using __inplace_vector_size_t =
+    std::conditional_t<_Np <= UINT8_MAX, uint8_t,
+                       std::conditional_t<_Np <= UINT16_MAX, uint16_t, std::conditional_t<_Np <= UINT32_MAX, uint32_t, size_t>>>;
+
+// 存储部分
+// 对于平凡可拷贝的类型，特殊成员函数全部为默认实现，inplace_vector 本身也是平凡可拷贝的
+// 对于其他类型，需要逐个拷贝/移动/析构已构造的元素
+// 元素的构造使用 uninitialized_algorithms.h 中的函数，分配器只作为构造方式使用，不会进行分配
+template <class _Tp, size_t _Np, bool = std::is_trivially_copyable_v<_Tp>>
+struct __inplace_vector_base {
+    using __alloc_type = mystl::allocator<_Tp>;
+
+    __inplace_vector_size_t<_Np> __size_ = 0;
+    alignas(_Tp) unsigned char __buffer_[sizeof(_Tp) * _Np];
+
+    _Tp* __data() noexcept { return reinterpret_cast<_Tp*>(__buffer_); }
+
+    const _Tp* __data() const noexcept { return reinterpret_cast<const _Tp*>(__buffer_); }
+};
+
+template <class _Tp, size_t _Np>
+struct __inplace_vector_base<_Tp, _Np, false> {
+    using __alloc_type = mystl::allocator<_Tp>;
+
+    __inplace_vector_size_t<_Np> __size_ = 0;
+    alignas(_Tp) unsigned char __buffer_[sizeof(_Tp) * _Np];
+
+    _Tp* __data() noexcept { return reinterpret_cast<_Tp*>(__buffer_); }
+
+    const _Tp* __data() const noexcept { return reinterpret_cast<const _Tp*>(__buffer_); }
+
+    __inplace_vector_base() = default;
+
+    __inplace_vector_base(const __inplace_vector_base& __other) {
+        __alloc_type __a;
+        __unintialized_allocator_copy(__a, __other.__data(), __other.__data() + __other.__size_, __data());
+        __size_ = __other.__size_;
+    }
+
+    __inplace_vector_base(__inplace_vector_base&& __other) noexcept(std::is_nothrow_move_constructible_v<_Tp>) {
+        __alloc_type __a;
+        __unintialized_allocator_copy(__a, std::make_move_iterator(__other.__data()), std::make_move_iterator(__other.__data() + __other.__size_),
+                                      __data());
+        __size_ = __other.__size_;
+    }
+
+    __inplace_vector_base& operator=(const __inplace_vector_base& __other) {
+        if (this != std::addressof(__other)) { __assign(__other.__data(), __other.__size_); }
+        return *this;
+    }
+
+    __inplace_vector_base& operator=(__inplace_vector_base&& __other) noexcept(std::is_nothrow_move_assignable_v<_Tp> &&
+                                                                                std::is_nothrow_move_constructible_v<_Tp>) {
+        if (this != std::addressof(__other)) { __assign(std::make_move_iterator(__other.__data()), __other.__size_); }
+        return *this;
+    }
+
+    ~__inplace_vector_base() { __destruct_at_end(0); }
+
+    // 析构 [__new_size, __size_) 中的元素
+    void __destruct_at_end(size_t __new_size) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<_Tp>) {
+            __alloc_type __a;
+            for (size_t __i = __size_; __i != __new_size; --__i) { std::allocator_traits<__alloc_type>::destroy(__a, __data() + __i - 1); }
+        }
+        __size_ = static_cast<__inplace_vector_size_t<_Np>>(__new_size);
+    }
+
+    // 对已有元素赋值，多出的部分构造或析构
+    template <class _Iter>
+    void __assign(_Iter __first, size_t __n) {
+        size_t __common = std::min<size_t>(__n, __size_);
+        std::copy_n(__first, __common, __data());
+        __first += __common;
+        if (__n <= __size_) {
+            __destruct_at_end(__n);
+        } else {
+            __alloc_type __a;
+            __unintialized_allocator_copy(__a, __first, __first + (__n - __common), __data() + __common);
+            __size_ = static_cast<__inplace_vector_size_t<_Np>>(__n);
+        }
+    }
+};
+
+template <typename _Tp, size_t _Np>
+class inplace_vector : private __inplace_vector_base<_Tp, _Np> {
+    using __base       = __inplace_vector_base<_Tp, _Np>;
+    using __alloc_type = typename __base::__alloc_type;
+    using __traits     = std::allocator_traits<__alloc_type>;
+
+public:
+    using value_type             = _Tp;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = mystl::wrap_iter<pointer>;
+    using const_iterator         = mystl::wrap_iter<const_pointer>;
+    using reverse_iterator       = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static_assert(_Np > 0, "inplace_vector requires a non-zero capacity");
+
+    //
+    // construct/copy/destroy
+    // 拷贝、移动与析构由 __inplace_vector_base 提供
+    //
+    inplace_vector() noexcept = default;
+
+    explicit inplace_vector(size_type __n) {
+        __check_capacity(__n);
+        __construct_at_end(__n);
+    }
+
+    inplace_vector(size_type __n, const_reference __x) {
+        __check_capacity(__n);
+        __construct_at_end(__n, __x);
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    inplace_vector(_InputIterator __first, _InputIterator __last) {
+        __append(__first, __last);
+    }
+
+    inplace_vector(std::initializer_list<value_type> __il) : inplace_vector(__il.begin(), __il.end()) {}
+
+    inplace_vector& operator=(std::initializer_list<value_type> __il) {
+        assign(__il.begin(), __il.end());
+        return *this;
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    void assign(_InputIterator __first, _InputIterator __last) {
+        if constexpr (mystl::is_based_on_forward_iterator<_InputIterator>::value) {
+            size_type __n = static_cast<size_type>(std::distance(__first, __last));
+            __check_capacity(__n);
+            __assign_n(__first, __n);
+        } else {
+            clear();
+            __append(__first, __last);
+        }
+    }
+
+    void assign(size_type __n, const_reference __x) {
+        __check_capacity(__n);
+        size_type __old_size = size();
+        std::fill_n(data(), std::min(__n, __old_size), __x);
+        if (__n <= __old_size) {
+            __base_destruct_at_end(__n);
+        } else {
+            __construct_at_end(__n - __old_size, __x);
+        }
+    }
+
+    void assign(std::initializer_list<value_type> __il) { assign(__il.begin(), __il.end()); }
+
+    //
+    // Iterators
+    //
+    iterator begin() noexcept { return iterator(data()); }
+
+    const_iterator begin() const noexcept { return const_iterator(data()); }
+
+    iterator end() noexcept { return iterator(data() + size()); }
+
+    const_iterator end() const noexcept { return const_iterator(data() + size()); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //
+    // capacity
+    //
+    size_type size() const noexcept { return static_cast<size_type>(this->__size_); }
+
+    static constexpr size_type capacity() noexcept { return _Np; }
+
+    static constexpr size_type max_size() noexcept { return _Np; }
+
+    [[nodiscard]] bool empty() const noexcept { return this->__size_ == 0; }
+
+    bool full() const noexcept { return size() == _Np; }
+
+    // 容量固定，超出容量时抛出 bad_alloc
+    static void reserve(size_type __n) { __check_capacity(__n); }
+
+    static void shrink_to_fit() noexcept {}
+
+    void resize(size_type __size) {
+        if (size() < __size) {
+            __check_capacity(__size);
+            __construct_at_end(__size - size());
+        } else {
+            __base_destruct_at_end(__size);
+        }
+    }
+
+    void resize(size_type __size, const_reference __x) {
+        if (size() < __size) {
+            __check_capacity(__size);
+            __construct_at_end(__size - size(), __x);
+        } else {
+            __base_destruct_at_end(__size);
+        }
+    }
+
+    //
+    // element access
+    //
+    reference operator[](size_type __n) noexcept { return data()[__n]; }
+
+    const_reference operator[](size_type __n) const noexcept { return data()[__n]; }
+
+    reference at(size_type __n) {
+        if (__n >= size()) { mystl::__throw_out_of_range("inplace_vector"); }
+        return data()[__n];
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= size()) { mystl::__throw_out_of_range("inplace_vector"); }
+        return data()[__n];
+    }
+
+    reference front() noexcept { return data()[0]; }
+
+    const_reference front() const noexcept { return data()[0]; }
+
+    reference back() noexcept { return data()[size() - 1]; }
+
+    const_reference back() const noexcept { return data()[size() - 1]; }
+
+    pointer data() noexcept { return this->__data(); }
+
+    const_pointer data() const noexcept { return this->__data(); }
+
+    //
+    // modifiers
+    //
+    // 容量已满时抛出 bad_alloc
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        if (full()) { mystl::__throw_bad_alloc(); }
+        return unchecked_emplace_back(std::forward<_Args>(__args)...);
+    }
+
+    void push_back(const_reference __x) { emplace_back(__x); }
+
+    void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    // 容量已满时返回 nullptr，不修改容器
+    template <class... _Args>
+    pointer try_emplace_back(_Args&&... __args) {
+        if (full()) { return nullptr; }
+        return std::addressof(unchecked_emplace_back(std::forward<_Args>(__args)...));
+    }
+
+    pointer try_push_back(const_reference __x) { return try_emplace_back(__x); }
+
+    pointer try_push_back(value_type&& __x) { return try_emplace_back(std::move(__x)); }
+
+    // 不检查容量
+    // Precondition: !full()
+    template <class... _Args>
+    reference unchecked_emplace_back(_Args&&... __args) {
+        _MYSTL_ASSERT(!full(), "inplace_vector::unchecked_emplace_back: capacity exceeded");
+        __alloc_type __a;
+        pointer __p = data() + size();
+        __traits::construct(__a, __p, std::forward<_Args>(__args)...);
+        ++this->__size_;
+        return *__p;
+    }
+
+    void unchecked_push_back(const_reference __x) { unchecked_emplace_back(__x); }
+
+    void unchecked_push_back(value_type&& __x) { unchecked_emplace_back(std::move(__x)); }
+
+    void pop_back() { __base_destruct_at_end(size() - 1); }
+
+    iterator insert(const_iterator __position, const_reference __x) { return emplace(__position, __x); }
+
+    iterator insert(const_iterator __position, value_type&& __x) { return emplace(__position, std::move(__x)); }
+
+    iterator insert(const_iterator __position, size_type __n, const_reference __x) {
+        difference_type __offset = __position - cbegin();
+        size_type __old_size     = size();
+        __check_capacity(__old_size + __n);
+        __construct_at_end(__n, __x);
+        std::rotate(data() + __offset, data() + __old_size, data() + size());
+        return begin() + __offset;
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    iterator insert(const_iterator __position, _InputIterator __first, _InputIterator __last) {
+        difference_type __offset = __position - cbegin();
+        size_type __old_size     = size();
+        __append(__first, __last);
+        std::rotate(data() + __offset, data() + __old_size, data() + size());
+        return begin() + __offset;
+    }
+
+    iterator insert(const_iterator __position, std::initializer_list<value_type> __il) { return insert(__position, __il.begin(), __il.end()); }
+
+    // 先在末尾构造再旋转到目标位置，参数可以引用容器中的元素
+    template <class... _Args>
+    iterator emplace(const_iterator __position, _Args&&... __args) {
+        difference_type __offset = __position - cbegin();
+        emplace_back(std::forward<_Args>(__args)...);
+        std::rotate(data() + __offset, data() + size() - 1, data() + size());
+        return begin() + __offset;
+    }
+
+    iterator erase(const_iterator __position) { return erase(__position, __position + 1); }
+
+    iterator erase(const_iterator __first, const_iterator __last) {
+        pointer __p = data() + (__first - cbegin());
+        if (__first != __last) {
+            pointer __new_end = std::move(__p + (__last - __first), data() + size(), __p);
+            __base_destruct_at_end(static_cast<size_type>(__new_end - data()));
+        }
+        return iterator(__p);
+    }
+
+    void clear() noexcept { __base_destruct_at_end(0); }
+
+    void swap(inplace_vector& __other) noexcept(std::is_nothrow_swappable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>) {
+        inplace_vector* __small = this;
+        inplace_vector* __large = std::addressof(__other);
+        if (__small->size() > __large->size()) { std::swap(__small, __large); }
+        size_type __n = __small->size();
+        std::swap_ranges(__small->data(), __small->data() + __n, __large->data());
+        __small->__append(std::make_move_iterator(__large->data() + __n), std::make_move_iterator(__large->data() + __large->size()));
+        __large->__base_destruct_at_end(__n);
+    }
+
+private:
+    static void __check_capacity(size_type __n) {
+        if (__n > _Np) { mystl::__throw_bad_alloc(); }
+    }
+
+    // 与 vector 的同名函数相同，析构 [__new_size, size()) 中的元素
+    void __base_destruct_at_end(size_type __new_size) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            __alloc_type __a;
+            for (size_type __i = size(); __i != __new_size; --__i) { __traits::destroy(__a, data() + __i - 1); }
+        }
+        this->__size_ = static_cast<__inplace_vector_size_t<_Np>>(__new_size);
+    }
+
+    // Precondition: size() + __n <= capacity()
+    void __construct_at_end(size_type __n) {
+        __alloc_type __a;
+        pointer __first = data() + size();
+        pointer __pos   = __first;
+        auto __guard    = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<__alloc_type, pointer>(__a, __first, __pos));
+        for (; __pos != __first + __n; ++__pos) { __traits::construct(__a, __pos); }
+        __guard.__complete();
+        this->__size_ += static_cast<__inplace_vector_size_t<_Np>>(__n);
+    }
+
+    // Precondition: size() + __n <= capacity()
+    void __construct_at_end(size_type __n, const_reference __x) {
+        __alloc_type __a;
+        pointer __first = data() + size();
+        pointer __pos   = __first;
+        auto __guard    = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<__alloc_type, pointer>(__a, __first, __pos));
+        for (; __pos != __first + __n; ++__pos) { __traits::construct(__a, __pos, __x); }
+        __guard.__complete();
+        this->__size_ += static_cast<__inplace_vector_size_t<_Np>>(__n);
+    }
+
+    // 在末尾追加 [__first, __last)，前向迭代器在修改前检查容量
+    template <class _InputIterator>
+    void __append(_InputIterator __first, _InputIterator __last) {
+        if constexpr (mystl::is_based_on_forward_iterator<_InputIterator>::value) {
+            size_type __n = static_cast<size_type>(std::distance(__first, __last));
+            __check_capacity(size() + __n);
+            __alloc_type __a;
+            __unintialized_allocator_copy(__a, __first, __last, data() + size());
+            this->__size_ += static_cast<__inplace_vector_size_t<_Np>>(__n);
+        } else {
+            for (; __first != __last; ++__first) { emplace_back(*__first); }
+        }
+    }
+
+    // Precondition: __n <= capacity()
+    template <class _ForwardIterator>
+    void __assign_n(_ForwardIterator __first, size_type __n) {
+        size_type __common = std::min(__n, size());
+        for (size_type __i = 0; __i < __common; ++__i, ++__first) { data()[__i] = *__first; }
+        if (__n <= size()) {
+            __base_destruct_at_end(__n);
+        } else {
+            __alloc_type __a;
+            _ForwardIterator __last = std::next(__first, __n - __common);
+            __unintialized_allocator_copy(__a, __first, __last, data() + size());
+            this->__size_ = static_cast<__inplace_vector_size_t<_Np>>(__n);
+        }
+    }
+};
+
+template <typename _Tp, size_t _Np>
+void swap(inplace_vector<_Tp, _Np>& __x, inplace_vector<_Tp, _Np>& __y) noexcept(noexcept(__x.swap(__y))) {
+    __x.swap(__y);
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_INPLACE_VECTOR_H
@@ -2,10 +2,12 @@
 #define _MYSTL_ITERATOR_H
 
 #include <config.h>
+#include <hardening.h>
 #include <iterator>
 #include <type_traits>
 #if _MYSTL_CXX_VERSION >= 20
 #    include <concepts>
+#    include <ranges>
 #endif
 
 _MYSTL_BEGIN_NAMESPACE_MYSTL
@@ -100,6 +102,10 @@ template <class Iter>
 concept ExactRandomAccessIterator = ExactIterator<Iter, random_access_iterator_tag>;
 template <class Iter>
 concept ExactContiguousIterator = std::same_as<typename std::iterator_traits<Iter>::iterator_concept, std::contiguous_iterator_tag>;
+
+// 容器的 *_range 系列函数接受的范围：元素可以转换为容器的 value_type
+template <class Range, class Tp>
+concept ContainerCompatibleRange = std::ranges::input_range<Range> && std::convertible_to<std::ranges::range_reference_t<Range>, Tp>;
 #endif
 //===----------------------------------===//
 
@@ -133,12 +139,17 @@ public:
 
     // operators
     // 解引用与 ->
-    [[nodiscard]] _MYSTL_CONSTEXPR_SINCE_CXX14 reference operator*() const noexcept { return *it; }
+    [[nodiscard]] _MYSTL_CONSTEXPR_SINCE_CXX14 reference operator*() const noexcept {
+        _MYSTL_ASSERT_DEBUG(it != iterator_type(), "wrap_iter: dereferencing a value-initialized iterator");
+        return *it;
+    }
 
 #if _MYSTL_CXX_VERSION >= 20
     _MYSTL_CONSTEXPR_SINCE_CXX14 pointer operator->() const noexcept
         requires(std::is_pointer_v<Iter> || requires(const Iter __i) { __i.operator->(); })
     {
+        // 不检查空指针：std::to_address 通过 operator-> 取得地址，空容器的 begin() 同样为空指针，
+        // 与值初始化的迭代器无法区分，std::to_address(v.begin()) 与 std::span(v.begin(), v.end()) 在空容器上是合法的
         if constexpr (std::is_pointer_v<Iter>) {
             return it;
         } else {
@@ -196,7 +207,10 @@ public:
     }
 
     // [] 运算符
-    _MYSTL_CONSTEXPR_SINCE_CXX14 reference operator[](difference_type __n) const noexcept { return it[__n]; }
+    _MYSTL_CONSTEXPR_SINCE_CXX14 reference operator[](difference_type __n) const noexcept {
+        _MYSTL_ASSERT_DEBUG(it != iterator_type(), "wrap_iter: subscripting a value-initialized iterator");
+        return it[__n];
+    }
 
     // base() 返回被包装前的迭代器
     _MYSTL_CONSTEXPR_SINCE_CXX14 iterator_type base() const noexcept { return it; }
@@ -211,6 +225,12 @@ private:
     friend class wrap_iter;
     template <typename _Tp, class _Allocator>
     friend class vector;
+    template <typename _Tp, size_t _Np, class _Allocator>
+    friend class small_vector;
+    template <typename _Tp, size_t _Np>
+    friend class inplace_vector;
+    template <typename _Tp>
+    friend class mapped_vector;
 };
 
 // 迭代器之间的比较运算
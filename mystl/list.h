@@ -3,10 +3,10 @@
 
 #include <allocation_guard.h>
 #include <allocator.h>
-#include <cassert>
 #include <config.h>
 #include <cstddef>
 #include <functional>
+#include <hardening.h>
 #include <initializer_list>
 #include <iterator.h>
 #include <iterator>
@@ -324,9 +324,8 @@ protected:
     const_iterator end() const noexcept { return const_iterator(__end_as_link()); }
 
     void swap(__list_imp& __other) noexcept {
-        if (!alloc_traits::propagate_on_container_swap::value && !(this->__node_alloc_ == __other.__node_alloc_)) {
-            assert(false && "list::swap: allocators must compare equal when propagate_on_container_swap is false");
-        }
+        _MYSTL_ASSERT_DEBUG(alloc_traits::propagate_on_container_swap::value || this->__node_alloc_ == __other.__node_alloc_,
+                            "list::swap: allocators must compare equal when propagate_on_container_swap is false");
         std::swap(__node_alloc_, __other.__node_alloc_);
         std::swap(__size_, __other.__size_);
         std::swap(__end_, __other.__end_);
@@ -591,13 +590,25 @@ public:
 
     const_reverse_iterator crend() const noexcept { return const_reverse_iterator(begin()); }
 
-    reference front() { return __base::__end_.__next_->__as_node()->__get_value(); }
+    reference front() {
+        _MYSTL_ASSERT(!empty(), "list::front called on an empty list");
+        return __base::__end_.__next_->__as_node()->__get_value();
+    }
 
-    const_reference front() const { return __base::__end_.__next_->__as_node()->__get_value(); }
+    const_reference front() const {
+        _MYSTL_ASSERT(!empty(), "list::front called on an empty list");
+        return __base::__end_.__next_->__as_node()->__get_value();
+    }
 
-    reference back() { return __base::__end_.__prev_->__as_node()->__get_value(); }
+    reference back() {
+        _MYSTL_ASSERT(!empty(), "list::back called on an empty list");
+        return __base::__end_.__prev_->__as_node()->__get_value();
+    }
 
-    const_reference back() const { return __base::__end_.__prev_->__as_node()->__get_value(); }
+    const_reference back() const {
+        _MYSTL_ASSERT(!empty(), "list::back called on an empty list");
+        return __base::__end_.__prev_->__as_node()->__get_value();
+    }
 
     //
     // modifiers
@@ -715,6 +726,7 @@ public:
     void clear() noexcept { __base::clear(); }
 
     void pop_front() {
+        _MYSTL_ASSERT(!empty(), "list::pop_front called on an empty list");
         __base_pointer __n = __base::__end_.__next_;
         __base::__unlink_nodes(__n, __n);
         --__base::__size_;
@@ -722,6 +734,7 @@ public:
     }
 
     void pop_back() {
+        _MYSTL_ASSERT(!empty(), "list::pop_back called on an empty list");
         __base_pointer __n = __base::__end_.__prev_;
         __base::__unlink_nodes(__n, __n);
         --__base::__size_;
@@ -729,6 +742,7 @@ public:
     }
 
     iterator erase(const_iterator __p) {
+        _MYSTL_ASSERT(__p != end(), "list::erase(iterator) called with a non-dereferenceable iterator");
         __base_pointer __n = __p.__ptr_;
         __base_pointer __r = __n->__next_;
         __base::__unlink_nodes(__n, __n);
@@ -815,6 +829,7 @@ public:
 
     // 将 __other 合并到 this 的 __p 指向的元素之前
     void splice(const_iterator __p, list& __other) {
+        _MYSTL_ASSERT_DEBUG(this != std::addressof(__other), "list::splice(iterator, list) called with *this");
         if (!__other.empty()) {
             __base_pointer __first = __other.__end_.__next_;
             __base_pointer __last  = __other.__end_.__prev_;
@@ -829,6 +844,7 @@ public:
 
     // 将 __i 指向的元素从 __other 移动到 this 的 __p 指向的元素之前
     void splice(const_iterator __p, list& __other, const_iterator __i) {
+        _MYSTL_ASSERT(__i != __other.end(), "list::splice(iterator, list, iterator) called with a non-dereferenceable iterator");
         // 需要判断 __p 是否与 __i 指向同一个元素或本就在 __i 指向的元素的下一个
         if (__p.__ptr_ != __i.__ptr_ && __p.__ptr_ != __i.__ptr_->__next_) {
             __base_pointer __r = __i.__ptr_;
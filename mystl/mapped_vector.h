@@ -0,0 +1,390 @@
+//===-------------------------------------===//
+//
+// mapped_vector.h
+// 以文件映射作为存储的 vector，只适用于平凡可拷贝的元素类型
+// 依赖 POSIX 的 mmap 与 Linux 的 mremap
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_MAPPED_VECTOR_H
+#define _MYSTL_MAPPED_VECTOR_H
+
+#include <algorithm>
+#include <cerrno>
+#include <config.h>
+#include <cstring>
+#include <fcntl.h>
+#include <hardening.h>
+#include <iterator.h>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stream_copy.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <throw.h>
+#include <type_traits>
+#include <unistd.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+enum class map_mode {
+    read_only,  // 映射已有文件，不复制数据，不可修改
+    read_write, // 文件不存在时创建，可以修改与增长
+};
+
+// 文件的内容即为元素的字节表示，文件长度为 size() * sizeof(_Tp)
+// read_only 模式下直接映射整个文件，打开的开销与文件大小无关，数据在首次访问时由内核按页载入
+// read_write 模式下映射的长度为 capacity() * sizeof(_Tp)，扩容时先 ftruncate 文件再 mremap 映射，
+// 已有的页不会被复制；close() 时将文件截断回 size() * sizeof(_Tp)
+// 修改只有在 flush() 或 close() 之后才保证写回文件
+// read_only 模式下映射为 PROT_READ，非 const 的 operator[]、at、front、back、data() 与迭代器返回的引用同样指向只读的页，
+// 通过它们写入会触发 SIGSEGV，只读打开时应通过 const 引用访问元素
+template <typename _Tp>
+class mapped_vector {
+public:
+    using value_type             = _Tp;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = size_t;
+    using difference_type        = ptrdiff_t;
+    using pointer                = value_type*;
+    using const_pointer          = const value_type*;
+    using iterator               = mystl::wrap_iter<pointer>;
+    using const_iterator         = mystl::wrap_iter<const_pointer>;
+    using reverse_iterator       = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_trivially_copyable_v<value_type>, "mapped_vector requires a trivially copyable value_type");
+
+private:
+    pointer __begin_ = nullptr;
+    size_type __size_ = 0;
+    size_type __cap_  = 0; // 映射的元素数量
+    int __fd_         = -1;
+    map_mode __mode_  = map_mode::read_only;
+    bool __open_      = false;
+
+public:
+    //
+    // construct/destroy
+    //
+    mapped_vector() noexcept = default;
+
+    explicit mapped_vector(const char* __path, map_mode __mode = map_mode::read_only) { open(__path, __mode); }
+
+    mapped_vector(const mapped_vector&)            = delete;
+    mapped_vector& operator=(const mapped_vector&) = delete;
+
+    mapped_vector(mapped_vector&& __other) noexcept { __steal(__other); }
+
+    mapped_vector& operator=(mapped_vector&& __other) noexcept {
+        if (this != std::addressof(__other)) {
+            __close_noexcept();
+            __steal(__other);
+        }
+        return *this;
+    }
+
+    // 析构时忽略 close 中的错误，需要处理错误时应显式调用 close()
+    ~mapped_vector() { __close_noexcept(); }
+
+    //
+    // 文件操作
+    //
+    void open(const char* __path, map_mode __mode = map_mode::read_only) {
+        if (__open_) { mystl::__throw_logic_error("mapped_vector: already open"); }
+        int __flags = __mode == map_mode::read_only ? O_RDONLY : (O_RDWR | O_CREAT);
+        int __fd    = ::open(__path, __flags | O_CLOEXEC, 0644);
+        if (__fd < 0) { __throw_errno("mapped_vector: open"); }
+
+        struct stat __st;
+        if (::fstat(__fd, &__st) != 0) {
+            int __err = errno;
+            ::close(__fd);
+            __throw_errno("mapped_vector: fstat", __err);
+        }
+        size_type __bytes = static_cast<size_type>(__st.st_size);
+        if (__bytes % sizeof(value_type) != 0) {
+            ::close(__fd);
+            mystl::__throw_runtime_error("mapped_vector: file size is not a multiple of sizeof(value_type)");
+        }
+
+        pointer __p = nullptr;
+        if (__bytes != 0) {
+            int __prot  = __mode == map_mode::read_only ? PROT_READ : (PROT_READ | PROT_WRITE);
+            void* __ptr = ::mmap(nullptr, __bytes, __prot, MAP_SHARED, __fd, 0);
+            if (__ptr == MAP_FAILED) {
+                int __err = errno;
+                ::close(__fd);
+                __throw_errno("mapped_vector: mmap", __err);
+            }
+            __p = static_cast<pointer>(__ptr);
+        }
+
+        // 只读映射建立后不再需要文件描述符
+        if (__mode == map_mode::read_only) {
+            ::close(__fd);
+            __fd = -1;
+        }
+
+        __begin_ = __p;
+        __size_ = __cap_ = __bytes / sizeof(value_type);
+        __fd_            = __fd;
+        __mode_          = __mode;
+        __open_          = true;
+    }
+
+    // 解除映射并关闭文件，read_write 模式下先将文件截断为 size() 个元素
+    void close() {
+        if (!__open_) return;
+        int __err = 0;
+        if (__begin_ != nullptr && ::munmap(__begin_, __cap_ * sizeof(value_type)) != 0) { __err = errno; }
+        if (__fd_ >= 0) {
+            if (::ftruncate(__fd_, static_cast<off_t>(__size_ * sizeof(value_type))) != 0 && __err == 0) { __err = errno; }
+            if (::close(__fd_) != 0 && __err == 0) { __err = errno; }
+        }
+        __reset();
+        if (__err != 0) { __throw_errno("mapped_vector: close", __err); }
+    }
+
+    bool is_open() const noexcept { return __open_; }
+
+    map_mode mode() const noexcept { return __mode_; }
+
+    // 将修改写回文件，__async 为 true 时只发起写回而不等待完成
+    void flush(bool __async = false) {
+        if (__begin_ == nullptr || __mode_ == map_mode::read_only) return;
+        if (::msync(__begin_, __cap_ * sizeof(value_type), __async ? MS_ASYNC : MS_SYNC) != 0) { __throw_errno("mapped_vector: msync"); }
+    }
+
+    //
+    // iterators
+    //
+    iterator begin() noexcept { return iterator(__begin_); }
+
+    const_iterator begin() const noexcept { return const_iterator(__begin_); }
+
+    iterator end() noexcept { return iterator(__begin_ + __size_); }
+
+    const_iterator end() const noexcept { return const_iterator(__begin_ + __size_); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    //
+    // capacity
+    //
+    size_type size() const noexcept { return __size_; }
+
+    size_type capacity() const noexcept { return __cap_; }
+
+    [[nodiscard]] bool empty() const noexcept { return __size_ == 0; }
+
+    size_type max_size() const noexcept {
+        return std::min<size_type>(std::numeric_limits<off_t>::max() / sizeof(value_type), std::numeric_limits<difference_type>::max());
+    }
+
+    void reserve(size_type __n) {
+        if (__n > __cap_) {
+            if (__n > max_size()) { mystl::__throw_length_error("mapped_vector"); }
+            __remap(__n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (__size_ < __cap_) { __remap(__size_); }
+    }
+
+    //
+    // element access
+    //
+    // 非 const 的重载在 read_only 模式下只能用于读取，见类的说明
+    reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(__n < __size_, "mapped_vector::operator[]: index out of range");
+        return __begin_[__n];
+    }
+
+    const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(__n < __size_, "mapped_vector::operator[]: index out of range");
+        return __begin_[__n];
+    }
+
+    reference at(size_type __n) {
+        if (__n >= __size_) { mystl::__throw_out_of_range("mapped_vector"); }
+        return __begin_[__n];
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= __size_) { mystl::__throw_out_of_range("mapped_vector"); }
+        return __begin_[__n];
+    }
+
+    reference front() noexcept { return __begin_[0]; }
+
+    const_reference front() const noexcept { return __begin_[0]; }
+
+    reference back() noexcept { return __begin_[__size_ - 1]; }
+
+    const_reference back() const noexcept { return __begin_[__size_ - 1]; }
+
+    value_type* data() noexcept { return __begin_; }
+
+    const value_type* data() const noexcept { return __begin_; }
+
+    //
+    // modifiers，只能在 read_write 模式下使用
+    //
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        __assert_writable();
+        if (__size_ == __cap_) { __remap(__recommend(__size_ + 1)); }
+        value_type* __p = ::new (static_cast<void*>(__begin_ + __size_)) value_type(std::forward<_Args>(__args)...);
+        ++__size_;
+        return *__p;
+    }
+
+    void push_back(const value_type& __x) { emplace_back(__x); }
+
+    void pop_back() noexcept {
+        _MYSTL_ASSERT(__size_ > 0, "mapped_vector::pop_back: empty");
+        --__size_;
+    }
+
+    // 追加 [__first, __first + __n)，只重新映射一次，之后一次拷贝 (大块时为非临时写入)
+    void append(const value_type* __first, size_type __n) {
+        __assert_writable();
+        if (__n == 0) return;
+        if (__size_ + __n > __cap_) { __remap(__recommend(__size_ + __n)); }
+        mystl::__bulk_memcpy(static_cast<void*>(__begin_ + __size_), __first, __n * sizeof(value_type));
+        __size_ += __n;
+    }
+
+    void resize(size_type __n, const value_type& __x = value_type()) {
+        __assert_writable();
+        if (__n > __size_) {
+            if (__n > __cap_) { __remap(__recommend(__n)); }
+            std::uninitialized_fill(__begin_ + __size_, __begin_ + __n, __x);
+        }
+        __size_ = __n;
+    }
+
+    void clear() noexcept { __size_ = 0; }
+
+    void swap(mapped_vector& __other) noexcept {
+        std::swap(__begin_, __other.__begin_);
+        std::swap(__size_, __other.__size_);
+        std::swap(__cap_, __other.__cap_);
+        std::swap(__fd_, __other.__fd_);
+        std::swap(__mode_, __other.__mode_);
+        std::swap(__open_, __other.__open_);
+    }
+
+private:
+    [[noreturn]] static void __throw_errno(const char* __what, int __err = errno) {
+#if _MYSTL_HAS_EXCEPTIONS
+        throw std::system_error(__err, std::generic_category(), __what);
+#else
+        std::fprintf(stderr, "system_error: %s: %s\n", __what, std::strerror(__err));
+        std::abort();
+#endif
+    }
+
+    void __assert_writable() const noexcept {
+        _MYSTL_ASSERT_DEBUG(__open_ && __mode_ == map_mode::read_write, "mapped_vector: modification requires read_write mode");
+    }
+
+    // 一页能放下的元素数，映射与文件长度都以页为单位，更小的容量不会节省空间
+    static size_type __page_elems() noexcept {
+        long __page = ::sysconf(_SC_PAGESIZE);
+        if (__page <= 0) { __page = 4096; }
+        return std::max<size_type>(1, static_cast<size_type>(__page) / sizeof(value_type));
+    }
+
+    // 容量变化逻辑与 vector 相同，总体上将容量翻倍，但至少为一页，避免从空文件开始追加时每次都 ftruncate 与 mremap
+    size_type __recommend(size_type __new_size) const {
+        const size_type __ms = max_size();
+        if (__new_size > __ms) { mystl::__throw_length_error("mapped_vector"); }
+        if (__cap_ >= __ms / 2) { return __ms; }
+        return std::max<size_type>({2 * __cap_, __new_size, __page_elems()});
+    }
+
+    // 调整文件长度与映射长度为 __n 个元素
+    // 增长时先扩展文件再扩展映射，缩小时先缩小映射再截断文件，保证映射的范围始终在文件内
+    void __remap(size_type __n) {
+        __assert_writable();
+        size_type __old_bytes = __cap_ * sizeof(value_type);
+        size_type __new_bytes = __n * sizeof(value_type);
+        if (__new_bytes > __old_bytes && ::ftruncate(__fd_, static_cast<off_t>(__new_bytes)) != 0) { __throw_errno("mapped_vector: ftruncate"); }
+
+        void* __ptr = nullptr;
+        if (__new_bytes == 0) {
+            if (__begin_ != nullptr) { ::munmap(__begin_, __old_bytes); }
+        } else if (__begin_ == nullptr) {
+            __ptr = ::mmap(nullptr, __new_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, __fd_, 0);
+        } else {
+            __ptr = ::mremap(__begin_, __old_bytes, __new_bytes, MREMAP_MAYMOVE);
+        }
+        if (__ptr == MAP_FAILED) {
+            int __err = errno;
+            // 映射失败时恢复文件长度，容器保持原状
+            if (__new_bytes > __old_bytes) { (void)::ftruncate(__fd_, static_cast<off_t>(__old_bytes)); }
+            __throw_errno("mapped_vector: mremap", __err);
+        }
+
+        if (__new_bytes < __old_bytes && ::ftruncate(__fd_, static_cast<off_t>(__new_bytes)) != 0) {
+            int __err = errno;
+            __begin_  = static_cast<pointer>(__ptr);
+            __cap_    = __n;
+            __throw_errno("mapped_vector: ftruncate", __err);
+        }
+        __begin_ = static_cast<pointer>(__ptr);
+        __cap_   = __n;
+    }
+
+    void __steal(mapped_vector& __other) noexcept {
+        __begin_ = __other.__begin_;
+        __size_  = __other.__size_;
+        __cap_   = __other.__cap_;
+        __fd_    = __other.__fd_;
+        __mode_  = __other.__mode_;
+        __open_  = __other.__open_;
+        __other.__reset();
+    }
+
+    void __reset() noexcept {
+        __begin_ = nullptr;
+        __size_ = __cap_ = 0;
+        __fd_            = -1;
+        __open_          = false;
+    }
+
+    void __close_noexcept() noexcept {
+#if _MYSTL_HAS_EXCEPTIONS
+        try {
+#endif
+            close();
+#if _MYSTL_HAS_EXCEPTIONS
+        } catch (...) {}
+#endif
+    }
+};
+
+template <typename _Tp>
+void swap(mapped_vector<_Tp>& __x, mapped_vector<_Tp>& __y) noexcept {
+    __x.swap(__y);
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_MAPPED_VECTOR_H
@@ -0,0 +1,186 @@
+//===-------------------------------------===//
+//
+// parallel.h
+// 容器并行构造使用的线程池与分块执行
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_PARALLEL_H
+#define _MYSTL_PARALLEL_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <config.h>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 并行构造的选项，作为 vector 构造函数与 assign 的第一个参数传入
+// 需要构造的字节数小于 threshold_bytes 时退化为普通的串行构造
+// max_threads 为 0 时使用线程池的全部线程 (hardware_concurrency)
+struct parallel_policy {
+    size_t threshold_bytes = size_t(64) << 20;
+    unsigned max_threads   = 0;
+};
+
+inline constexpr parallel_policy par{};
+
+// 固定大小的线程池，线程在第一次使用时创建，程序结束时回收
+class __thread_pool {
+public:
+    static __thread_pool& __instance() {
+        static __thread_pool __pool(std::max(1u, std::thread::hardware_concurrency()) - 1);
+        return __pool;
+    }
+
+    // 不含调用者自身的工作线程数量
+    unsigned __workers() const noexcept { return static_cast<unsigned>(__threads_.size()); }
+
+    // 执行 __f(0), ..., __f(__k - 1)，当前线程执行 __f(0)，其余交给工作线程，全部完成后返回
+    // 下标 __i 固定放入第 (__i - 1) % __workers() 个工作线程的队列，同样的 __k 下同一下标总是由同一个线程执行，
+    // 调用者可以据此让同一块内存始终由同一个线程首次访问
+    // 在工作线程中嵌套调用时直接串行执行，避免所有工作线程互相等待
+    // Precondition: __f 不抛出异常
+    template <class _Fn>
+    void __run(unsigned __k, _Fn& __f) {
+        if (__k <= 1 || __in_worker() || __threads_.empty()) {
+            for (unsigned __i = 0; __i < __k; ++__i) { __f(__i); }
+            return;
+        }
+
+        struct _State {
+            std::mutex __m_;
+            std::condition_variable __cv_;
+            unsigned __pending_;
+        } __state;
+        __state.__pending_ = __k - 1;
+
+        {
+            std::lock_guard<std::mutex> __lock(__m_);
+            for (unsigned __i = 1; __i < __k; ++__i) {
+                __queues_[(__i - 1) % __queues_.size()].emplace_back([&__state, &__f, __i] {
+                    __f(__i);
+                    std::lock_guard<std::mutex> __l(__state.__m_);
+                    if (--__state.__pending_ == 0) { __state.__cv_.notify_one(); }
+                });
+            }
+        }
+        __cv_.notify_all();
+
+        __f(0);
+        std::unique_lock<std::mutex> __l(__state.__m_);
+        __state.__cv_.wait(__l, [&] { return __state.__pending_ == 0; });
+    }
+
+    __thread_pool(const __thread_pool&)            = delete;
+    __thread_pool& operator=(const __thread_pool&) = delete;
+
+    ~__thread_pool() {
+        {
+            std::lock_guard<std::mutex> __lock(__m_);
+            __stop_ = true;
+        }
+        __cv_.notify_all();
+        for (std::thread& __t : __threads_) { __t.join(); }
+    }
+
+private:
+    std::vector<std::thread> __threads_;
+    std::vector<std::deque<std::function<void()>>> __queues_; // __queues_[__w] 只由第 __w 个工作线程取出
+    std::mutex __m_;
+    std::condition_variable __cv_;
+    bool __stop_ = false;
+
+    explicit __thread_pool(unsigned __n) {
+        __queues_.resize(__n);
+        __threads_.reserve(__n);
+        for (unsigned __i = 0; __i < __n; ++__i) { __threads_.emplace_back([this, __i] { __loop(__i); }); }
+    }
+
+    static bool& __in_worker() noexcept {
+        thread_local bool __flag = false;
+        return __flag;
+    }
+
+    void __loop(unsigned __w) {
+        __in_worker() = true;
+        std::deque<std::function<void()>>& __tasks = __queues_[__w];
+        while (true) {
+            std::function<void()> __task;
+            {
+                std::unique_lock<std::mutex> __lock(__m_);
+                __cv_.wait(__lock, [&] { return __stop_ || !__tasks.empty(); });
+                if (__tasks.empty()) return;
+                __task = std::move(__tasks.front());
+                __tasks.pop_front();
+            }
+            __task();
+        }
+    }
+};
+
+// 计算 __n 个大小为 __elem_size 的元素分成的块数，为 1 时表示串行执行
+inline unsigned __parallel_chunk_count(const parallel_policy& __pol, size_t __n, size_t __elem_size) {
+    if (__n < 2 || __n * __elem_size < __pol.threshold_bytes) return 1;
+    unsigned __threads = __thread_pool::__instance().__workers() + 1;
+    if (__pol.max_threads != 0) { __threads = std::min(__threads, __pol.max_threads); }
+    return static_cast<unsigned>(std::min<size_t>(__threads, __n));
+}
+
+// 将 [0, __n) 分块并行执行 __fn(__lo, __hi)
+// 块的大小按页 (4 KiB) 取整，相邻的块尽量不共享页，每一页只由执行该块的线程首次访问，
+// 在 NUMA 系统上这些页会被分配到该线程首次访问时所在的节点
+// 块数只取决于 __n、__elem_size 与 __pol，对同样大小的区间重复调用时同一块总是由同一个线程执行 (见 __thread_pool::__run)
+// 若有块抛出异常，对其余已完成的块调用 __rollback(__lo, __hi)，然后重新抛出下标最小的块的异常
+template <class _Fn, class _Rollback>
+void __parallel_for_chunks(const parallel_policy& __pol, size_t __n, size_t __elem_size, _Fn __fn, _Rollback __rollback) {
+    unsigned __k = mystl::__parallel_chunk_count(__pol, __n, __elem_size);
+    if (__k <= 1) {
+        if (__n != 0) { __fn(size_t(0), __n); }
+        return;
+    }
+
+    const size_t __page_elems = std::max<size_t>(1, 4096 / __elem_size);
+    size_t __per              = (__n + __k - 1) / __k;
+    __per                     = (__per + __page_elems - 1) / __page_elems * __page_elems;
+    __k                       = static_cast<unsigned>((__n + __per - 1) / __per);
+
+#if _MYSTL_HAS_EXCEPTIONS
+    std::unique_ptr<std::exception_ptr[]> __errors(new std::exception_ptr[__k]);
+#endif
+    auto __task = [&](unsigned __i) {
+        size_t __lo = __i * __per;
+        size_t __hi = std::min(__n, __lo + __per);
+#if _MYSTL_HAS_EXCEPTIONS
+        try {
+            __fn(__lo, __hi);
+        } catch (...) { __errors[__i] = std::current_exception(); }
+#else
+        __fn(__lo, __hi);
+#endif
+    };
+    __thread_pool::__instance().__run(__k, __task);
+
+#if _MYSTL_HAS_EXCEPTIONS
+    std::exception_ptr __first_error;
+    for (unsigned __i = 0; __i < __k && !__first_error; ++__i) { __first_error = __errors[__i]; }
+    if (__first_error) {
+        for (unsigned __i = 0; __i < __k; ++__i) {
+            if (!__errors[__i]) { __rollback(__i * __per, std::min(__n, __i * __per + __per)); }
+        }
+        std::rethrow_exception(__first_error);
+    }
+#else
+    (void)__rollback;
+#endif
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_PARALLEL_H
@@ -0,0 +1,445 @@
+//===-------------------------------------===//
+//
+// segmented_vector.h
+// 由大小按 2 的幂增长的块组成的 vector，增长时不迁移元素，引用与指针始终有效
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_SEGMENTED_VECTOR_H
+#define _MYSTL_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <climits>
+#include <config.h>
+#include <exception_guard.h>
+#include <hardening.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <limits>
+#include <throw.h>
+#include <type_traits>
+#if _MYSTL_CXX_VERSION >= 20
+#    include <bit>
+#endif
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 最高位的 1 的位置，即 floor(log2(__x))
+// Precondition: __x != 0
+inline _MYSTL_CONSTEXPR_SINCE_CXX14 unsigned __log2(size_t __x) noexcept {
+#if _MYSTL_CXX_VERSION >= 20
+    return static_cast<unsigned>(std::bit_width(__x) - 1);
+#else
+    return static_cast<unsigned>(sizeof(unsigned long long) * CHAR_BIT - 1 - __builtin_clzll(static_cast<unsigned long long>(__x)));
+#endif
+}
+
+// 第 k 个块的大小为 __first_block << k，前 k 个块的总容量为 __first_block * (2^k - 1)
+// 下标 i 所在的块与块内偏移由 j = i + __first_block 的最高位确定：
+//     k = log2(j) - log2(__first_block), offset = j - 2^log2(j)
+// 块指针表的大小固定，块一旦分配就不再移动，因此 push_back 不会使任何引用、指针或迭代器失效
+// 只支持在尾部增删元素，中间插入与删除会移动元素，与引用稳定的目的相矛盾
+template <typename _Tp, class _Allocator = mystl::allocator<_Tp>>
+class segmented_vector {
+    template <bool _IsConst>
+    class __iterator;
+
+public:
+    using value_type             = _Tp;
+    using allocator_type         = _Allocator;
+    using alloc_traits           = std::allocator_traits<allocator_type>;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = typename alloc_traits::size_type;
+    using difference_type        = typename alloc_traits::difference_type;
+    using pointer                = typename alloc_traits::pointer;
+    using const_pointer          = typename alloc_traits::const_pointer;
+    using iterator               = __iterator<false>;
+    using const_iterator         = __iterator<true>;
+    using reverse_iterator       = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_same_v<typename allocator_type::value_type, value_type>, "Allocator::value_type must be same type as value_type");
+
+private:
+    // 第一个块约 256 字节，至少 1 个元素
+    static constexpr unsigned __first_shift = sizeof(value_type) >= 256 ? 0 : __log2(256 / sizeof(value_type));
+    static constexpr size_type __first_block = size_type(1) << __first_shift;
+    static constexpr unsigned __max_blocks   = sizeof(size_type) * CHAR_BIT - __first_shift;
+
+    pointer __blocks_[__max_blocks] = {};
+    size_type __size_               = 0;
+    unsigned __nblocks_             = 0; // 已分配的块数
+    allocator_type __alloc_;
+
+public:
+    //
+    // construct/copy/destroy
+    //
+    segmented_vector() noexcept(std::is_nothrow_default_constructible<allocator_type>::value) {}
+
+    explicit segmented_vector(const allocator_type& __a) noexcept : __alloc_(__a) {}
+
+    explicit segmented_vector(size_type __n, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        auto __guard = mystl::__make_exception_guard(__destroy_segmented_vector(*this));
+        resize(__n);
+        __guard.__complete();
+    }
+
+    segmented_vector(size_type __n, const_reference __x, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        auto __guard = mystl::__make_exception_guard(__destroy_segmented_vector(*this));
+        resize(__n, __x);
+        __guard.__complete();
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    segmented_vector(_InputIterator __first, _InputIterator __last, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        auto __guard = mystl::__make_exception_guard(__destroy_segmented_vector(*this));
+        __append(__first, __last);
+        __guard.__complete();
+    }
+
+    segmented_vector(std::initializer_list<value_type> __il, const allocator_type& __a = allocator_type())
+        : segmented_vector(__il.begin(), __il.end(), __a) {}
+
+    segmented_vector(const segmented_vector& __other) : __alloc_(alloc_traits::select_on_container_copy_construction(__other.__alloc_)) {
+        auto __guard = mystl::__make_exception_guard(__destroy_segmented_vector(*this));
+        __append(__other.begin(), __other.end());
+        __guard.__complete();
+    }
+
+    segmented_vector(segmented_vector&& __other) noexcept : __alloc_(std::move(__other.__alloc_)) { __steal(__other); }
+
+    ~segmented_vector() { __release(); }
+
+    segmented_vector& operator=(const segmented_vector& __other) {
+        if (this != std::addressof(__other)) {
+            clear();
+            __append(__other.begin(), __other.end());
+        }
+        return *this;
+    }
+
+    segmented_vector& operator=(segmented_vector&& __other) noexcept {
+        if (this != std::addressof(__other)) {
+            __release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) { __alloc_ = std::move(__other.__alloc_); }
+            __steal(__other);
+        }
+        return *this;
+    }
+
+    segmented_vector& operator=(std::initializer_list<value_type> __il) {
+        clear();
+        __append(__il.begin(), __il.end());
+        return *this;
+    }
+
+    allocator_type get_allocator() const noexcept { return __alloc_; }
+
+    //
+    // iterators
+    //
+    iterator begin() noexcept { return iterator(__blocks_, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(__blocks_, 0); }
+
+    iterator end() noexcept { return iterator(__blocks_, __size_); }
+
+    const_iterator end() const noexcept { return const_iterator(__blocks_, __size_); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    //
+    // capacity
+    //
+    size_type size() const noexcept { return __size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return __size_ == 0; }
+
+    size_type capacity() const noexcept { return __capacity_of(__nblocks_); }
+
+    size_type max_size() const noexcept {
+        return std::min<size_type>(alloc_traits::max_size(__alloc_), std::numeric_limits<difference_type>::max() - __first_block);
+    }
+
+    // 分配新的块直到容量不小于 __n，已有元素不移动
+    void reserve(size_type __n) {
+        if (__n > max_size()) { mystl::__throw_length_error("segmented_vector"); }
+        while (capacity() < __n) { __add_block(); }
+    }
+
+    // 释放末尾完全空闲的块
+    void shrink_to_fit() noexcept {
+        while (__nblocks_ > 0 && __capacity_of(__nblocks_ - 1) >= __size_) {
+            --__nblocks_;
+            alloc_traits::deallocate(__alloc_, __blocks_[__nblocks_], __block_size(__nblocks_));
+            __blocks_[__nblocks_] = nullptr;
+        }
+    }
+
+    //
+    // element access
+    //
+    reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(__n < __size_, "segmented_vector::operator[]: index out of range");
+        return *__locate(__blocks_, __n);
+    }
+
+    const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(__n < __size_, "segmented_vector::operator[]: index out of range");
+        return *__locate(__blocks_, __n);
+    }
+
+    reference at(size_type __n) {
+        if (__n >= __size_) { mystl::__throw_out_of_range("segmented_vector"); }
+        return *__locate(__blocks_, __n);
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= __size_) { mystl::__throw_out_of_range("segmented_vector"); }
+        return *__locate(__blocks_, __n);
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    reference back() noexcept { return (*this)[__size_ - 1]; }
+
+    const_reference back() const noexcept { return (*this)[__size_ - 1]; }
+
+    //
+    // modifiers
+    //
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        if (__size_ == capacity()) { __add_block(); }
+        pointer __p = __locate(__blocks_, __size_);
+        alloc_traits::construct(__alloc_, std::addressof(*__p), std::forward<_Args>(__args)...);
+        ++__size_;
+        return *__p;
+    }
+
+    void push_back(const value_type& __x) { emplace_back(__x); }
+
+    void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    void pop_back() noexcept {
+        _MYSTL_ASSERT(__size_ > 0, "segmented_vector::pop_back: empty");
+        --__size_;
+        alloc_traits::destroy(__alloc_, std::addressof(*__locate(__blocks_, __size_)));
+    }
+
+    void resize(size_type __n) {
+        while (__size_ > __n) { pop_back(); }
+        reserve(__n);
+        while (__size_ < __n) { emplace_back(); }
+    }
+
+    void resize(size_type __n, const value_type& __x) {
+        while (__size_ > __n) { pop_back(); }
+        reserve(__n);
+        while (__size_ < __n) { emplace_back(__x); }
+    }
+
+    // 析构所有元素，保留已分配的块
+    void clear() noexcept {
+        while (__size_ > 0) { pop_back(); }
+    }
+
+    void swap(segmented_vector& __other) noexcept {
+        std::swap_ranges(__blocks_, __blocks_ + __max_blocks, __other.__blocks_);
+        std::swap(__size_, __other.__size_);
+        std::swap(__nblocks_, __other.__nblocks_);
+        if constexpr (alloc_traits::propagate_on_container_swap::value) { std::swap(__alloc_, __other.__alloc_); }
+    }
+
+    // 依次对每个块中的连续元素调用 __f(pointer first, pointer last)，比逐个迭代少一次下标换算
+    template <class _Fn>
+    void for_each_segment(_Fn __f) {
+        size_type __left = __size_;
+        for (unsigned __k = 0; __left > 0; ++__k) {
+            size_type __n = std::min(__left, __block_size(__k));
+            __f(__blocks_[__k], __blocks_[__k] + __n);
+            __left -= __n;
+        }
+    }
+
+    template <class _Fn>
+    void for_each_segment(_Fn __f) const {
+        size_type __left = __size_;
+        for (unsigned __k = 0; __left > 0; ++__k) {
+            size_type __n = std::min(__left, __block_size(__k));
+            __f(const_pointer(__blocks_[__k]), const_pointer(__blocks_[__k] + __n));
+            __left -= __n;
+        }
+    }
+
+private:
+    class __destroy_segmented_vector {
+    public:
+        __destroy_segmented_vector(segmented_vector& __vec) : __vec_(__vec) {}
+
+        void operator()() { __vec_.__release(); }
+
+    private:
+        segmented_vector& __vec_;
+    };
+
+    static constexpr size_type __block_size(unsigned __k) noexcept { return __first_block << __k; }
+
+    static constexpr size_type __capacity_of(unsigned __nblocks) noexcept { return __first_block * ((size_type(1) << __nblocks) - 1); }
+
+    // 下标 __i 对应的元素地址，只使用一次最高位计算与一次移位
+    static pointer __locate(const pointer* __blocks, size_type __i) noexcept {
+        size_type __j = __i + __first_block;
+        unsigned __hi = mystl::__log2(__j);
+        return __blocks[__hi - __first_shift] + (__j - (size_type(1) << __hi));
+    }
+
+    void __add_block() {
+        if (__nblocks_ == __max_blocks || __capacity_of(__nblocks_) >= max_size()) { mystl::__throw_length_error("segmented_vector"); }
+        __blocks_[__nblocks_] = alloc_traits::allocate(__alloc_, __block_size(__nblocks_));
+        ++__nblocks_;
+    }
+
+    template <class _Iter, class _Sent>
+    void __append(_Iter __first, _Sent __last) {
+        if constexpr (mystl::is_based_on_forward_iterator<_Iter>::value) { reserve(__size_ + static_cast<size_type>(std::distance(__first, __last))); }
+        for (; __first != __last; ++__first) { emplace_back(*__first); }
+    }
+
+    void __release() noexcept {
+        clear();
+        for (unsigned __k = 0; __k < __nblocks_; ++__k) {
+            alloc_traits::deallocate(__alloc_, __blocks_[__k], __block_size(__k));
+            __blocks_[__k] = nullptr;
+        }
+        __nblocks_ = 0;
+    }
+
+    void __steal(segmented_vector& __other) noexcept {
+        std::copy(__other.__blocks_, __other.__blocks_ + __max_blocks, __blocks_);
+        std::fill(__other.__blocks_, __other.__blocks_ + __max_blocks, nullptr);
+        __size_            = __other.__size_;
+        __nblocks_         = __other.__nblocks_;
+        __other.__size_    = 0;
+        __other.__nblocks_ = 0;
+    }
+
+    // 随机访问迭代器，保存块指针表与下标，解引用时换算地址
+    // 块指针表位于容器内部，移动或交换容器后迭代器失效；push_back 不会使迭代器失效
+    template <bool _IsConst>
+    class __iterator {
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = _Tp;
+        using difference_type   = typename segmented_vector::difference_type;
+        using pointer           = std::conditional_t<_IsConst, typename segmented_vector::const_pointer, typename segmented_vector::pointer>;
+        using reference         = std::conditional_t<_IsConst, const value_type&, value_type&>;
+
+        __iterator() noexcept : __blocks_(nullptr), __i_(0) {}
+
+        template <bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+        __iterator(const __iterator<_OtherConst>& __it) noexcept : __blocks_(__it.__blocks_), __i_(__it.__i_) {}
+
+        reference operator*() const noexcept { return *segmented_vector::__locate(__blocks_, __i_); }
+
+        pointer operator->() const noexcept { return segmented_vector::__locate(__blocks_, __i_); }
+
+        reference operator[](difference_type __n) const noexcept { return *segmented_vector::__locate(__blocks_, __i_ + __n); }
+
+        __iterator& operator++() noexcept {
+            ++__i_;
+            return *this;
+        }
+
+        __iterator operator++(int) noexcept {
+            __iterator __tmp(*this);
+            ++__i_;
+            return __tmp;
+        }
+
+        __iterator& operator--() noexcept {
+            --__i_;
+            return *this;
+        }
+
+        __iterator operator--(int) noexcept {
+            __iterator __tmp(*this);
+            --__i_;
+            return __tmp;
+        }
+
+        __iterator& operator+=(difference_type __n) noexcept {
+            __i_ += __n;
+            return *this;
+        }
+
+        __iterator& operator-=(difference_type __n) noexcept {
+            __i_ -= __n;
+            return *this;
+        }
+
+        friend __iterator operator+(__iterator __it, difference_type __n) noexcept { return __it += __n; }
+
+        friend __iterator operator+(difference_type __n, __iterator __it) noexcept { return __it += __n; }
+
+        friend __iterator operator-(__iterator __it, difference_type __n) noexcept { return __it -= __n; }
+
+        friend difference_type operator-(const __iterator& __x, const __iterator& __y) noexcept {
+            return static_cast<difference_type>(__x.__i_) - static_cast<difference_type>(__y.__i_);
+        }
+
+        friend bool operator==(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ == __y.__i_; }
+
+        friend bool operator!=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ != __y.__i_; }
+
+        friend bool operator<(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ < __y.__i_; }
+
+        friend bool operator>(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ > __y.__i_; }
+
+        friend bool operator<=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ <= __y.__i_; }
+
+        friend bool operator>=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ >= __y.__i_; }
+
+    private:
+        template <bool>
+        friend class __iterator;
+        friend class segmented_vector;
+
+        const typename segmented_vector::pointer* __blocks_;
+        size_type __i_;
+
+        __iterator(const typename segmented_vector::pointer* __blocks, size_type __i) noexcept : __blocks_(__blocks), __i_(__i) {}
+    };
+};
+
+template <typename _Tp, class _Allocator>
+void swap(segmented_vector<_Tp, _Allocator>& __x, segmented_vector<_Tp, _Allocator>& __y) noexcept {
+    __x.swap(__y);
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_SEGMENTED_VECTOR_H
@@ -0,0 +1,242 @@
+//===-------------------------------------===//
+//
+// serialize.h
+// vector 与 list 的二进制快照，save 写入 std::ostream，load 从 std::istream 读回
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_SERIALIZE_H
+#define _MYSTL_SERIALIZE_H
+
+#include <algorithm>
+#include <config.h>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <list.h>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <stdexcept>
+#include <throw.h>
+#include <type_traits>
+#include <vector.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 快照格式的版本，格式改变时递增，load 拒绝读取不同版本的快照
+inline constexpr uint32_t snapshot_version = 1;
+
+class snapshot_error : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+[[noreturn]] inline void __throw_snapshot_error(const char* __msg) {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw snapshot_error(__msg);
+#else
+    mystl::__abort_without_exceptions("snapshot_error", __msg);
+#endif
+}
+
+// 元素的编解码方式，用户可以为自己的类型特化 codec<T>，提供
+//     static void encode(std::ostream&, const T&);
+//     static T decode(std::istream&);
+// 平凡可拷贝的类型默认按字节整体读写 (is_bitwise)，连续存储的容器只需要一次 write/read
+template <class _Tp, class = void>
+struct codec;
+
+template <class _Tp>
+struct codec<_Tp, std::enable_if_t<std::is_trivially_copyable_v<_Tp>>> {
+    static constexpr bool is_bitwise = true;
+
+    static void encode(std::ostream& __os, const _Tp& __x) { __os.write(reinterpret_cast<const char*>(std::addressof(__x)), sizeof(_Tp)); }
+
+    static _Tp decode(std::istream& __is) {
+        _Tp __x;
+        __is.read(reinterpret_cast<char*>(std::addressof(__x)), sizeof(_Tp));
+        return __x;
+    }
+};
+
+template <class _Codec, class = void>
+struct __is_bitwise_codec : std::false_type {};
+
+template <class _Codec>
+struct __is_bitwise_codec<_Codec, std::enable_if_t<_Codec::is_bitwise>> : std::true_type {};
+
+// 快照头，按主机字节序写入，__byte_order 用于拒绝字节序不同的快照
+// __elem_size 为按字节读写时的元素大小，自定义 codec 时为 0
+struct __snapshot_header {
+    char __magic_[4]       = {'M', 'S', 'T', 'L'};
+    uint32_t __version_    = snapshot_version;
+    uint32_t __byte_order_ = 0x01020304;
+    uint32_t __elem_size_  = 0;
+    uint64_t __count_      = 0;
+};
+
+static_assert(std::is_trivially_copyable_v<__snapshot_header> && sizeof(__snapshot_header) == 24);
+
+inline void __write_header(std::ostream& __os, uint32_t __elem_size, uint64_t __count) {
+    __snapshot_header __h;
+    __h.__elem_size_ = __elem_size;
+    __h.__count_     = __count;
+    __os.write(reinterpret_cast<const char*>(&__h), sizeof(__h));
+}
+
+inline uint64_t __read_header(std::istream& __is, uint32_t __elem_size) {
+    __snapshot_header __expected, __h;
+    if (!__is.read(reinterpret_cast<char*>(&__h), sizeof(__h))) { mystl::__throw_snapshot_error("snapshot: truncated header"); }
+    if (std::memcmp(__h.__magic_, __expected.__magic_, sizeof(__h.__magic_)) != 0) { mystl::__throw_snapshot_error("snapshot: bad magic"); }
+    if (__h.__version_ != snapshot_version) { mystl::__throw_snapshot_error("snapshot: unsupported version"); }
+    if (__h.__byte_order_ != __expected.__byte_order_) { mystl::__throw_snapshot_error("snapshot: byte order mismatch"); }
+    if (__h.__elem_size_ != __elem_size) { mystl::__throw_snapshot_error("snapshot: element type mismatch"); }
+    return __h.__count_;
+}
+
+template <class _Tp>
+inline constexpr uint32_t __codec_elem_size = __is_bitwise_codec<codec<_Tp>>::value ? sizeof(_Tp) : 0;
+
+// list 按块读写时每块的字节数
+inline constexpr size_t __snapshot_chunk_bytes = 16 * 1024;
+
+// 流中从当前位置到末尾的字节数，流不支持定位时返回 UINT64_MAX
+inline uint64_t __remaining_bytes(std::istream& __is) {
+    const std::istream::pos_type __cur = __is.tellg();
+    if (__cur == std::istream::pos_type(-1)) return UINT64_MAX;
+    __is.seekg(0, std::ios::end);
+    const std::istream::pos_type __end = __is.tellg();
+    __is.clear();
+    __is.seekg(__cur);
+    if (__end == std::istream::pos_type(-1) || __end < __cur) return UINT64_MAX;
+    return static_cast<uint64_t>(__end - __cur);
+}
+
+// 访问 vector 的未初始化容量
+struct __serialize_access {
+    template <class _Tp, class _Allocator>
+    static _Tp* __end(vector<_Tp, _Allocator>& __v) noexcept {
+        return std::addressof(*__v.__end_);
+    }
+
+    template <class _Tp, class _Allocator>
+    static void __commit(vector<_Tp, _Allocator>& __v, size_t __n) noexcept {
+        __v.__end_ += __n;
+    }
+};
+
+//
+// vector
+//
+template <class _Tp, class _Allocator>
+void save(std::ostream& __os, const vector<_Tp, _Allocator>& __v) {
+    static_assert(!std::is_same_v<_Tp, bool>, "vector<bool> snapshots are not supported");
+    using _Codec = codec<_Tp>;
+    __write_header(__os, __codec_elem_size<_Tp>, __v.size());
+    if constexpr (__is_bitwise_codec<_Codec>::value) {
+        // 连续存储，一次写入
+        if (!__v.empty()) { __os.write(reinterpret_cast<const char*>(__v.data()), static_cast<std::streamsize>(__v.size() * sizeof(_Tp))); }
+    } else {
+        for (const _Tp& __x : __v) { _Codec::encode(__os, __x); }
+    }
+    if (!__os) { mystl::__throw_snapshot_error("snapshot: write failed"); }
+}
+
+// 替换 __v 的内容，失败时抛出 snapshot_error，__v 的内容为读取成功的前缀
+template <class _Tp, class _Allocator>
+void load(std::istream& __is, vector<_Tp, _Allocator>& __v) {
+    static_assert(!std::is_same_v<_Tp, bool>, "vector<bool> snapshots are not supported");
+    using _Codec = codec<_Tp>;
+    uint64_t __n = __read_header(__is, __codec_elem_size<_Tp>);
+    __v.clear();
+    if (__n > __v.max_size()) { mystl::__throw_snapshot_error("snapshot: element count too large"); }
+    // 快照头中的元素数不可信，预留的容量不超过流中实际剩余的数据量，流不支持定位时从一块开始按倍数增长，
+    // 损坏或伪造的快照不会一次分配过多的内存，而是在读到末尾时报告截断
+    constexpr size_t __chunk = __snapshot_chunk_bytes / sizeof(_Tp) > 0 ? __snapshot_chunk_bytes / sizeof(_Tp) : 1;
+    const uint64_t __avail   = __remaining_bytes(__is);
+    const uint64_t __limit   = __avail == UINT64_MAX ? __chunk : __avail / (__codec_elem_size<_Tp> != 0 ? __codec_elem_size<_Tp> : 1);
+    __v.reserve(static_cast<size_t>(std::min(__n, __limit)));
+    if constexpr (__is_bitwise_codec<_Codec>::value) {
+        // 直接读入未初始化的容量，读取完成后再提交
+        // 快照完整且流可以定位时，容量在循环之前已经足够，只需要一次 read
+        const size_t __total = static_cast<size_t>(__n);
+        while (__v.size() < __total) {
+            if (__v.size() == __v.capacity()) {
+                // 流可以定位时预留的容量已经覆盖了剩余的全部数据
+                if (__avail != UINT64_MAX) { mystl::__throw_snapshot_error("snapshot: truncated data"); }
+                __v.reserve(std::min(__total, std::max(2 * __v.capacity(), __chunk)));
+            }
+            size_t __k              = std::min(__total, __v.capacity()) - __v.size();
+            char* __p               = reinterpret_cast<char*>(__serialize_access::__end(__v));
+            std::streamsize __bytes = static_cast<std::streamsize>(__k * sizeof(_Tp));
+            __is.read(__p, __bytes);
+            __serialize_access::__commit(__v, static_cast<size_t>(__is.gcount()) / sizeof(_Tp));
+            if (__is.gcount() != __bytes) { mystl::__throw_snapshot_error("snapshot: truncated data"); }
+        }
+    } else {
+        // 预留的容量可能小于 __n (流不能定位，或编码后的元素小于一个字节的估计)，与上面一样随读到的数据按倍数增长
+        const size_t __total = static_cast<size_t>(__n);
+        while (__v.size() < __total) {
+            _Tp __x = _Codec::decode(__is);
+            if (!__is) { mystl::__throw_snapshot_error("snapshot: truncated data"); }
+            if (__v.size() == __v.capacity()) { __v.reserve(std::min(__total, std::max(2 * __v.capacity(), __chunk))); }
+            __v.push_back_unchecked(std::move(__x));
+        }
+    }
+}
+
+//
+// list
+//
+template <class _Tp, class _Allocator>
+void save(std::ostream& __os, const list<_Tp, _Allocator>& __l) {
+    using _Codec = codec<_Tp>;
+    __write_header(__os, __codec_elem_size<_Tp>, __l.size());
+    if constexpr (__is_bitwise_codec<_Codec>::value) {
+        // 节点不连续，先拷贝到固定大小的块中再整块写入
+        constexpr size_t __chunk = __snapshot_chunk_bytes / sizeof(_Tp) > 0 ? __snapshot_chunk_bytes / sizeof(_Tp) : 1;
+        alignas(_Tp) char __buf[__chunk * sizeof(_Tp)];
+        size_t __k = 0;
+        for (const _Tp& __x : __l) {
+            std::memcpy(__buf + __k * sizeof(_Tp), std::addressof(__x), sizeof(_Tp));
+            if (++__k == __chunk) {
+                __os.write(__buf, static_cast<std::streamsize>(__k * sizeof(_Tp)));
+                __k = 0;
+            }
+        }
+        if (__k != 0) { __os.write(__buf, static_cast<std::streamsize>(__k * sizeof(_Tp))); }
+    } else {
+        for (const _Tp& __x : __l) { _Codec::encode(__os, __x); }
+    }
+    if (!__os) { mystl::__throw_snapshot_error("snapshot: write failed"); }
+}
+
+template <class _Tp, class _Allocator>
+void load(std::istream& __is, list<_Tp, _Allocator>& __l) {
+    using _Codec = codec<_Tp>;
+    uint64_t __n = __read_header(__is, __codec_elem_size<_Tp>);
+    __l.clear();
+    if constexpr (__is_bitwise_codec<_Codec>::value) {
+        constexpr size_t __chunk = __snapshot_chunk_bytes / sizeof(_Tp) > 0 ? __snapshot_chunk_bytes / sizeof(_Tp) : 1;
+        alignas(_Tp) char __buf[__chunk * sizeof(_Tp)];
+        while (__n > 0) {
+            size_t __k              = __n < __chunk ? static_cast<size_t>(__n) : __chunk;
+            std::streamsize __bytes = static_cast<std::streamsize>(__k * sizeof(_Tp));
+            if (!__is.read(__buf, __bytes)) { mystl::__throw_snapshot_error("snapshot: truncated data"); }
+            // 平凡可拷贝的类型可以直接从读入的字节中使用
+            for (size_t __i = 0; __i < __k; ++__i) { __l.push_back(*std::launder(reinterpret_cast<const _Tp*>(__buf + __i * sizeof(_Tp)))); }
+            __n -= __k;
+        }
+    } else {
+        for (; __n > 0; --__n) {
+            _Tp __x = _Codec::decode(__is);
+            if (!__is) { mystl::__throw_snapshot_error("snapshot: truncated data"); }
+            __l.push_back(std::move(__x));
+        }
+    }
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_SERIALIZE_H
@@ -0,0 +1,583 @@
+//===-------------------------------------===//
+//
+// small_vector.h
+// 带有内联存储的 vector，元素数量不超过 _Np 时不进行堆分配
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_SMALL_VECTOR_H
+#define _MYSTL_SMALL_VECTOR_H
+
+#include <algorithm>
+#include <allocation_guard.h>
+#include <allocator.h>
+#include <config.h>
+#include <exception_guard.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <limits>
+#include <temp_value.h>
+#include <throw.h>
+#include <uninitialized_algorithms.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 与 vector 相同，使用 __begin_, __end_, __cap_ 三个指针管理元素
+// 区别在于初始时三个指针指向对象内部的 __buffer_，超出 _Np 个元素时才迁移到堆上
+// 迁移使用 __uninitialized_allocator_relocate，对平凡类型为一次 memcpy
+template <typename _Tp, size_t _Np, class _Allocator = mystl::allocator<_Tp>>
+class small_vector {
+public:
+    using value_type             = _Tp;
+    using allocator_type         = _Allocator;
+    using alloc_traits           = std::allocator_traits<allocator_type>;
+    using reference              = value_type&;
+    using const_reference        = const value_type&;
+    using size_type              = typename alloc_traits::size_type;
+    using difference_type        = typename alloc_traits::difference_type;
+    using pointer                = typename alloc_traits::pointer;
+    using const_pointer          = typename alloc_traits::const_pointer;
+    using iterator               = mystl::wrap_iter<pointer>;
+    using const_iterator         = mystl::wrap_iter<const_pointer>;
+    using reverse_iterator       = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_same_v<typename allocator_type::value_type, value_type>, "Allocator::value_type must be same type as value_type");
+    static_assert(std::is_same_v<pointer, value_type*>, "small_vector requires an allocator with raw pointers");
+    static_assert(_Np > 0, "small_vector requires a non-zero inline capacity");
+
+    static constexpr size_type inline_capacity = _Np;
+
+private:
+    pointer __begin_;
+    pointer __end_;
+    pointer __cap_;
+    allocator_type __alloc_;
+    alignas(value_type) unsigned char __buffer_[sizeof(value_type) * _Np];
+
+public:
+    //
+    // construct/copy/destroy
+    //
+    small_vector() noexcept(std::is_nothrow_default_constructible<allocator_type>::value) { __reset_to_inline(); }
+
+    explicit small_vector(const allocator_type& __a) noexcept : __alloc_(__a) { __reset_to_inline(); }
+
+    explicit small_vector(size_type __n, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        __reset_to_inline();
+        auto __guard = mystl::__make_exception_guard(__destroy_small_vector(*this));
+        __reserve_empty(__n);
+        __construct_at_end(__n);
+        __guard.__complete();
+    }
+
+    small_vector(size_type __n, const_reference __x, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        __reset_to_inline();
+        auto __guard = mystl::__make_exception_guard(__destroy_small_vector(*this));
+        __reserve_empty(__n);
+        __construct_at_end(__n, __x);
+        __guard.__complete();
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    small_vector(_InputIterator __first, _InputIterator __last, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        __reset_to_inline();
+        auto __guard = mystl::__make_exception_guard(__destroy_small_vector(*this));
+        __append(__first, __last);
+        __guard.__complete();
+    }
+
+    small_vector(std::initializer_list<value_type> __il, const allocator_type& __a = allocator_type())
+        : small_vector(__il.begin(), __il.end(), __a) {}
+
+    small_vector(const small_vector& __other) : __alloc_(alloc_traits::select_on_container_copy_construction(__other.__alloc_)) {
+        __reset_to_inline();
+        auto __guard = mystl::__make_exception_guard(__destroy_small_vector(*this));
+        __reserve_empty(__other.size());
+        __construct_at_end(__other.__begin_, __other.__end_, __other.size());
+        __guard.__complete();
+    }
+
+    // 分配器随之移动，堆上的元素总是直接接管，只有内联的元素需要逐个移动
+    small_vector(small_vector&& __other) noexcept(std::is_nothrow_move_constructible_v<value_type>) : __alloc_(std::move(__other.__alloc_)) {
+        __reset_to_inline();
+        __steal(__other, true);
+    }
+
+    ~small_vector() { __destroy_small_vector (*this)(); }
+
+    small_vector& operator=(const small_vector& __other) {
+        if (this != std::addressof(__other)) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (__alloc_ != __other.__alloc_) { __release(); }
+                __alloc_ = __other.__alloc_;
+            }
+            assign(__other.begin(), __other.end());
+        }
+        return *this;
+    }
+
+    // 分配器不传播且不相等时需要在自己的分配器上重新分配，可能抛出异常
+    small_vector& operator=(small_vector&& __other) noexcept(
+        std::is_nothrow_move_constructible_v<value_type> &&
+        ((alloc_traits::propagate_on_container_move_assignment::value && std::is_nothrow_move_assignable_v<allocator_type>) ||
+         alloc_traits::is_always_equal::value)) {
+        if (this != std::addressof(__other)) {
+            __release();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) { __alloc_ = std::move(__other.__alloc_); }
+            __steal(__other, alloc_traits::propagate_on_container_move_assignment::value || __alloc_ == __other.__alloc_);
+        }
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<value_type> __il) {
+        assign(__il.begin(), __il.end());
+        return *this;
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    void assign(_InputIterator __first, _InputIterator __last) {
+        clear();
+        __append(__first, __last);
+    }
+
+    void assign(size_type __n, const_reference __x) {
+        if (__n <= capacity()) {
+            size_type __old_size = size();
+            std::fill_n(__begin_, std::min(__n, __old_size), __x);
+            if (__n <= __old_size) {
+                __base_destruct_at_end(__begin_ + __n);
+            } else {
+                __construct_at_end(__n - __old_size, __x);
+            }
+        } else {
+            __release();
+            __reserve_empty(__n);
+            __construct_at_end(__n, __x);
+        }
+    }
+
+    void assign(std::initializer_list<value_type> __il) { assign(__il.begin(), __il.end()); }
+
+    allocator_type get_allocator() const noexcept { return __alloc_; }
+
+    //
+    // Iterators
+    //
+    iterator begin() noexcept { return iterator(__begin_); }
+
+    const_iterator begin() const noexcept { return const_iterator(__begin_); }
+
+    iterator end() noexcept { return iterator(__end_); }
+
+    const_iterator end() const noexcept { return const_iterator(__end_); }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //
+    // capacity
+    //
+    size_type size() const noexcept { return static_cast<size_type>(__end_ - __begin_); }
+
+    size_type capacity() const noexcept { return static_cast<size_type>(__cap_ - __begin_); }
+
+    [[nodiscard]] bool empty() const noexcept { return __begin_ == __end_; }
+
+    size_type max_size() const noexcept {
+        return std::min<size_type>(alloc_traits::max_size(__alloc_), std::numeric_limits<difference_type>::max());
+    }
+
+    // 元素是否存放在内联存储中
+    bool is_inline() const noexcept { return __begin_ == __inline_begin(); }
+
+    void reserve(size_type __n) {
+        if (__n > capacity()) {
+            if (__n > max_size()) { mystl::__throw_length_error("small_vector"); }
+            __reallocate_with_gap(__n, size(), 0, [](pointer) {});
+        }
+    }
+
+    // 元素数量能够放入内联存储时迁回内联存储
+    void shrink_to_fit() noexcept {
+        if (is_inline() || capacity() == size()) return;
+#if _MYSTL_HAS_EXCEPTIONS
+        try {
+#endif
+            if (size() <= _Np) {
+                pointer __old_begin = __begin_;
+                size_type __old_cap = capacity();
+                size_type __n       = size();
+                __uninitialized_allocator_relocate(__alloc_, __begin_, __end_, __inline_begin());
+                alloc_traits::deallocate(__alloc_, __old_begin, __old_cap);
+                __begin_ = __inline_begin();
+                __end_   = __begin_ + __n;
+                __cap_   = __begin_ + _Np;
+            } else {
+                __reallocate_with_gap(size(), size(), 0, [](pointer) {});
+            }
+#if _MYSTL_HAS_EXCEPTIONS
+        } catch (...) {}
+#endif
+    }
+
+    //
+    // element access
+    //
+    reference operator[](size_type __n) noexcept { return __begin_[__n]; }
+
+    const_reference operator[](size_type __n) const noexcept { return __begin_[__n]; }
+
+    reference at(size_type __n) {
+        if (__n >= size()) { mystl::__throw_out_of_range("small_vector"); }
+        return __begin_[__n];
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= size()) { mystl::__throw_out_of_range("small_vector"); }
+        return __begin_[__n];
+    }
+
+    reference front() noexcept { return *__begin_; }
+
+    const_reference front() const noexcept { return *__begin_; }
+
+    reference back() noexcept { return *(__end_ - 1); }
+
+    const_reference back() const noexcept { return *(__end_ - 1); }
+
+    value_type* data() noexcept { return __begin_; }
+
+    const value_type* data() const noexcept { return __begin_; }
+
+    //
+    // modifiers
+    //
+    void push_back(const_reference __x) { emplace_back(__x); }
+
+    void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        if (__end_ < __cap_) {
+            __construct_one_at_end(std::forward<_Args>(__args)...);
+        } else {
+            __emplace_back_slow_path(std::forward<_Args>(__args)...);
+        }
+        return *(__end_ - 1);
+    }
+
+    void pop_back() { __base_destruct_at_end(__end_ - 1); }
+
+    iterator insert(const_iterator __position, const_reference __x) { return emplace(__position, __x); }
+
+    iterator insert(const_iterator __position, value_type&& __x) { return emplace(__position, std::move(__x)); }
+
+    iterator insert(const_iterator __position, size_type __n, const_reference __x) {
+        difference_type __offset = __position - cbegin();
+        if (__n > static_cast<size_type>(__cap_ - __end_)) {
+            // 先在新空间中构造，__x 可能引用自身的元素
+            __reallocate_with_gap(__recommend(size() + __n), __offset, __n, [&](pointer __p) {
+                auto __first = __p;
+                auto __guard = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __first, __p));
+                for (size_type __i = 0; __i < __n; ++__i, ++__p) { alloc_traits::construct(__alloc_, __p, __x); }
+                __guard.__complete();
+            });
+        } else if (__n > 0) {
+            pointer __old_last = __end_;
+            __construct_at_end(__n, __x);
+            std::rotate(__begin_ + __offset, __old_last, __end_);
+        }
+        return begin() + __offset;
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    iterator insert(const_iterator __position, _InputIterator __first, _InputIterator __last) {
+        // 小容量的场景下先追加到末尾再旋转到插入位置
+        difference_type __offset = __position - cbegin();
+        size_type __old_size     = size();
+        __append(__first, __last);
+        std::rotate(__begin_ + __offset, __begin_ + __old_size, __end_);
+        return begin() + __offset;
+    }
+
+    iterator insert(const_iterator __position, std::initializer_list<value_type> __il) { return insert(__position, __il.begin(), __il.end()); }
+
+    template <class... _Args>
+    iterator emplace(const_iterator __position, _Args&&... __args) {
+        difference_type __offset = __position - cbegin();
+        pointer __p              = __begin_ + __offset;
+        if (__end_ == __cap_) {
+            __reallocate_with_gap(__recommend(size() + 1), __offset, 1,
+                                  [&](pointer __new_p) { alloc_traits::construct(__alloc_, __new_p, std::forward<_Args>(__args)...); });
+        } else if (__p == __end_) {
+            __construct_one_at_end(std::forward<_Args>(__args)...);
+        } else {
+            __temp_value<value_type, allocator_type> __tmp(__alloc_, std::forward<_Args>(__args)...);
+            __construct_one_at_end(std::move(*(__end_ - 1)));
+            std::move_backward(__p, __end_ - 2, __end_ - 1);
+            *__p = std::move(__tmp.get());
+        }
+        return begin() + __offset;
+    }
+
+    iterator erase(const_iterator __position) {
+        pointer __p = __begin_ + (__position - cbegin());
+        __base_destruct_at_end(std::move(__p + 1, __end_, __p));
+        return iterator(__p);
+    }
+
+    iterator erase(const_iterator __first, const_iterator __last) {
+        pointer __p = __begin_ + (__first - cbegin());
+        if (__first != __last) { __base_destruct_at_end(std::move(__p + (__last - __first), __end_, __p)); }
+        return iterator(__p);
+    }
+
+    void clear() noexcept { __base_destruct_at_end(__begin_); }
+
+    void resize(size_type __size) {
+        size_type __current_size = size();
+        if (__current_size < __size) {
+            reserve(__size);
+            __construct_at_end(__size - __current_size);
+        } else if (__current_size > __size) {
+            __base_destruct_at_end(__begin_ + __size);
+        }
+    }
+
+    void resize(size_type __size, const_reference __x) {
+        size_type __current_size = size();
+        if (__current_size < __size) {
+            if (__size > capacity()) {
+                __reallocate_with_gap(__size, __current_size, __size - __current_size, [&](pointer __p) {
+                    auto __first = __p;
+                    auto __guard = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __first, __p));
+                    for (; __p != __first + (__size - __current_size); ++__p) { alloc_traits::construct(__alloc_, __p, __x); }
+                    __guard.__complete();
+                });
+            } else {
+                __construct_at_end(__size - __current_size, __x);
+            }
+        } else if (__current_size > __size) {
+            __base_destruct_at_end(__begin_ + __size);
+        }
+    }
+
+    void swap(small_vector& __other) noexcept(std::is_nothrow_move_constructible_v<small_vector> && std::is_nothrow_move_assignable_v<small_vector>) {
+        if (this == std::addressof(__other)) return;
+        small_vector __tmp(std::move(__other));
+        __other = std::move(*this);
+        *this   = std::move(__tmp);
+    }
+
+private:
+    // 辅助析构的类，销毁所有元素并释放堆空间
+    class __destroy_small_vector {
+    public:
+        __destroy_small_vector(small_vector& __vec) : __vec_(__vec) {}
+
+        void operator()() { __vec_.__release(); }
+
+    private:
+        small_vector& __vec_;
+    };
+
+    pointer __inline_begin() noexcept { return reinterpret_cast<pointer>(__buffer_); }
+
+    const_pointer __inline_begin() const noexcept { return reinterpret_cast<const_pointer>(__buffer_); }
+
+    void __reset_to_inline() noexcept {
+        __begin_ = __end_ = __inline_begin();
+        __cap_            = __begin_ + _Np;
+    }
+
+    // 析构所有元素，释放堆空间并回到内联存储
+    void __release() noexcept {
+        clear();
+        if (!is_inline()) {
+            alloc_traits::deallocate(__alloc_, __begin_, capacity());
+            __reset_to_inline();
+        }
+    }
+
+    // 从 __other 获取元素，__other 变为空，__take_heap 表示 __alloc_ 可以释放 __other 的堆空间
+    // __other 使用堆空间而不能接管时在 __alloc_ 上重新分配
+    // Precondition: *this 为空且使用内联存储
+    void __steal(small_vector& __other, bool __take_heap) {
+        if (!__other.is_inline() && __take_heap) {
+            __begin_ = __other.__begin_;
+            __end_   = __other.__end_;
+            __cap_   = __other.__cap_;
+            __other.__reset_to_inline();
+        } else {
+            __reserve_empty(__other.size());
+            __uninitialized_allocator_relocate(__alloc_, __other.__begin_, __other.__end_, __begin_);
+            __end_         = __begin_ + __other.size();
+            __other.__end_ = __other.__begin_;
+        }
+    }
+
+    // 容量变化逻辑，与 vector 相同，总体上将容量翻倍
+    // Precondition: __new_size > capacity()
+    size_type __recommend(size_type __new_size) const {
+        const size_type __ms = max_size();
+        if (__new_size > __ms) { mystl::__throw_length_error("small_vector"); }
+        const size_type __cap = capacity();
+        if (__cap >= __ms / 2) { return __ms; }
+        return std::max<size_type>(2 * __cap, __new_size);
+    }
+
+    // Precondition: empty()
+    // Postcondition: capacity() >= __n
+    void __reserve_empty(size_type __n) {
+        if (__n > capacity()) {
+            if (__n > max_size()) { mystl::__throw_length_error("small_vector"); }
+            pointer __p = alloc_traits::allocate(__alloc_, __n);
+            __release();
+            __begin_ = __end_ = __p;
+            __cap_            = __p + __n;
+        }
+    }
+
+    // 将元素迁移到容量为 __new_cap 的堆空间，并在 __offset 处留出 __n 个位置
+    // __construct_gap(__p) 负责在 [__p, __p + __n) 上构造新元素，在迁移之前调用，因此可以引用原有元素
+    template <class _ConstructGap>
+    void __reallocate_with_gap(size_type __new_cap, size_type __offset, size_type __n, _ConstructGap __construct_gap) {
+        __allocation_guard<allocator_type> __buffer(__alloc_, __new_cap);
+        pointer __new_begin = __buffer.__get();
+        pointer __gap_first = __new_begin + __offset;
+        pointer __gap_last  = __gap_first + __n;
+        __construct_gap(__gap_first);
+
+        auto __guard = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __gap_first, __gap_last));
+        size_type __new_size = size() + __n;
+        __uninitialized_allocator_relocate(__alloc_, __begin_ + __offset, __end_, __gap_last);
+        __uninitialized_allocator_relocate(__alloc_, __begin_, __begin_ + __offset, __new_begin);
+        __guard.__complete();
+
+        __end_ = __begin_; // 元素已经在迁移时析构
+        __release();
+        __begin_ = __buffer.__release_ptr();
+        __end_   = __begin_ + __new_size;
+        __cap_   = __begin_ + __new_cap;
+    }
+
+    template <class... _Args>
+    void __emplace_back_slow_path(_Args&&... __args) {
+        __reallocate_with_gap(__recommend(size() + 1), size(), 1,
+                              [&](pointer __p) { alloc_traits::construct(__alloc_, __p, std::forward<_Args>(__args)...); });
+    }
+
+    // 与 vector::_ConstructTransaction 相同，析构时提交 __end_
+    struct _ConstructTransaction {
+        explicit _ConstructTransaction(small_vector& __v, size_type __n) : __v_(__v), __pos_(__v.__end_), __new_end_(__v.__end_ + __n) {}
+
+        ~_ConstructTransaction() { __v_.__end_ = __pos_; }
+
+        small_vector& __v_;
+        pointer __pos_;
+        const_pointer const __new_end_;
+
+        _ConstructTransaction(_ConstructTransaction const&)            = delete;
+        _ConstructTransaction& operator=(_ConstructTransaction const&) = delete;
+    };
+
+    // Precondition: size() + __n <= capacity()
+    void __construct_at_end(size_type __n) {
+        _ConstructTransaction __tx(*this, __n);
+        for (; __tx.__pos_ != __tx.__new_end_; ++__tx.__pos_) { alloc_traits::construct(__alloc_, __tx.__pos_); }
+    }
+
+    // Precondition: size() + __n <= capacity()
+    void __construct_at_end(size_type __n, const_reference __x) {
+        _ConstructTransaction __tx(*this, __n);
+        for (; __tx.__pos_ != __tx.__new_end_; ++__tx.__pos_) { alloc_traits::construct(__alloc_, __tx.__pos_, __x); }
+    }
+
+    // Precondition: size() + __n <= capacity()
+    template <class _InputIterator, class _Sentinel>
+    void __construct_at_end(_InputIterator __first, _Sentinel __last, size_type __n) {
+        _ConstructTransaction __tx(*this, __n);
+        __tx.__pos_ = __unintialized_allocator_copy(__alloc_, std::move(__first), std::move(__last), __tx.__pos_);
+    }
+
+    // Precondition: size() + 1 <= capacity()
+    template <class... _Args>
+    void __construct_one_at_end(_Args&&... __args) {
+        _ConstructTransaction __tx(*this, 1);
+        alloc_traits::construct(__alloc_, __tx.__pos_, std::forward<_Args>(__args)...);
+        ++__tx.__pos_;
+    }
+
+    // 在末尾追加 [__first, __last)，前向迭代器最多扩容一次
+    template <class _InputIterator>
+    void __append(_InputIterator __first, _InputIterator __last) {
+        if constexpr (mystl::is_based_on_forward_iterator<_InputIterator>::value) {
+            size_type __n = static_cast<size_type>(std::distance(__first, __last));
+            if (__n > static_cast<size_type>(__cap_ - __end_)) {
+                __reallocate_with_gap(__recommend(size() + __n), size(), __n, [&](pointer __p) {
+                    __unintialized_allocator_copy(__alloc_, __first, __last, __p);
+                });
+            } else if (__n > 0) {
+                __construct_at_end(__first, __last, __n);
+            }
+        } else {
+            for (; __first != __last; ++__first) { emplace_back(*__first); }
+        }
+    }
+
+    // 将元素从末尾开始析构，一直到 __new_last处
+    void __base_destruct_at_end(pointer __new_last) noexcept {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            pointer __soon_to_be_end = __end_;
+            while (__new_last != __soon_to_be_end) { alloc_traits::destroy(__alloc_, --__soon_to_be_end); }
+        }
+        __end_ = __new_last;
+    }
+};
+
+template <typename _Tp, size_t _Np, class _Allocator>
+void swap(small_vector<_Tp, _Np, _Allocator>& __x, small_vector<_Tp, _Np, _Allocator>& __y) noexcept(noexcept(__x.swap(__y))) {
+    __x.swap(__y);
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_SMALL_VECTOR_H
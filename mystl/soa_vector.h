@@ -0,0 +1,594 @@
+//===-------------------------------------===//
+//
+// soa_vector.h
+// 按列存储的 vector (structure of arrays)，每个字段存放在各自连续的数组中
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_SOA_VECTOR_H
+#define _MYSTL_SOA_VECTOR_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <config.h>
+#include <cstddef>
+#include <exception_guard.h>
+#include <hardening.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <memory>
+#include <throw.h>
+#include <tuple>
+#include <type_traits>
+#include <uninitialized_algorithms.h>
+#include <utility>
+#if _MYSTL_CXX_VERSION >= 20
+#    include <span>
+#endif
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// soa_vector<A, B, C> 的逻辑元素为 std::tuple<A, B, C>，实际存储为三个长度相同、容量相同的数组
+// 只访问部分字段的循环只需要读取对应的列，column<I>() 返回第 I 列的 span，可以直接交给向量化的代码
+// 元素的引用是代理类型 std::tuple<A&, B&, C&>，可以使用结构化绑定与 std::get，也可以整体赋值
+// 追加元素 (push_back/emplace_back/resize) 提供强异常安全保证，中间插入与删除在移动抛出异常时只保证各列处于有效状态
+template <class... _Fields>
+class soa_vector {
+    static_assert(sizeof...(_Fields) > 0, "soa_vector requires at least one field");
+    static_assert((std::is_same_v<_Fields, std::remove_cv_t<std::remove_reference_t<_Fields>>> && ...),
+                  "soa_vector fields must be non-const, non-volatile object types");
+
+    template <bool _IsConst>
+    class __iterator;
+
+public:
+    using value_type      = std::tuple<_Fields...>;
+    using reference       = std::tuple<_Fields&...>;
+    using const_reference = std::tuple<const _Fields&...>;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using iterator        = __iterator<false>;
+    using const_iterator  = __iterator<true>;
+
+    template <size_t _Ip>
+    using field_type = std::tuple_element_t<_Ip, value_type>;
+
+    static constexpr size_t field_count = sizeof...(_Fields);
+
+private:
+    using __columns    = std::tuple<_Fields*...>;
+    using __allocators = std::tuple<mystl::allocator<_Fields>...>;
+    using __indices    = std::index_sequence_for<_Fields...>;
+
+    __columns __cols_ = {};
+    size_type __size_ = 0;
+    size_type __cap_  = 0;
+    __allocators __allocs_;
+
+    static constexpr bool __nothrow_relocate = (std::is_nothrow_move_constructible_v<_Fields> && ...);
+
+public:
+    //
+    // construct/destroy
+    //
+    soa_vector() noexcept = default;
+
+    // 构造函数抛出异常时析构函数不会执行，由 guard 释放已经分配的列与已经构造的元素
+    explicit soa_vector(size_type __n) {
+        auto __guard = mystl::__make_exception_guard([this] { __release(); });
+        resize(__n);
+        __guard.__complete();
+    }
+
+    soa_vector(size_type __n, const value_type& __x) {
+        auto __guard = mystl::__make_exception_guard([this] { __release(); });
+        resize(__n, __x);
+        __guard.__complete();
+    }
+
+    soa_vector(std::initializer_list<value_type> __il) {
+        auto __guard = mystl::__make_exception_guard([this] { __release(); });
+        reserve(__il.size());
+        for (const value_type& __x : __il) { push_back(__x); }
+        __guard.__complete();
+    }
+
+    soa_vector(const soa_vector& __other) {
+        if (__other.__size_ == 0) return;
+        __columns __cols = __allocate_columns(__other.__size_);
+        auto __guard     = mystl::__make_exception_guard([&] { __deallocate_columns(__cols, __other.__size_); });
+        __copy_columns(__other.__cols_, __other.__size_, __cols);
+        __guard.__complete();
+        __cols_ = __cols;
+        __size_ = __cap_ = __other.__size_;
+    }
+
+    soa_vector(soa_vector&& __other) noexcept
+        : __cols_(std::exchange(__other.__cols_, __columns{})), __size_(std::exchange(__other.__size_, 0)),
+          __cap_(std::exchange(__other.__cap_, 0)) {}
+
+    ~soa_vector() { __release(); }
+
+    soa_vector& operator=(const soa_vector& __other) {
+        if (this != &__other) {
+            soa_vector __tmp(__other);
+            swap(__tmp);
+        }
+        return *this;
+    }
+
+    soa_vector& operator=(soa_vector&& __other) noexcept {
+        soa_vector __tmp(std::move(__other));
+        swap(__tmp);
+        return *this;
+    }
+
+    //
+    // 容量
+    //
+    size_type size() const noexcept { return __size_; }
+
+    size_type capacity() const noexcept { return __cap_; }
+
+    [[nodiscard]] bool empty() const noexcept { return __size_ == 0; }
+
+    size_type max_size() const noexcept { return std::min({std::allocator_traits<mystl::allocator<_Fields>>::max_size(mystl::allocator<_Fields>())...}); }
+
+    void reserve(size_type __n) {
+        if (__n > __cap_) {
+            if (__n > max_size()) { mystl::__throw_length_error("soa_vector"); }
+            __reallocate(__n);
+        }
+    }
+
+    void shrink_to_fit() {
+        if (__size_ == 0) {
+            __release();
+        } else if (__cap_ > __size_) {
+            __reallocate(__size_);
+        }
+    }
+
+    //
+    // 元素访问
+    //
+    reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(__n < __size_, "soa_vector[] index out of bounds");
+        return __row(__n, __indices{});
+    }
+
+    const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(__n < __size_, "soa_vector[] index out of bounds");
+        return __row(__n, __indices{});
+    }
+
+    reference at(size_type __n) {
+        if (__n >= __size_) { mystl::__throw_out_of_range("soa_vector"); }
+        return __row(__n, __indices{});
+    }
+
+    const_reference at(size_type __n) const {
+        if (__n >= __size_) { mystl::__throw_out_of_range("soa_vector"); }
+        return __row(__n, __indices{});
+    }
+
+    reference front() noexcept { return (*this)[0]; }
+
+    const_reference front() const noexcept { return (*this)[0]; }
+
+    reference back() noexcept { return (*this)[__size_ - 1]; }
+
+    const_reference back() const noexcept { return (*this)[__size_ - 1]; }
+
+    // 第 _Ip 列的首地址，列中的元素连续存放
+    template <size_t _Ip>
+    field_type<_Ip>* data() noexcept {
+        return std::get<_Ip>(__cols_);
+    }
+
+    template <size_t _Ip>
+    const field_type<_Ip>* data() const noexcept {
+        return std::get<_Ip>(__cols_);
+    }
+
+#if _MYSTL_CXX_VERSION >= 20
+    template <size_t _Ip>
+    std::span<field_type<_Ip>> column() noexcept {
+        return std::span<field_type<_Ip>>(std::get<_Ip>(__cols_), __size_);
+    }
+
+    template <size_t _Ip>
+    std::span<const field_type<_Ip>> column() const noexcept {
+        return std::span<const field_type<_Ip>>(std::get<_Ip>(__cols_), __size_);
+    }
+#endif
+
+    //
+    // 迭代器
+    //
+    iterator begin() noexcept { return iterator(this, 0); }
+
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(this, __size_); }
+
+    const_iterator end() const noexcept { return const_iterator(this, __size_); }
+
+    const_iterator cend() const noexcept { return end(); }
+
+    //
+    // 修改
+    //
+    // 每个字段对应一个参数，第 I 个参数用于构造第 I 列的新元素
+    template <class... _Args>
+    reference emplace_back(_Args&&... __args) {
+        static_assert(sizeof...(_Args) == field_count, "soa_vector::emplace_back requires one argument per field");
+        if (__size_ < __cap_) {
+            __construct_row(__cols_, __size_, std::forward<_Args>(__args)...);
+        } else {
+            __emplace_back_slow_path(std::forward<_Args>(__args)...);
+        }
+        ++__size_;
+        return back();
+    }
+
+    void push_back(const value_type& __x) {
+        std::apply([this](const _Fields&... __f) { emplace_back(__f...); }, __x);
+    }
+
+    void push_back(value_type&& __x) {
+        std::apply([this](_Fields&&... __f) { emplace_back(std::move(__f)...); }, std::move(__x));
+    }
+
+    void pop_back() noexcept {
+        _MYSTL_ASSERT(__size_ > 0, "soa_vector::pop_back called on an empty container");
+        --__size_;
+        __destroy_rows(__size_, __size_ + 1);
+    }
+
+    // 在末尾构造新元素后将其旋转到 __pos，每一列独立完成
+    template <class... _Args>
+    iterator emplace(const_iterator __pos, _Args&&... __args) {
+        size_type __i = __pos.__i_;
+        _MYSTL_ASSERT(__i <= __size_, "soa_vector::emplace: position out of range");
+        emplace_back(std::forward<_Args>(__args)...);
+        __for_each_column([&](auto __c) {
+            auto* __p = std::get<decltype(__c)::value>(__cols_);
+            std::rotate(__p + __i, __p + __size_ - 1, __p + __size_);
+        });
+        return iterator(this, __i);
+    }
+
+    iterator insert(const_iterator __pos, const value_type& __x) {
+        return std::apply([&](const _Fields&... __f) { return emplace(__pos, __f...); }, __x);
+    }
+
+    iterator insert(const_iterator __pos, value_type&& __x) {
+        return std::apply([&](_Fields&&... __f) { return emplace(__pos, std::move(__f)...); }, std::move(__x));
+    }
+
+    iterator erase(const_iterator __pos) { return erase(__pos, __pos + 1); }
+
+    iterator erase(const_iterator __first, const_iterator __last) {
+        size_type __f = __first.__i_, __l = __last.__i_;
+        _MYSTL_ASSERT(__f <= __l && __l <= __size_, "soa_vector::erase: invalid range");
+        if (__f != __l) {
+            __for_each_column([&](auto __c) {
+                auto* __p = std::get<decltype(__c)::value>(__cols_);
+                std::move(__p + __l, __p + __size_, __p + __f);
+            });
+            size_type __new_size = __size_ - (__l - __f);
+            __destroy_rows(__new_size, __size_);
+            __size_ = __new_size;
+        }
+        return iterator(this, __f);
+    }
+
+    void clear() noexcept {
+        __destroy_rows(0, __size_);
+        __size_ = 0;
+    }
+
+    void resize(size_type __n) { __resize(__n); }
+
+    void resize(size_type __n, const value_type& __x) {
+        std::apply([&](const _Fields&... __f) { __resize(__n, __f...); }, __x);
+    }
+
+    void swap(soa_vector& __other) noexcept {
+        std::swap(__cols_, __other.__cols_);
+        std::swap(__size_, __other.__size_);
+        std::swap(__cap_, __other.__cap_);
+    }
+
+    friend bool operator==(const soa_vector& __x, const soa_vector& __y) {
+        if (__x.__size_ != __y.__size_) return false;
+        bool __eq = true;
+        __x.__for_each_column([&](auto __c) {
+            constexpr size_t _Ip = decltype(__c)::value;
+            __eq = __eq && std::equal(std::get<_Ip>(__x.__cols_), std::get<_Ip>(__x.__cols_) + __x.__size_, std::get<_Ip>(__y.__cols_));
+        });
+        return __eq;
+    }
+
+    friend bool operator!=(const soa_vector& __x, const soa_vector& __y) { return !(__x == __y); }
+
+    friend void swap(soa_vector& __x, soa_vector& __y) noexcept { __x.swap(__y); }
+
+private:
+    // 对每一列调用 __f(integral_constant<size_t, I>)
+    template <class _Fn, size_t... _Is>
+    static void __for_each_column_impl(_Fn& __f, std::index_sequence<_Is...>) {
+        (__f(std::integral_constant<size_t, _Is>{}), ...);
+    }
+
+    template <class _Fn>
+    void __for_each_column(_Fn __f) const {
+        __for_each_column_impl(__f, __indices{});
+    }
+
+    template <size_t... _Is>
+    reference __row(size_type __n, std::index_sequence<_Is...>) noexcept {
+        return reference(std::get<_Is>(__cols_)[__n]...);
+    }
+
+    template <size_t... _Is>
+    const_reference __row(size_type __n, std::index_sequence<_Is...>) const noexcept {
+        return const_reference(std::get<_Is>(__cols_)[__n]...);
+    }
+
+    template <size_t _Ip>
+    auto& __alloc() noexcept {
+        return std::get<_Ip>(__allocs_);
+    }
+
+    // 为每一列分配 __n 个元素的空间，某一列分配失败时释放已分配的列
+    __columns __allocate_columns(size_type __n) {
+        __columns __cols{};
+        size_t __done = 0;
+        auto __guard  = mystl::__make_exception_guard([&] { __deallocate_columns(__cols, __n, __done); });
+        __for_each_column([&](auto __c) {
+            constexpr size_t _Ip     = decltype(__c)::value;
+            std::get<_Ip>(__cols) = __alloc<_Ip>().allocate(__n);
+            ++__done;
+        });
+        __guard.__complete();
+        return __cols;
+    }
+
+    void __deallocate_columns(__columns& __cols, size_type __n, size_t __count = field_count) noexcept {
+        __for_each_column([&](auto __c) {
+            constexpr size_t _Ip = decltype(__c)::value;
+            if (_Ip < __count && std::get<_Ip>(__cols) != nullptr) { __alloc<_Ip>().deallocate(std::get<_Ip>(__cols), __n); }
+            std::get<_Ip>(__cols) = nullptr;
+        });
+    }
+
+    // 逐列析构 [__first, __last) 中的元素
+    void __destroy_rows(size_type __first, size_type __last) noexcept {
+        __for_each_column([&](auto __c) {
+            constexpr size_t _Ip = decltype(__c)::value;
+            auto* __p            = std::get<_Ip>(__cols_);
+            for (size_type __i = __first; __i < __last; ++__i) {
+                std::allocator_traits<mystl::allocator<field_type<_Ip>>>::destroy(__alloc<_Ip>(), __p + __i);
+            }
+        });
+    }
+
+    // 在 __cols 的第 __n 行逐列构造元素，某一列构造失败时析构该行已经构造的列
+    template <class... _Args>
+    void __construct_row(__columns& __cols, size_type __n, _Args&&... __args) {
+        __construct_row_impl(__cols, __n, __indices{}, std::forward<_Args>(__args)...);
+    }
+
+    template <size_t... _Is, class... _Args>
+    void __construct_row_impl(__columns& __cols, size_type __n, std::index_sequence<_Is...>, _Args&&... __args) {
+        size_t __done = 0;
+        auto __guard  = mystl::__make_exception_guard([&] {
+            __for_each_column([&](auto __c) {
+                constexpr size_t _Ip = decltype(__c)::value;
+                if (_Ip < __done) { std::allocator_traits<mystl::allocator<field_type<_Ip>>>::destroy(__alloc<_Ip>(), std::get<_Ip>(__cols) + __n); }
+            });
+        });
+        ((std::allocator_traits<mystl::allocator<_Fields>>::construct(__alloc<_Is>(), std::get<_Is>(__cols) + __n, std::forward<_Args>(__args)),
+          ++__done),
+         ...);
+        __guard.__complete();
+    }
+
+    // 将 __src 的前 __n 行拷贝构造到 __dst，失败时析构已拷贝的列
+    void __copy_columns(const __columns& __src, size_type __n, __columns& __dst) {
+        size_t __done = 0;
+        auto __guard  = mystl::__make_exception_guard([&] {
+            __for_each_column([&](auto __c) {
+                constexpr size_t _Ip = decltype(__c)::value;
+                if (_Ip < __done) { std::destroy(std::get<_Ip>(__dst), std::get<_Ip>(__dst) + __n); }
+            });
+        });
+        __for_each_column([&](auto __c) {
+            constexpr size_t _Ip = decltype(__c)::value;
+            mystl::__unintialized_allocator_copy(__alloc<_Ip>(), std::get<_Ip>(__src), std::get<_Ip>(__src) + __n, std::get<_Ip>(__dst));
+            ++__done;
+        });
+        __guard.__complete();
+    }
+
+    // 将全部元素迁移到 __cols 中并释放原有的列
+    // 所有字段的移动构造都不抛出异常时逐列 relocate，否则先整体拷贝再析构原有元素，保证失败时原有元素不变
+    void __adopt(__columns& __cols, size_type __cap) noexcept(__nothrow_relocate) {
+        if constexpr (__nothrow_relocate) {
+            __for_each_column([&](auto __c) {
+                constexpr size_t _Ip = decltype(__c)::value;
+                mystl::__uninitialized_allocator_relocate(__alloc<_Ip>(), std::get<_Ip>(__cols_), std::get<_Ip>(__cols_) + __size_,
+                                                          std::get<_Ip>(__cols));
+            });
+        } else {
+            __copy_columns(__cols_, __size_, __cols);
+            __destroy_rows(0, __size_);
+        }
+        __deallocate_columns(__cols_, __cap_);
+        __cols_ = __cols;
+        __cap_  = __cap;
+    }
+
+    void __reallocate(size_type __cap) {
+        __columns __cols = __allocate_columns(__cap);
+        auto __guard     = mystl::__make_exception_guard([&] { __deallocate_columns(__cols, __cap); });
+        __adopt(__cols, __cap);
+        __guard.__complete();
+    }
+
+    size_type __recommend(size_type __new_size) const {
+        const size_type __ms = max_size();
+        if (__new_size > __ms) { mystl::__throw_length_error("soa_vector"); }
+        if (__cap_ >= __ms / 2) { return __ms; }
+        return std::max<size_type>(2 * __cap_, __new_size);
+    }
+
+    // 先在新的列中构造新元素再迁移原有元素，参数可以引用容器中的元素
+    template <class... _Args>
+    void __emplace_back_slow_path(_Args&&... __args) {
+        size_type __cap  = __recommend(__size_ + 1);
+        __columns __cols = __allocate_columns(__cap);
+        auto __guard     = mystl::__make_exception_guard([&] { __deallocate_columns(__cols, __cap); });
+        __construct_row(__cols, __size_, std::forward<_Args>(__args)...);
+        auto __row_guard = mystl::__make_exception_guard([&] {
+            __for_each_column([&](auto __c) {
+                constexpr size_t _Ip = decltype(__c)::value;
+                std::allocator_traits<mystl::allocator<field_type<_Ip>>>::destroy(__alloc<_Ip>(), std::get<_Ip>(__cols) + __size_);
+            });
+        });
+        __adopt(__cols, __cap);
+        __row_guard.__complete();
+        __guard.__complete();
+    }
+
+    template <class... _Args>
+    void __resize(size_type __n, const _Args&... __args) {
+        if (__n <= __size_) {
+            __destroy_rows(__n, __size_);
+            __size_ = __n;
+            return;
+        }
+        if (__n > __cap_) { __reallocate(__recommend(__n)); }
+        size_type __old = __size_;
+        auto __guard    = mystl::__make_exception_guard([&] {
+            __destroy_rows(__old, __size_);
+            __size_ = __old;
+        });
+        for (; __size_ < __n; ++__size_) {
+            if constexpr (sizeof...(_Args) == 0) {
+                __construct_row(__cols_, __size_, _Fields()...);
+            } else {
+                __construct_row(__cols_, __size_, __args...);
+            }
+        }
+        __guard.__complete();
+    }
+
+    void __release() noexcept {
+        if (__cap_ != 0) {
+            __destroy_rows(0, __size_);
+            __deallocate_columns(__cols_, __cap_);
+            __size_ = __cap_ = 0;
+        }
+    }
+
+    // 按下标访问的迭代器，解引用得到代理引用
+    template <bool _IsConst>
+    class __iterator {
+        using __container = std::conditional_t<_IsConst, const soa_vector, soa_vector>;
+
+    public:
+        using iterator_category = random_access_iterator_tag;
+        using value_type        = typename soa_vector::value_type;
+        using difference_type   = typename soa_vector::difference_type;
+        using reference         = std::conditional_t<_IsConst, typename soa_vector::const_reference, typename soa_vector::reference>;
+        using pointer           = void;
+
+        __iterator() noexcept : __v_(nullptr), __i_(0) {}
+
+        template <bool _OtherConst, std::enable_if_t<_IsConst && !_OtherConst, int> = 0>
+        __iterator(const __iterator<_OtherConst>& __it) noexcept : __v_(__it.__v_), __i_(__it.__i_) {}
+
+        reference operator*() const noexcept { return (*__v_)[__i_]; }
+
+        reference operator[](difference_type __n) const noexcept { return (*__v_)[__i_ + __n]; }
+
+        // 直接访问当前元素的某个字段
+        template <size_t _Ip>
+        auto& get() const noexcept {
+            return __v_->template data<_Ip>()[__i_];
+        }
+
+        __iterator& operator++() noexcept {
+            ++__i_;
+            return *this;
+        }
+
+        __iterator operator++(int) noexcept {
+            __iterator __tmp(*this);
+            ++__i_;
+            return __tmp;
+        }
+
+        __iterator& operator--() noexcept {
+            --__i_;
+            return *this;
+        }
+
+        __iterator operator--(int) noexcept {
+            __iterator __tmp(*this);
+            --__i_;
+            return __tmp;
+        }
+
+        __iterator& operator+=(difference_type __n) noexcept {
+            __i_ += __n;
+            return *this;
+        }
+
+        __iterator& operator-=(difference_type __n) noexcept {
+            __i_ -= __n;
+            return *this;
+        }
+
+        friend __iterator operator+(__iterator __it, difference_type __n) noexcept { return __it += __n; }
+
+        friend __iterator operator+(difference_type __n, __iterator __it) noexcept { return __it += __n; }
+
+        friend __iterator operator-(__iterator __it, difference_type __n) noexcept { return __it -= __n; }
+
+        friend difference_type operator-(const __iterator& __x, const __iterator& __y) noexcept {
+            return static_cast<difference_type>(__x.__i_) - static_cast<difference_type>(__y.__i_);
+        }
+
+        friend bool operator==(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ == __y.__i_; }
+
+        friend bool operator!=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ != __y.__i_; }
+
+        friend bool operator<(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ < __y.__i_; }
+
+        friend bool operator>(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ > __y.__i_; }
+
+        friend bool operator<=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ <= __y.__i_; }
+
+        friend bool operator>=(const __iterator& __x, const __iterator& __y) noexcept { return __x.__i_ >= __y.__i_; }
+
+    private:
+        template <bool>
+        friend class __iterator;
+        friend class soa_vector;
+
+        __container* __v_;
+        size_type __i_;
+
+        __iterator(__container* __v, size_type __i) noexcept : __v_(__v), __i_(__i) {}
+    };
+};
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_SOA_VECTOR_H
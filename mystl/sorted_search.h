@@ -0,0 +1,122 @@
+//===-------------------------------------===//
+//
+// sorted_search.h
+// 有序区间上的无分支二分查找与批量查找
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_SORTED_SEARCH_H
+#define _MYSTL_SORTED_SEARCH_H
+
+#include <algorithm>
+#include <config.h>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#if _MYSTL_CXX_VERSION >= 20
+#    include <ranges>
+#endif
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 标记传入的区间已经按键排序且没有重复的键，flat_map/flat_set 据此跳过排序与去重
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+
+inline constexpr sorted_unique_t sorted_unique{};
+
+// 读预取 __base 之后 __offset 字节所在的缓存行
+// 地址按整数计算，可以越过数组的末尾，预取指令不会访问无效的地址
+inline void __prefetch_read(const void* __base, size_t __offset) noexcept {
+    __builtin_prefetch(reinterpret_cast<const void*>(reinterpret_cast<std::uintptr_t>(__base) + __offset), 0, 3);
+}
+
+// 返回 [__first, __first + __n) 中第一个不满足 __comp(*it, __value) 的位置
+// 每一步只根据比较结果选择 __first 或 __first + __half，编译为条件传送而不是条件跳转，
+// 循环次数只取决于 __n，查找的键随机分布时没有分支预测失败
+template <class _RandomAccessIterator, class _Tp, class _Compare>
+_MYSTL_CONSTEXPR_SINCE_CXX14 _RandomAccessIterator __branchless_lower_bound(_RandomAccessIterator __first, size_t __n, const _Tp& __value,
+                                                                            _Compare& __comp) {
+    if (__n == 0) return __first;
+    while (__n > 1) {
+        size_t __half = __n / 2;
+        __first += __comp(__first[__half], __value) ? __half : 0;
+        __n -= __half;
+    }
+    return __first + (__comp(*__first, __value) ? 1 : 0);
+}
+
+// 返回 [__first, __first + __n) 中第一个满足 __comp(__value, *it) 的位置
+template <class _RandomAccessIterator, class _Tp, class _Compare>
+_MYSTL_CONSTEXPR_SINCE_CXX14 _RandomAccessIterator __branchless_upper_bound(_RandomAccessIterator __first, size_t __n, const _Tp& __value,
+                                                                            _Compare& __comp) {
+    if (__n == 0) return __first;
+    while (__n > 1) {
+        size_t __half = __n / 2;
+        __first += __comp(__value, __first[__half]) ? 0 : __half;
+        __n -= __half;
+    }
+    return __first + (__comp(__value, *__first) ? 0 : 1);
+}
+
+// lower_bound_batch 默认同时进行的查找数
+inline constexpr size_t default_lower_bound_batch = 8;
+
+// 对 [__kfirst, __klast) 中的每个键在有序区间 [__first, __last) 中查找 lower_bound，结果依次写入 __out，返回写入结束的位置
+// 每次取 _Batch 个键，同时推进它们的无分支二分查找：所有查找的步数只取决于区间长度，可以逐步交替进行，
+// 每一步在比较之前预取下一步可能访问的两个位置，各个查找的缓存缺失互不依赖，可以同时进行
+// _Batch 取 8 ~ 16 时能够覆盖内存延迟，更大时同时缺失的缓存行超出核心能够跟踪的数量，反而变慢，见 sorted_search_performance.cpp
+// Precondition: [__first, __last) 为连续存储，且已经按 __comp 排序
+template <size_t _Batch = default_lower_bound_batch, class _ContiguousIterator, class _KeyIterator, class _OutputIterator, class _Compare = std::less<>>
+_OutputIterator lower_bound_batch(_ContiguousIterator __first, _ContiguousIterator __last, _KeyIterator __kfirst, _KeyIterator __klast,
+                                  _OutputIterator __out, _Compare __comp = _Compare()) {
+    static_assert(_Batch > 0, "lower_bound_batch requires a positive batch size");
+#if _MYSTL_CXX_VERSION >= 20
+    static_assert(std::contiguous_iterator<_ContiguousIterator>, "lower_bound_batch requires contiguous iterators");
+#endif
+    using _Ptr = decltype(std::addressof(*__first));
+
+    const size_t __n = static_cast<size_t>(__last - __first);
+    if (__n == 0) {
+        for (; __kfirst != __klast; ++__kfirst, ++__out) { *__out = __first; }
+        return __out;
+    }
+    const _Ptr __data = std::addressof(*__first);
+    const size_t __m  = static_cast<size_t>(__klast - __kfirst);
+    _Ptr __base[_Batch];
+    for (size_t __i = 0; __i < __m; __i += _Batch) {
+        const size_t __g = std::min(_Batch, __m - __i);
+        for (size_t __j = 0; __j < __g; ++__j) { __base[__j] = __data; }
+        for (size_t __len = __n; __len > 1;) {
+            const size_t __half = __len / 2;
+            const size_t __next = (__len - __half) / 2;
+            for (size_t __j = 0; __j < __g; ++__j) {
+                mystl::__prefetch_read(__base[__j], __next * sizeof(*__data));
+                mystl::__prefetch_read(__base[__j], (__half + __next) * sizeof(*__data));
+                __base[__j] += __comp(__base[__j][__half], __kfirst[__i + __j]) ? __half : 0;
+            }
+            __len -= __half;
+        }
+        for (size_t __j = 0; __j < __g; ++__j, ++__out) {
+            *__out = __first + ((__base[__j] - __data) + (__comp(*__base[__j], __kfirst[__i + __j]) ? 1 : 0));
+        }
+    }
+    return __out;
+}
+
+#if _MYSTL_CXX_VERSION >= 20
+// 以连续存储的有序容器 (例如 mystl::vector) 与键的范围调用，结果为 __sorted 的迭代器
+template <size_t _Batch = default_lower_bound_batch, class _Range, class _Keys, class _OutputIterator, class _Compare = std::less<>>
+    requires std::ranges::contiguous_range<_Range> && std::ranges::random_access_range<_Keys>
+_OutputIterator lower_bound_batch(_Range& __sorted, const _Keys& __keys, _OutputIterator __out, _Compare __comp = _Compare()) {
+    return mystl::lower_bound_batch<_Batch>(std::ranges::begin(__sorted), std::ranges::end(__sorted), std::ranges::begin(__keys),
+                                            std::ranges::end(__keys), std::move(__out), std::move(__comp));
+}
+#endif
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_SORTED_SEARCH_H
@@ -0,0 +1,170 @@
+//===-------------------------------------===//
+//
+// stream_copy.h
+// 大块内存拷贝，超过阈值时使用非临时 (streaming) 写入，不把目标数据带入缓存
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_STREAM_COPY_H
+#define _MYSTL_STREAM_COPY_H
+
+#include <atomic>
+#include <config.h>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#    include <immintrin.h>
+#    define _MYSTL_HAS_STREAM_COPY 1
+#else
+#    define _MYSTL_HAS_STREAM_COPY 0
+#endif
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 数百 MB 的 memcpy 会把目标与源数据全部写入末级缓存，挤出其他线程的工作集
+// 超过阈值的拷贝改为非临时写入：数据直接写回内存，源数据以 NTA 预取读取，两者都不会长期占用缓存
+// 阈值应当与末级缓存的大小相当，小于阈值时仍然使用 memcpy，拷贝结果在缓存中对之后的读取更有利
+struct stream_copy_config {
+    size_t threshold_bytes   = size_t(16) << 20;
+    size_t prefetch_distance = 1024; // 预取源数据的提前量，单位为字节
+};
+
+// 指令集，runtime dispatch 时选择 CPU 支持的最宽的一种
+enum class stream_copy_isa { none, sse2, avx2, avx512 };
+
+inline std::atomic<size_t> __stream_copy_threshold{stream_copy_config{}.threshold_bytes};
+inline std::atomic<size_t> __stream_copy_prefetch{stream_copy_config{}.prefetch_distance};
+
+inline void set_stream_copy_config(const stream_copy_config& __c) noexcept {
+    __stream_copy_threshold.store(__c.threshold_bytes, std::memory_order_relaxed);
+    __stream_copy_prefetch.store(__c.prefetch_distance, std::memory_order_relaxed);
+}
+
+inline stream_copy_config get_stream_copy_config() noexcept {
+    return stream_copy_config{__stream_copy_threshold.load(std::memory_order_relaxed), __stream_copy_prefetch.load(std::memory_order_relaxed)};
+}
+
+#if _MYSTL_HAS_STREAM_COPY
+
+// 每个内核以 64 字节 (一个缓存行) 为单位拷贝
+// Precondition: __dst 按 64 字节对齐，__n 是 64 的倍数，__src 可以不对齐
+__attribute__((target("sse2"))) inline void __stream_copy_sse2(char* __dst, const char* __src, size_t __n, size_t __pf) noexcept {
+    for (size_t __i = 0; __i < __n; __i += 64) {
+        _mm_prefetch(__src + __i + __pf, _MM_HINT_NTA);
+        __m128i __a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__src + __i));
+        __m128i __b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__src + __i + 16));
+        __m128i __c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__src + __i + 32));
+        __m128i __d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__src + __i + 48));
+        _mm_stream_si128(reinterpret_cast<__m128i*>(__dst + __i), __a);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(__dst + __i + 16), __b);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(__dst + __i + 32), __c);
+        _mm_stream_si128(reinterpret_cast<__m128i*>(__dst + __i + 48), __d);
+    }
+}
+
+__attribute__((target("avx2"))) inline void __stream_copy_avx2(char* __dst, const char* __src, size_t __n, size_t __pf) noexcept {
+    for (size_t __i = 0; __i < __n; __i += 64) {
+        _mm_prefetch(__src + __i + __pf, _MM_HINT_NTA);
+        __m256i __a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__src + __i));
+        __m256i __b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(__src + __i + 32));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(__dst + __i), __a);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(__dst + __i + 32), __b);
+    }
+}
+
+__attribute__((target("avx512f"))) inline void __stream_copy_avx512(char* __dst, const char* __src, size_t __n, size_t __pf) noexcept {
+    for (size_t __i = 0; __i < __n; __i += 64) {
+        _mm_prefetch(__src + __i + __pf, _MM_HINT_NTA);
+        __m512i __a = _mm512_loadu_si512(__src + __i);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(__dst + __i), __a);
+    }
+}
+
+using __stream_copy_kernel = void (*)(char*, const char*, size_t, size_t) noexcept;
+
+inline stream_copy_isa __detect_stream_copy_isa() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return stream_copy_isa::avx512;
+    if (__builtin_cpu_supports("avx2")) return stream_copy_isa::avx2;
+    if (__builtin_cpu_supports("sse2")) return stream_copy_isa::sse2;
+    return stream_copy_isa::none;
+}
+
+inline __stream_copy_kernel __stream_copy_kernel_for(stream_copy_isa __isa) noexcept {
+    switch (__isa) {
+    case stream_copy_isa::avx512: return __stream_copy_avx512;
+    case stream_copy_isa::avx2: return __stream_copy_avx2;
+    case stream_copy_isa::sse2: return __stream_copy_sse2;
+    default: return nullptr;
+    }
+}
+
+// 第一次使用时检测 CPU，可以用 set_stream_copy_isa 降级到较窄的指令集，例如用于比较
+inline std::atomic<__stream_copy_kernel>& __stream_copy_active() noexcept {
+    static std::atomic<__stream_copy_kernel> __k{__stream_copy_kernel_for(__detect_stream_copy_isa())};
+    return __k;
+}
+
+#endif // _MYSTL_HAS_STREAM_COPY
+
+// CPU 支持的最宽的指令集
+inline stream_copy_isa stream_copy_supported_isa() noexcept {
+#if _MYSTL_HAS_STREAM_COPY
+    static const stream_copy_isa __isa = __detect_stream_copy_isa();
+    return __isa;
+#else
+    return stream_copy_isa::none;
+#endif
+}
+
+// 选择使用的指令集，超过 CPU 支持的指令集时返回 false 且不做修改，none 表示总是使用 memcpy
+inline bool set_stream_copy_isa(stream_copy_isa __isa) noexcept {
+#if _MYSTL_HAS_STREAM_COPY
+    if (static_cast<int>(__isa) > static_cast<int>(stream_copy_supported_isa())) return false;
+    __stream_copy_active().store(__stream_copy_kernel_for(__isa), std::memory_order_relaxed);
+    return true;
+#else
+    return __isa == stream_copy_isa::none;
+#endif
+}
+
+// 非临时写入的拷贝，不检查阈值
+// 头部不足一个缓存行的部分与尾部不足 64 字节的部分使用 memcpy，返回前执行 sfence，
+// 使非临时写入对其他线程可见的顺序与普通写入一致
+inline void stream_copy(void* __dst, const void* __src, size_t __n) noexcept {
+#if _MYSTL_HAS_STREAM_COPY
+    __stream_copy_kernel __kernel = __stream_copy_active().load(std::memory_order_relaxed);
+    if (__kernel == nullptr || __n < 256) {
+        std::memcpy(__dst, __src, __n);
+        return;
+    }
+    char* __d       = static_cast<char*>(__dst);
+    const char* __s = static_cast<const char*>(__src);
+    size_t __head   = (64 - (reinterpret_cast<uintptr_t>(__d) & 63)) & 63;
+    std::memcpy(__d, __s, __head);
+    __d += __head;
+    __s += __head;
+    __n -= __head;
+    size_t __body = __n & ~size_t(63);
+    __kernel(__d, __s, __body, __stream_copy_prefetch.load(std::memory_order_relaxed));
+    _mm_sfence();
+    std::memcpy(__d + __body, __s + __body, __n - __body);
+#else
+    std::memcpy(__dst, __src, __n);
+#endif
+}
+
+// 批量拷贝与迁移使用的入口，小于阈值时为普通的 memcpy
+// Precondition: [__src, __src + __n) 与 [__dst, __dst + __n) 不重叠
+inline void __bulk_memcpy(void* __dst, const void* __src, size_t __n) noexcept {
+    if (__n >= __stream_copy_threshold.load(std::memory_order_relaxed)) {
+        mystl::stream_copy(__dst, __src, __n);
+    } else {
+        std::memcpy(__dst, __src, __n);
+    }
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_STREAM_COPY_H
@@ -0,0 +1,76 @@
+//===-------------------------------------===//
+//
+// throw.h
+// 抛出标准异常，-fno-exceptions 编译时输出信息后 abort
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_THROW_H
+#define _MYSTL_THROW_H
+
+#include <config.h>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+#if !_MYSTL_HAS_EXCEPTIONS
+[[noreturn]] inline void __abort_without_exceptions(const char* __what, const char* __msg) noexcept {
+    std::fprintf(stderr, "%s: %s\n", __what, __msg);
+    std::abort();
+}
+#endif
+
+[[noreturn]] inline void __throw_length_error(const char* __msg) {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::length_error(__msg);
+#else
+    mystl::__abort_without_exceptions("length_error", __msg);
+#endif
+}
+
+[[noreturn]] inline void __throw_out_of_range(const char* __msg) {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::out_of_range(__msg);
+#else
+    mystl::__abort_without_exceptions("out_of_range", __msg);
+#endif
+}
+
+[[noreturn]] inline void __throw_logic_error(const char* __msg) {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::logic_error(__msg);
+#else
+    mystl::__abort_without_exceptions("logic_error", __msg);
+#endif
+}
+
+[[noreturn]] inline void __throw_runtime_error(const char* __msg) {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::runtime_error(__msg);
+#else
+    mystl::__abort_without_exceptions("runtime_error", __msg);
+#endif
+}
+
+[[noreturn]] inline void __throw_bad_alloc() {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::bad_alloc();
+#else
+    mystl::__abort_without_exceptions("bad_alloc", "allocation failed");
+#endif
+}
+
+[[noreturn]] inline void __throw_bad_array_new_length() {
+#if _MYSTL_HAS_EXCEPTIONS
+    throw std::bad_array_new_length();
+#else
+    mystl::__abort_without_exceptions("bad_array_new_length", "allocation size exceeds max_size()");
+#endif
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_THROW_H
@@ -6,6 +6,7 @@
 #include <exception_guard.h>
 #include <iterator.h>
 #include <memory>
+#include <stream_copy.h>
 #include <type_traits>
 
 
@@ -56,12 +57,23 @@ _MYSTL_CONSTEXPR_SINCE_CXX14 void __uninitialized_allocator_relocate(_Alloc& __a
         __guard.__complete();
         // 清除原数据
         for (; __first != __last; ++__first) { std::allocator_traits<_Alloc>::destroy(__alloc_, std::addressof(*__first)); }
-    } else {
-        // 直接使用 memcpy
-        std::memcpy(static_cast<void*>(std::addressof(*__result)), std::addressof(*__first), sizeof(_ValueType) * (__last - __first));
+    } else if (__first != __last) {
+        // 直接使用 memcpy，空的 vector 中 __first 可能为空指针，不能传给 memcpy
+        // 超过阈值的大块迁移使用非临时写入，见 stream_copy.h
+        mystl::__bulk_memcpy(static_cast<void*>(std::addressof(*__result)), std::addressof(*__first), sizeof(_ValueType) * (__last - __first));
     }
 }
 
+// 在 __first 开始的 __n 个位置上以 __args 构造元素，构造失败时析构已经构造的元素
+template <class _Alloc, class _Iter, class... _Args>
+_MYSTL_CONSTEXPR_SINCE_CXX20 _Iter __uninitialized_allocator_construct_n(_Alloc& __alloc, _Iter __first, size_t __n, const _Args&... __args) {
+    auto __destruct_first = __first;
+    auto __guard          = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<_Alloc, _Iter>(__alloc, __destruct_first, __first));
+    for (; __n > 0; --__n, ++__first) { std::allocator_traits<_Alloc>::construct(__alloc, std::addressof(*__first), __args...); }
+    __guard.__complete();
+    return __first;
+}
+
 // 将 [__first1, __last1) 中的元素拷贝构造到 __first2 开始的 N 个位置，其中 N 是 __first1 到 __last1 之间的距离
 // 使用时需要确保 __first2 开始有足够大小的空间
 template <class _Alloc, class _Iter1, class _Sent1, class _Iter2>
@@ -105,8 +117,8 @@ _MYSTL_CONSTEXPR_SINCE_CXX20 _Out __unintialized_allocator_copy_impl(_Alloc& __a
         return __first2;
     } else {
         size_t __n = static_cast<size_t>(std::distance(__first1, __last1));
-        std::memcpy(static_cast<void*>(std::addressof(*__first2)), std::addressof(*__first1),
-                    __n * sizeof(typename std::iterator_traits<_In>::value_type));
+        mystl::__bulk_memcpy(static_cast<void*>(std::addressof(*__first2)), std::addressof(*__first1),
+                             __n * sizeof(typename std::iterator_traits<_In>::value_type));
         return __first2 + __n;
     }
 }
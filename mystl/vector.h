@@ -3,18 +3,44 @@
 
 #include <algorithm>
 #include <allocator.h>
-#include <cassert>
 #include <config.h>
+#include <cstring>
 #include <exception_guard.h>
+#include <functional>
+#include <hardening.h>
 #include <initializer_list>
 #include <iterator.h>
 #include <limits>
+#if _MYSTL_CXX_VERSION >= 20
+#    include <span>
+#endif
 #include <temp_value.h>
+#include <throw.h>
 #include <uninitialized_algorithms.h>
+#if _MYSTL_VECTOR_SHRINK_POLICY
+#    include <vector_shrink.h>
+#endif
+#if _MYSTL_VECTOR_TELEMETRY
+#    include <vector_telemetry.h>
+#elif !defined(_MYSTL_REALLOCATION_SITE)
+#    define _MYSTL_REALLOCATION_SITE() static_assert(true)
+#endif
 
 
 _MYSTL_BEGIN_NAMESPACE_MYSTL
 
+struct __serialize_access;
+
+// 定义在 parallel.h 中，使用并行构造时需要包含 parallel.h
+struct parallel_policy;
+
+template <class _Fn, class _Rollback>
+void __parallel_for_chunks(const parallel_policy& __pol, size_t __n, size_t __elem_size, _Fn __fn, _Rollback __rollback);
+
+// try_* 系列的返回值
+// length_error 表示所需的元素数超过 max_size()，out_of_memory 表示分配器无法提供内存，两种情况下 vector 都不做修改
+enum class vector_status : unsigned char { ok, length_error, out_of_memory };
+
 template <typename _Tp, class _Allocator = mystl::allocator<_Tp>>
 class vector {
 public:
@@ -40,6 +66,9 @@ private:
     pointer __cap_   = nullptr;
     allocator_type __alloc_;
 
+    // serialize.h 中的 load 直接读入未初始化的容量
+    friend struct __serialize_access;
+
 public:
     //
     // [vector.cons] constuct/copy/destroy
@@ -86,6 +115,43 @@ public:
         __guard.__complete();
     }
 
+    // 并行构造，需要构造的字节数超过 __pol.threshold_bytes 时分块交给线程池，见 parallel.h
+    explicit vector(const parallel_policy& __pol, size_type __n) {
+        auto __guard = mystl::__make_exception_guard(__destroy_vector(*this));
+        if (__n > 0) {
+            __vallocate(__n);
+            __parallel_construct_at_end(__pol, __n, [this](pointer __p, size_type, size_type __cnt) {
+                mystl::__uninitialized_allocator_construct_n(__alloc_, __p, __cnt);
+            });
+        }
+        __guard.__complete();
+    }
+
+    vector(const parallel_policy& __pol, size_type __n, const_reference __x) {
+        auto __guard = mystl::__make_exception_guard(__destroy_vector(*this));
+        if (__n > 0) {
+            __vallocate(__n);
+            __parallel_construct_at_end(__pol, __n, [this, &__x](pointer __p, size_type, size_type __cnt) {
+                mystl::__uninitialized_allocator_construct_n(__alloc_, __p, __cnt, __x);
+            });
+        }
+        __guard.__complete();
+    }
+
+    vector(const parallel_policy& __pol, const vector& __other)
+        : __alloc_(alloc_traits::select_on_container_copy_construction(__other.__alloc_)) {
+        auto __guard = mystl::__make_exception_guard(__destroy_vector(*this));
+        size_type __n = __other.size();
+        if (__n > 0) {
+            __vallocate(__n);
+            const_pointer __src = __other.__begin_;
+            __parallel_construct_at_end(__pol, __n, [this, __src](pointer __p, size_type __offset, size_type __cnt) {
+                mystl::__unintialized_allocator_copy(__alloc_, __src + __offset, __src + __offset + __cnt, __p);
+            });
+        }
+        __guard.__complete();
+    }
+
 // 使用迭代器构造
 // input_iterator 必须一个个进行构造，且无法预先知道长度
 #if _MYSTL_CXX_VERSION <= 17
@@ -179,7 +245,8 @@ public:
     _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator=(const vector& __x) {
         if (this != std::addressof(__x)) {
             __copy_assign_alloc(__x);
-            assign(__x.begin(), __x.end());
+            // 直接传入指针，使平凡类型走 __assign_with_size 中的 memcpy
+            __assign_with_size(__x.__begin_, __x.__end_, __x.size());
         }
         return *this;
     }
@@ -209,8 +276,17 @@ public:
         __assign_with_size(__first, __last, std::distance(__first, __last));
     }
 
+    // 容量足够时复用已有存储，不重新分配
     _MYSTL_CONSTEXPR_SINCE_CXX20 void assign(size_type __n, const_reference __x) {
         if (__n <= capacity()) {
+            if constexpr (std::is_trivially_copyable_v<value_type> && std::is_trivially_default_constructible_v<value_type>) {
+                // 已有元素与尾部容量没有区别，一次 fill_n 写满，不需要区分赋值与构造
+                if (!IS_CONSTANT_EVALUATED()) {
+                    std::fill_n(__begin_, __n, __x);
+                    __end_ = __begin_ + __n;
+                    return;
+                }
+            }
             size_type __old_size = size();
             std::fill_n(__begin_, std::min(__n, __old_size), __x);
             if (__n <= __old_size) {
@@ -227,6 +303,20 @@ public:
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void assign(std::initializer_list<value_type> __il) { assign(__il.begin(), __il.end()); }
 
+    // 并行填充，原有元素先全部析构，见 parallel.h
+    void assign(const parallel_policy& __pol, size_type __n, const_reference __x) {
+        __base_destruct_at_end(__begin_);
+        if (__n > capacity()) {
+            __vdeallocate();
+            __vallocate(__recommend(__n));
+        }
+        if (__n > 0) {
+            __parallel_construct_at_end(__pol, __n, [this, &__x](pointer __p, size_type, size_type __cnt) {
+                mystl::__uninitialized_allocator_construct_n(__alloc_, __p, __cnt, __x);
+            });
+        }
+    }
+
 private:
     // 辅助析构的类
     class __destroy_vector {
@@ -244,7 +334,7 @@ private:
 
 public:
     _MYSTL_CONSTEXPR_SINCE_CXX20 ~vector() {
-        clear();
+        __base_destruct_at_end(__begin_);
         __destroy_vector (*this)();
     }
 
@@ -295,53 +385,104 @@ public:
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void reserve(size_type __n) {
         if (__n > capacity()) {
-            if (__n > max_size()) { throw std::length_error("vector"); }
+            if (__n > max_size()) { mystl::__throw_length_error("vector"); }
             __reallocation_buffer __buffer(__alloc_, __n);
             __swap_reallocation_buffer(__buffer);
         }
     }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 void shrink_to_fit() noexcept {
-        if (capacity() > size()) {
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void shrink_to_fit() noexcept { trim(0); }
+
+    // 将容量减小到 max(size(), __n)，返回释放的字节数，容量已经不大于 __n 或分配失败时不做修改并返回 0
+    // 例如在内存紧张的回调中对长期存在的 vector 调用
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type trim(size_type __n) noexcept {
+        __n = std::max(__n, size());
+        if (__n >= capacity()) return 0;
+        size_type __released = (capacity() - __n) * sizeof(value_type);
 #if _MYSTL_HAS_EXCEPTIONS
-            try {
+        try {
 #endif
-                __reallocation_buffer __buffer(__alloc_, size());
-                __swap_reallocation_buffer(__buffer);
+            __reallocation_buffer __buffer(__alloc_, __n);
+            __swap_reallocation_buffer(__buffer);
 #if _MYSTL_HAS_EXCEPTIONS
-            } catch (...) {}
+        } catch (...) { return 0; }
 #endif
+        return __released;
+    }
+
+    // 未初始化的尾部容量，可以直接作为 read/readv 等的目标，写入后使用 commit_spare 提交
+    // 只适用于平凡可拷贝的类型，写入的字节即构成元素，不需要构造
+    // 保证至少有 __n 个元素的空余容量，不足时与 push_back 相同按照 __recommend 扩容
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void reserve_spare(size_type __n) {
+        if (__n > static_cast<size_type>(__cap_ - __end_)) {
+            if (__n > max_size() - size()) { mystl::__throw_length_error("vector"); }
+            __reallocation_buffer __buffer(__alloc_, __recommend(size() + __n));
+            __swap_reallocation_buffer(__buffer);
         }
     }
 
+#if _MYSTL_CXX_VERSION >= 20
+    _MYSTL_CONSTEXPR_SINCE_CXX20 std::span<value_type> spare_capacity() noexcept {
+        static_assert(std::is_trivially_copyable_v<value_type>, "spare_capacity requires a trivially copyable value_type");
+        return std::span<value_type>(std::to_address(__end_), static_cast<size_type>(__cap_ - __end_));
+    }
+#endif
+
+    // 将空余容量的前 __n 个元素计入 size()
+    // Precondition: __n <= capacity() - size()，且这些元素已经被完整写入
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void commit_spare(size_type __n) noexcept {
+        static_assert(std::is_trivially_copyable_v<value_type>, "commit_spare requires a trivially copyable value_type");
+        _MYSTL_ASSERT(__n <= static_cast<size_type>(__cap_ - __end_), "vector::commit_spare: exceeds spare capacity");
+        __end_ += __n;
+    }
+
     // element access
-    _MYSTL_CONSTEXPR_SINCE_CXX20 reference operator[](size_type __n) noexcept { return __begin_[__n]; }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference operator[](size_type __n) noexcept {
+        _MYSTL_ASSERT(__n < size(), "vector[] index out of bounds");
+        return __begin_[__n];
+    }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference operator[](size_type __n) const noexcept { return __begin_[__n]; }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference operator[](size_type __n) const noexcept {
+        _MYSTL_ASSERT(__n < size(), "vector[] index out of bounds");
+        return __begin_[__n];
+    }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 reference at(size_type __n) {
-        if (__n >= size()) { throw std::out_of_range("vector"); }
+        if (__n >= size()) { mystl::__throw_out_of_range("vector"); }
         return __begin_[__n];
     }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference at(size_type __n) const {
-        if (__n >= size()) { throw std::out_of_range("vector"); }
+        if (__n >= size()) { mystl::__throw_out_of_range("vector"); }
         return __begin_[__n];
     }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 reference front() noexcept { return *__begin_; }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference front() noexcept {
+        _MYSTL_ASSERT(!empty(), "vector::front called on an empty vector");
+        return *__begin_;
+    }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference front() const noexcept { return *__begin_; }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference front() const noexcept {
+        _MYSTL_ASSERT(!empty(), "vector::front called on an empty vector");
+        return *__begin_;
+    }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 reference back() noexcept { return *(__end_ - 1); }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference back() noexcept {
+        _MYSTL_ASSERT(!empty(), "vector::back called on an empty vector");
+        return *(__end_ - 1);
+    }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference back() const noexcept { return *(__end_ - 1); }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference back() const noexcept {
+        _MYSTL_ASSERT(!empty(), "vector::back called on an empty vector");
+        return *(__end_ - 1);
+    }
 
     //
     // [vector.data], data access
-    _MYSTL_CONSTEXPR_SINCE_CXX20 value_type* data() noexcept { return std::addressof(*__begin_); }
+    // 空的 vector 中 __begin_ 可能为空指针，不能解引用
+    _MYSTL_CONSTEXPR_SINCE_CXX20 value_type* data() noexcept { return __begin_ == nullptr ? nullptr : std::addressof(*__begin_); }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 const value_type* data() const noexcept { return std::addressof(*__begin_); }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const value_type* data() const noexcept { return __begin_ == nullptr ? nullptr : std::addressof(*__begin_); }
 
     //
     // [vector.modifiers], modifiers
@@ -351,8 +492,9 @@ public:
     _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
 
     // emplace_back 分为触发扩容与不触发扩容两个函数
+    // 两条路径都直接用转发的参数在最终位置构造，不产生额外的拷贝或移动
     template <class... _Args>
-    reference emplace_back(_Args... __args) {
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference emplace_back(_Args&&... __args) {
         if (__end_ < __cap_) {
             __construct_one_at_end(std::forward<_Args>(__args)...);
         } else {
@@ -361,9 +503,64 @@ public:
         return *(__end_ - 1);
     }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 void pop_back() { __base_destruct_at_end(__end_ - 1); }
+    // 不检查容量的 emplace_back，用于已经 reserve 过的循环中
+    // 不存在扩容分支，循环可以被编译为连续的写入
+    // Precondition: size() < capacity()
+    template <class... _Args>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference emplace_back_unchecked(_Args&&... __args) {
+        _MYSTL_ASSERT(__end_ < __cap_, "vector::emplace_back_unchecked: no spare capacity");
+        alloc_traits::construct(__alloc_, std::addressof(*__end_), std::forward<_Args>(__args)...);
+        ++__end_;
+        return *(__end_ - 1);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back_unchecked(const_reference __x) { emplace_back_unchecked(__x); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back_unchecked(value_type&& __x) { emplace_back_unchecked(std::move(__x)); }
+
+    // 作用域内的尾部插入句柄
+    // 使用局部的原生指针在 [__end_, __cap_) 中构造元素，析构时一次性提交 __end_
+    // 类似 _ConstructTransaction, 构造抛出异常时已构造的元素同样会被提交
+    // 句柄存活期间 vector 的 size() 不会更新，不应再通过 vector 本身访问或修改元素
+    class back_insert_cursor {
+    public:
+        _MYSTL_CONSTEXPR_SINCE_CXX20 explicit back_insert_cursor(vector& __v) noexcept : __v_(__v), __pos_(__v.__end_) {}
+
+        _MYSTL_CONSTEXPR_SINCE_CXX20 ~back_insert_cursor() { commit(); }
+
+        back_insert_cursor(const back_insert_cursor&)            = delete;
+        back_insert_cursor& operator=(const back_insert_cursor&) = delete;
+
+        // Precondition: remaining() > 0
+        template <class... _Args>
+        _MYSTL_CONSTEXPR_SINCE_CXX20 reference emplace_back(_Args&&... __args) {
+            _MYSTL_ASSERT(__pos_ < __v_.__cap_, "vector::back_insert_cursor: no spare capacity");
+            alloc_traits::construct(__v_.__alloc_, std::addressof(*__pos_), std::forward<_Args>(__args)...);
+            return *__pos_++;
+        }
+
+        _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back(const_reference __x) { emplace_back(__x); }
+
+        _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back(value_type&& __x) { emplace_back(std::move(__x)); }
+
+        _MYSTL_CONSTEXPR_SINCE_CXX20 size_type remaining() const noexcept { return static_cast<size_type>(__v_.__cap_ - __pos_); }
+
+        // 提前提交已构造的元素
+        _MYSTL_CONSTEXPR_SINCE_CXX20 void commit() noexcept { __v_.__end_ = __pos_; }
+
+    private:
+        vector& __v_;
+        pointer __pos_;
+    };
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void pop_back() {
+        _MYSTL_ASSERT(!empty(), "vector::pop_back called on an empty vector");
+        __base_destruct_at_end(__end_ - 1);
+        __maybe_shrink();
+    }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, const_reference __x) {
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position <= end(), "vector::insert called with an iterator not referring to this vector");
         pointer __p = __begin_ + (__position - begin());
         if (__end_ < __cap_) { // 容量足够
             if (__p == __end_) {
@@ -394,6 +591,7 @@ public:
     }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, value_type&& __x) {
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position <= end(), "vector::insert called with an iterator not referring to this vector");
         pointer __p = __begin_ + (__position - begin());
         if (__end_ < __cap_) { // 容量足够
             if (__p == __end_) {
@@ -418,6 +616,7 @@ public:
 
     //
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, size_type __n, const_reference __x) {
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position <= end(), "vector::insert called with an iterator not referring to this vector");
         pointer __p = __begin_ + (__position - begin());
         if (__n > 0) {
             if (!IS_CONSTANT_EVALUATED() && __n <= static_cast<size_type>(__cap_ - __end_)) {
@@ -503,42 +702,126 @@ public:
 #endif
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, _ForwardIterator __first, _ForwardIterator __last) {
         // 前向迭代器可以计算输入元素的数量
+        return __insert_with_size(__position, __first, __last, std::distance(__first, __last));
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, std::initializer_list<value_type> __il) {
+        return insert(__position, __il.begin(), __il.end());
+    }
+
+#if _MYSTL_CXX_VERSION >= 20
+    // C++23 的 *_range 系列
+    // 能够预先得到长度的范围 (forward_range 或 sized_range) 最多只扩容一次
+    // 连续存储的范围会被解包为原生指针，使 __unintialized_allocator_copy 对平凡类型走 memcpy
+    template <ContainerCompatibleRange<value_type> _Range>
+    constexpr void append_range(_Range&& __range) {
+        if constexpr (std::ranges::forward_range<_Range>) {
+            auto [__first, __last] = __range_bounds(__range);
+            size_type __n          = static_cast<size_type>(std::ranges::distance(__first, __last));
+            __append_with_size(std::move(__first), std::move(__last), __n);
+        } else if constexpr (std::ranges::sized_range<_Range>) {
+            __append_with_size(std::ranges::begin(__range), std::ranges::end(__range), static_cast<size_type>(std::ranges::size(__range)));
+        } else {
+            auto __last = std::ranges::end(__range);
+            for (auto __first = std::ranges::begin(__range); __first != __last; ++__first) { emplace_back(*__first); }
+        }
+    }
+
+    template <ContainerCompatibleRange<value_type> _Range>
+    constexpr iterator insert_range(const_iterator __position, _Range&& __range) {
+        if constexpr (std::ranges::forward_range<_Range>) {
+            auto [__first, __last] = __range_bounds(__range);
+            return __insert_with_size(__position, __first, __last, std::ranges::distance(__first, __last));
+        } else {
+            // 长度未知时先追加到末尾，再旋转到插入位置，避免 input_iterator 版本 insert 中的临时缓冲区
+            difference_type __offset   = __position - begin();
+            difference_type __old_size = static_cast<difference_type>(size());
+            append_range(std::forward<_Range>(__range));
+            std::rotate(__begin_ + __offset, __begin_ + __old_size, __end_);
+            return __make_iter(__begin_ + __offset);
+        }
+    }
+
+    template <ContainerCompatibleRange<value_type> _Range>
+    constexpr void assign_range(_Range&& __range) {
+        if constexpr (std::ranges::forward_range<_Range>) {
+            auto [__first, __last] = __range_bounds(__range);
+            __assign_with_size(__first, __last, std::ranges::distance(__first, __last));
+        } else {
+            __assign_with_sentinel(std::ranges::begin(__range), std::ranges::end(__range));
+        }
+    }
+
+    // 编译期已知元素数的批量操作，用于高频追加定长的小批量元素，例如解析器输出的定长记录
+    // 构造按 _Np 展开，平凡可拷贝的元素从连续存储中拷贝时使用定长的 memcpy，编译器将其展开为若干次向量读写
+    // Precondition: [__first, __first + _Np) 不是 *this 中的元素
+    template <size_type _Np, std::input_iterator _InputIterator>
+        requires std::is_constructible_v<value_type, std::iter_reference_t<_InputIterator>>
+    constexpr void append(_InputIterator __first) {
+        static_assert(_Np > 0, "vector::append<N>: N must be positive");
+        if (_Np <= static_cast<size_type>(__cap_ - __end_)) {
+            __construct_fixed<_Np>(__end_, std::move(__first));
+            __end_ += _Np;
+        } else {
+            __reallocation_buffer __buffer(__alloc_, __recommend(size() + _Np));
+            pointer __new_first = __buffer.__begin_ + size();
+            __construct_fixed<_Np>(__new_first, std::move(__first));
+            pointer __new_last = __new_first + _Np;
+            // 迁移旧元素时可能抛出异常，此时 __buffer 只负责释放内存，新构造的元素由 __guard 析构
+            auto __guard = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __new_first, __new_last));
+            __swap_reallocation_buffer(__buffer);
+            __guard.__complete();
+            __end_ += _Np;
+        }
+    }
+
+    template <size_type _Np, std::input_iterator _InputIterator>
+        requires std::is_constructible_v<value_type, std::iter_reference_t<_InputIterator>>
+    constexpr void assign(_InputIterator __first) {
+        static_assert(_Np > 0, "vector::assign<N>: N must be positive");
+        __base_destruct_at_end(__begin_);
+        if (_Np > capacity()) {
+            __vdeallocate();
+            __vallocate(__recommend(_Np));
+        }
+        __construct_fixed<_Np>(__begin_, std::move(__first));
+        __end_ = __begin_ + _Np;
+    }
+
+    template <size_type _Np, std::input_iterator _InputIterator>
+        requires std::is_constructible_v<value_type, std::iter_reference_t<_InputIterator>>
+    constexpr iterator insert(const_iterator __position, _InputIterator __first) {
+        static_assert(_Np > 0, "vector::insert<N>: N must be positive");
         difference_type __offset = __position - begin();
         pointer __p              = __begin_ + __offset;
-        size_type __n            = std::distance(__first, __last);
-        if (__n > 0) {
-            if (__n <= __cap_ - __end_) {
-                pointer __old_last = __end_;
-                size_type __old_n  = __n;
-                if (__n > static_cast<size_type>(__end_ - __p)) {              // 插入的元素超出了 __end_, 需要重新构造
-                    size_type __count_x = static_cast<size_type>(__end_ - __p);
-                    auto __m            = std::next(__first, __n - __count_x); // __first 的第 __n - __count_x 个后继
-                    __construct_at_end(__m, __last, __count_x);
-                    if (__count_x > 0) {
-                        __move_range(__p, __old_last, __p + __n);
-                        std::copy(__first, __m, __p);
-                    }
-                } else {
-                    __move_range(__p, __old_last, __p + __n);
-                    std::copy_n(__first, __n, __p);
+        if (_Np <= static_cast<size_type>(__cap_ - __end_)) {
+            // if constexpr 使非平凡类型不会实例化 memmove/memcpy 分支
+            if constexpr (__is_memcpy_source<_InputIterator>) {
+                if (!std::is_constant_evaluated()) {
+                    std::memmove(std::to_address(__p + _Np), std::to_address(__p), static_cast<size_type>(__end_ - __p) * sizeof(value_type));
+                    std::memcpy(std::to_address(__p), std::to_address(__first), _Np * sizeof(value_type));
+                    __end_ += _Np;
+                    return __make_iter(__p);
                 }
-            } else {
-                __reallocation_buffer __buffer(__alloc_, __recommend(size() + __n));
-                pointer __new_p = __buffer.__begin_ + __offset;
-                __buffer.__construct_at(__new_p, __first, __n);
-                __swap_reallocation_buffer(__buffer, __p, __n);
-                __p = __new_p;
             }
+            pointer __old_last = __end_;
+            __construct_fixed<_Np>(__end_, std::move(__first));
+            __end_ += _Np;
+            std::rotate(__p, __old_last, __end_);
+        } else {
+            __reallocation_buffer __buffer(__alloc_, __recommend(size() + _Np));
+            pointer __new_p = __buffer.__begin_ + __offset;
+            __construct_fixed<_Np>(__new_p, std::move(__first));
+            __swap_reallocation_buffer(__buffer, __p, _Np);
+            __p = __new_p;
         }
         return __make_iter(__p);
     }
-
-    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, std::initializer_list<value_type> __il) {
-        return insert(__position, __il.begin(), __il.end());
-    }
+#endif // _MYSTL_CXX_VERSION >= 20
 
     template <class... _Args>
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator emplace(const_iterator __position, _Args&&... __args) {
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position <= end(), "vector::emplace called with an iterator not referring to this vector");
         difference_type __offset = __position - begin();
         pointer __p              = __begin_ + __offset;
         if (__end_ < __cap_) {
@@ -552,7 +835,7 @@ public:
         } else {
             __reallocation_buffer __buffer(__alloc_, __recommend(size() + 1));
             pointer __new_p = __buffer.__begin_ + __offset;
-            __buffer.__construct_at(__new_p, std::forward<_Args>(__args)...);
+            __buffer.__construct_one_at(__new_p, std::forward<_Args>(__args)...);
             __swap_reallocation_buffer(__buffer, __p, 1);
             __p = __new_p;
         }
@@ -560,26 +843,54 @@ public:
     }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator erase(const_iterator __position) {
-        pointer __p = __begin_ + (__position - begin());
+        _MYSTL_ASSERT(__position != end(), "vector::erase(iterator) called with a non-dereferenceable iterator");
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position < end(), "vector::erase(iterator) called with an iterator not referring to this vector");
+        difference_type __off = __position - begin();
+        pointer __p           = __begin_ + __off;
         __base_destruct_at_end(std::move(__p + 1, __end_, __p));
-        return __make_iter(__p);
+        __maybe_shrink();
+        return begin() + __off;
     }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator erase(const_iterator __first, const_iterator __last) {
-        pointer __p = __begin_ + (__first - begin());
-        if (__first != __last) { __base_destruct_at_end(std::move(__p + (__last - __first), __end_, __p)); }
-        return __make_iter(__p);
+        _MYSTL_ASSERT(__first <= __last, "vector::erase(first, last) called with an invalid range");
+        _MYSTL_ASSERT_DEBUG(begin() <= __first && __last <= end(), "vector::erase(first, last) called with a range not in this vector");
+        difference_type __off = __first - begin();
+        pointer __p           = __begin_ + __off;
+        if (__first != __last) {
+            __base_destruct_at_end(std::move(__p + (__last - __first), __end_, __p));
+            __maybe_shrink();
+        }
+        return begin() + __off;
+    }
+
+    // 用最后一个元素覆盖被删除的元素，O(1)，不保持元素的相对顺序
+    // 返回的迭代器指向移动过来的元素，若删除的是最后一个元素则等于 end()
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator erase_unordered(const_iterator __position) {
+        _MYSTL_ASSERT(__position != end(), "vector::erase_unordered called with a non-dereferenceable iterator");
+        difference_type __off = __position - begin();
+        pointer __p           = __begin_ + __off;
+        pointer __last        = __end_ - 1;
+        if (__p != __last) { *__p = std::move(*__last); }
+        __base_destruct_at_end(__last);
+        __maybe_shrink();
+        return begin() + __off;
     }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 void clear() noexcept { __base_destruct_at_end(__begin_); }
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void clear() noexcept {
+        __base_destruct_at_end(__begin_);
+        __maybe_shrink();
+    }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void resize(size_type __size) {
         size_type __current_size = size();
         if (__current_size < __size) {
-            __reallocation_buffer __buffer(__alloc_, __size);
-            __buffer.__construct_at(__buffer.__begin_ + __current_size, __size - __current_size);
-            __swap_reallocation_buffer(__buffer);
-            __end_ = __begin_ + __size;
+            if (__size <= capacity()) {
+                __construct_at_end(__size - __current_size);
+            } else {
+                __reallocation_buffer __buffer(__alloc_, __recommend(__size));
+                __append_with_buffer(__buffer, __size - __current_size);
+            }
         } else if (__current_size > __size) {
             __base_destruct_at_end(__begin_ + __size);
         }
@@ -588,25 +899,65 @@ public:
     _MYSTL_CONSTEXPR_SINCE_CXX20 void resize(size_type __size, const_reference __x) {
         size_type __current_size = size();
         if (__current_size < __size) {
-            __reallocation_buffer __buffer(__alloc_, __size);
-            __buffer.__construct_at(__buffer.__begin_ + __current_size, __size - __current_size, __x);
-            __swap_reallocation_buffer(__buffer);
-            __end_ = __begin_ + __size;
+            if (__size <= capacity()) {
+                __construct_at_end(__size - __current_size, __x);
+            } else {
+                __reallocation_buffer __buffer(__alloc_, __recommend(__size));
+                __append_with_buffer(__buffer, __size - __current_size, __x);
+            }
         } else if (__current_size > __size) {
             __base_destruct_at_end(__begin_ + __size);
         }
     }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(vector& __other) noexcept {
-        if (!alloc_traits::propagate_on_container_swap::value && !(__alloc_ == __other.__alloc_)) {
-            assert(false && "vector::swap: allocators must compare equal when propagate_on_container_swap is false");
-        }
+        _MYSTL_ASSERT_DEBUG(alloc_traits::propagate_on_container_swap::value || __alloc_ == __other.__alloc_,
+                            "vector::swap: allocators must compare equal when propagate_on_container_swap is false");
         std::swap(__begin_, __other.__begin_);
         std::swap(__end_, __other.__end_);
         std::swap(__cap_, __other.__cap_);
         std::swap(__alloc_, __other.__alloc_);
     }
 
+    // 不抛出异常的 try_* 系列，用于 -fno-exceptions 编译的程序
+    // 超过 max_size() 或分配失败时返回对应的 vector_status 而不是抛出 length_error/bad_alloc，此时 vector 不做修改
+    // 分配器提供 try_allocate(n) 时直接使用，否则捕获 allocate 抛出的异常，-fno-exceptions 下 allocate 失败仍会终止程序
+    // 元素的构造函数抛出的异常照常向外传播，与对应的抛出版本有相同的异常保证
+    [[nodiscard]] vector_status try_reserve(size_type __n) {
+        if (__n <= capacity()) return vector_status::ok;
+        if (__n > max_size()) return vector_status::length_error;
+        __reallocation_buffer __buffer(__alloc_);
+        if (!__try_allocate_buffer(__buffer, __n)) return vector_status::out_of_memory;
+        __swap_reallocation_buffer(__buffer);
+        return vector_status::ok;
+    }
+
+    [[nodiscard]] vector_status try_push_back(const_reference __x) { return try_emplace_back(__x); }
+
+    [[nodiscard]] vector_status try_push_back(value_type&& __x) { return try_emplace_back(std::move(__x)); }
+
+    template <class... _Args>
+    [[nodiscard]] vector_status try_emplace_back(_Args&&... __args) {
+        if (__end_ < __cap_) {
+            __construct_one_at_end(std::forward<_Args>(__args)...);
+            return vector_status::ok;
+        }
+        __reallocation_buffer __buffer(__alloc_);
+        vector_status __s = __try_grow_buffer(__buffer, 1);
+        if (__s != vector_status::ok) return __s;
+        __end_ = __emplace_back_with_buffer(__buffer, std::forward<_Args>(__args)...);
+        return vector_status::ok;
+    }
+
+    [[nodiscard]] vector_status try_resize(size_type __size) { return __try_resize(__size); }
+
+    [[nodiscard]] vector_status try_resize(size_type __size, const_reference __x) { return __try_resize(__size, __x); }
+
+    // 成功时新元素位于 begin() + (__position - begin())
+    [[nodiscard]] vector_status try_insert(const_iterator __position, const_reference __x) { return __try_insert(__position, __x); }
+
+    [[nodiscard]] vector_status try_insert(const_iterator __position, value_type&& __x) { return __try_insert(__position, std::move(__x)); }
+
 private:
     // Allocate space for __n objects
     // throw length error if __n > max_size()
@@ -615,7 +966,7 @@ private:
     // Postcondition: capacity() >= __n
     // Postcondition: size() == 0
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __vallocate(size_type __n) {
-        if (__n > max_size()) { throw std::length_error("vector"); }
+        if (__n > max_size()) { mystl::__throw_length_error("vector"); }
         __begin_ = __alloc_.allocate(__n);
         __end_   = __begin_;
         __cap_   = __begin_ + __n;
@@ -623,7 +974,7 @@ private:
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __vdeallocate() noexcept {
         if (__begin_ != nullptr) {
-            clear();
+            __base_destruct_at_end(__begin_);
             __alloc_.deallocate(std::addressof(*__begin_), capacity());
             __begin_ = __end_ = __cap_ = nullptr;
         }
@@ -633,8 +984,13 @@ private:
     // 总体上将容量翻倍
     // Precondition: __new_size > capacity()
     _MYSTL_CONSTEXPR_SINCE_CXX20 inline size_type __recommend(size_type __new_size) const {
-        const size_type __ms = max_size();
-        if (__new_size > __ms) { throw std::length_error("vector"); }
+        if (__new_size > max_size()) { mystl::__throw_length_error("vector"); }
+        return __recommend_unchecked(__new_size);
+    }
+
+    // Precondition: capacity() < __new_size <= max_size()
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type __recommend_unchecked(size_type __new_size) const noexcept {
+        const size_type __ms  = max_size();
         const size_type __cap = capacity();
         if (__cap >= __ms / 2) { return __ms; }
         return std::max<size_type>(2 * __cap, __new_size);
@@ -685,6 +1041,22 @@ private:
         __tx.__pos_ = __unintialized_allocator_copy(__alloc_, std::move(__first), std::move(__last), __tx.__pos_);
     }
 
+    // 将 [__end_, __end_ + __n) 分块，由线程池中的线程分别调用 __construct(__p, __offset, __cnt)，
+    // 在 __p 开始的 __cnt 个位置构造下标为 [__offset, __offset + __cnt) 的元素，每个线程首次访问自己负责的页
+    // __construct 失败时需要自行析构已构造的部分；任意一块失败时，其余已完成的块被析构，异常重新抛出，size() 不变
+    // Precondition: size() + __n <= capacity()
+    template <class _Construct>
+    void __parallel_construct_at_end(const parallel_policy& __pol, size_type __n, _Construct __construct) {
+        pointer __first = __end_;
+        mystl::__parallel_for_chunks(
+            __pol, __n, sizeof(value_type), [&](size_t __lo, size_t __hi) { __construct(__first + __lo, __lo, __hi - __lo); },
+            [&](size_t __lo, size_t __hi) {
+                pointer __b = __first + __lo, __e = __first + __hi;
+                _AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __b, __e)();
+            });
+        __end_ += __n;
+    }
+
     // Construct one object at __end_
     // throws if construction throws
     // Precondition: size() + 1 <= capacity()
@@ -749,8 +1121,10 @@ private:
             for (; __p != __new_p; ++__p) { alloc_traits::construct(__alloc_, __p, __x); }
         }
 
+        // 在 __p 构造单个元素，与上面两个构造 __n 个元素的重载分开命名，
+        // 否则 vector<size_t> 以一个 size_t 参数构造时会匹配 __construct_at(pointer, size_type)
         template <class... _Args>
-        _MYSTL_CONSTEXPR_SINCE_CXX20 void __construct_at(pointer __p, _Args&&... __args) {
+        _MYSTL_CONSTEXPR_SINCE_CXX20 void __construct_one_at(pointer __p, _Args&&... __args) {
             alloc_traits::construct(__alloc_, __p, std::forward<_Args>(__args)...);
         }
 
@@ -778,8 +1152,27 @@ private:
         }
     };
 
+    // 扩容统计，所有扩容都经过 __swap_reallocation_buffer，未开启时为空函数
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __telemetry_reallocation(const __reallocation_buffer& __buffer) const noexcept {
+#if _MYSTL_VECTOR_TELEMETRY
+#    if _MYSTL_CXX_VERSION >= 20
+        if (std::is_constant_evaluated()) return;
+#    endif
+#    if _MYSTL_HAS_EXCEPTIONS
+        try {
+#    endif
+            mystl::__report_reallocation<value_type>(capacity(), static_cast<size_type>(__buffer.__cap_ - __buffer.__begin_), size());
+#    if _MYSTL_HAS_EXCEPTIONS
+        } catch (...) {}
+#    endif
+#else
+        (void)__buffer;
+#endif
+    }
+
     // 交换缓冲区与 vector 的数据
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __swap_reallocation_buffer(__reallocation_buffer& __buffer) {
+        __telemetry_reallocation(__buffer);
         __uninitialized_allocator_relocate(__alloc_, __begin_, __end_, __buffer.__begin_);
         __buffer.__end_ += size();
         std::swap(__begin_, __buffer.__begin_);
@@ -792,6 +1185,7 @@ private:
     // 的 [__new_begin, __new_p] 和 [__new_p + __n, __new_end_)
     // 缓冲区的 size() 会被设置为 vector.size() + __n
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __swap_reallocation_buffer(__reallocation_buffer& __buffer, pointer __p, size_type __n) {
+        __telemetry_reallocation(__buffer);
         pointer _new_p = __buffer.__begin_ + (__p - __begin_);
         // 先交换 [__p, __end_) 到 [__new_p + __n, __new_end_)
         __uninitialized_allocator_relocate(__alloc_, __p, __end_, _new_p + __n);
@@ -810,10 +1204,14 @@ private:
     // Postcondition: capacity() = __recommend(old size() + 1)
     template <class... _Args>
     _MYSTL_CONSTEXPR_SINCE_CXX20 pointer __emplace_back_slow_path(_Args&&... __args) {
-        // 计算新容量
-        size_type __new_cap = __recommend(size() + 1);
-        // 创建缓冲区
-        __reallocation_buffer __buffer(__alloc_, __new_cap);
+        // 计算新容量并创建缓冲区
+        __reallocation_buffer __buffer(__alloc_, __recommend(size() + 1));
+        return __emplace_back_with_buffer(__buffer, std::forward<_Args>(__args)...);
+    }
+
+    // Precondition: __buffer 的容量大于 size()
+    template <class... _Args>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 pointer __emplace_back_with_buffer(__reallocation_buffer& __buffer, _Args&&... __args) {
         // 在缓冲区对应位置构造元素
         alloc_traits::construct(__alloc_, std::addressof(*(__buffer.__begin_ + size())), std::forward<_Args>(__args)...);
         ++__buffer.__end_;
@@ -822,6 +1220,93 @@ private:
         return __end_;
     }
 
+    // 在缓冲区中 size() 之后的位置构造 __n 个元素，再迁移原有元素
+    // 先构造再迁移，__x 是 vector 中的元素时仍然有效
+    // Precondition: __buffer 的容量不小于 size() + __n
+    template <class... _Args>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __append_with_buffer(__reallocation_buffer& __buffer, size_type __n, const _Args&... __x) {
+        __buffer.__construct_at(__buffer.__begin_ + size(), __n, __x...);
+        __swap_reallocation_buffer(__buffer);
+        __end_ += __n;
+    }
+
+    // 不抛出 bad_alloc 的分配，失败时返回空指针
+    pointer __try_allocate(size_type __n) noexcept {
+        if constexpr (__has_try_allocate<allocator_type>::value) {
+            return __alloc_.try_allocate(__n);
+        } else {
+#if _MYSTL_HAS_EXCEPTIONS
+            try {
+                return alloc_traits::allocate(__alloc_, __n);
+            } catch (const std::bad_alloc&) { return nullptr; }
+#else
+            return alloc_traits::allocate(__alloc_, __n);
+#endif
+        }
+    }
+
+    // Precondition: __buffer 为空
+    bool __try_allocate_buffer(__reallocation_buffer& __buffer, size_type __cap) noexcept {
+        pointer __p = __try_allocate(__cap);
+        if (__p == nullptr) return false;
+        __buffer.__begin_ = __buffer.__end_ = __p;
+        __buffer.__cap_                     = __p + __cap;
+        return true;
+    }
+
+    // 为追加 __n 个元素按 __recommend 获取缓冲区
+    // Precondition: __buffer 为空，size() + __n > capacity()
+    vector_status __try_grow_buffer(__reallocation_buffer& __buffer, size_type __n) noexcept {
+        if (__n > max_size() - size()) return vector_status::length_error;
+        if (!__try_allocate_buffer(__buffer, __recommend_unchecked(size() + __n))) return vector_status::out_of_memory;
+        return vector_status::ok;
+    }
+
+    template <class... _Args>
+    vector_status __try_resize(size_type __size, const _Args&... __x) {
+        size_type __current_size = size();
+        if (__current_size < __size) {
+            if (__size <= capacity()) {
+                __construct_at_end(__size - __current_size, __x...);
+            } else {
+                __reallocation_buffer __buffer(__alloc_);
+                vector_status __s = __try_grow_buffer(__buffer, __size - __current_size);
+                if (__s != vector_status::ok) return __s;
+                __append_with_buffer(__buffer, __size - __current_size, __x...);
+            }
+        } else if (__current_size > __size) {
+            __base_destruct_at_end(__begin_ + __size);
+        }
+        return vector_status::ok;
+    }
+
+    template <class _Up>
+    vector_status __try_insert(const_iterator __position, _Up&& __x) {
+        if (__end_ < __cap_) {
+            insert(__position, std::forward<_Up>(__x));
+            return vector_status::ok;
+        }
+        _MYSTL_ASSERT_DEBUG(begin() <= __position && __position <= end(), "vector::try_insert called with an iterator not referring to this vector");
+        __reallocation_buffer __buffer(__alloc_);
+        vector_status __s = __try_grow_buffer(__buffer, 1);
+        if (__s != vector_status::ok) return __s;
+        difference_type __offset = __position - begin();
+        __buffer.__construct_one_at(__buffer.__begin_ + __offset, std::forward<_Up>(__x));
+        __swap_reallocation_buffer(__buffer, __begin_ + __offset, 1);
+        return vector_status::ok;
+    }
+
+    // 开启 _MYSTL_VECTOR_SHRINK_POLICY 时按 vector_shrink_policy 收缩，收缩使所有迭代器失效
+    // 未开启时为空函数
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __maybe_shrink() noexcept {
+#if _MYSTL_VECTOR_SHRINK_POLICY
+        vector_shrink_policy __p;
+        if (!std::is_constant_evaluated()) { __p = mystl::get_vector_shrink_policy(); }
+        size_type __target = mystl::__shrink_target(size(), capacity(), sizeof(value_type), __p);
+        if (__target < capacity()) { trim(__target); }
+#endif
+    }
+
     // 将 vector 中元素从末尾开始析构，一直到 __new_last处
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __base_destruct_at_end(pointer __new_last) noexcept {
         if constexpr (!std::is_trivially_destructible_v<value_type>) {
@@ -849,6 +1334,99 @@ private:
         __guard.__complete();
     }
 
+    // 在末尾追加 [__first, __last) 中的 __n 个元素
+    // 容量不足时只扩容一次：先在新缓冲区的对应位置构造新元素，再迁移原有元素
+    // 先构造再迁移，因此 [__first, __last) 可以是 vector 自身的元素
+    template <class _InputIterator, class _Sentinel>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __append_with_size(_InputIterator __first, _Sentinel __last, size_type __n) {
+        if (__n == 0) return;
+        if (__n <= static_cast<size_type>(__cap_ - __end_)) {
+            __construct_at_end(std::move(__first), std::move(__last), __n);
+        } else {
+            __reallocation_buffer __buffer(__alloc_, __recommend(size() + __n));
+            __unintialized_allocator_copy(__alloc_, std::move(__first), std::move(__last), __buffer.__begin_ + size());
+            __swap_reallocation_buffer(__buffer, __end_, __n);
+        }
+    }
+
+    // 在 __position 处插入 [__first, __last) 中的 __n 个元素
+    template <class _ForwardIterator, class _Sentinel>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator __insert_with_size(const_iterator __position, _ForwardIterator __first, _Sentinel __last,
+                                                             difference_type __n) {
+        difference_type __offset = __position - begin();
+        pointer __p              = __begin_ + __offset;
+        if (__n > 0) {
+            if (__n <= __cap_ - __end_) {
+                pointer __old_last      = __end_;
+                difference_type __old_n = __n;
+                difference_type __dx    = __end_ - __p;
+                _ForwardIterator __m    = std::next(__first, __n);
+                if (__n > __dx) { // 插入的元素超出了 __end_, 超出的部分 [__first + __dx, __last) 直接在末尾构造
+                    __m = std::next(__first, __dx);
+                    __construct_at_end(__m, __last, static_cast<size_type>(__n - __dx));
+                    __n = __dx;
+                }
+                if (__n > 0) {
+                    __move_range(__p, __old_last, __p + __old_n);
+                    std::copy(__first, __m, __p);
+                }
+            } else {
+                __reallocation_buffer __buffer(__alloc_, __recommend(size() + __n));
+                pointer __new_p = __buffer.__begin_ + __offset;
+                __unintialized_allocator_copy(__alloc_, std::move(__first), std::move(__last), __new_p);
+                __swap_reallocation_buffer(__buffer, __p, __n);
+                __p = __new_p;
+            }
+        }
+        return __make_iter(__p);
+    }
+
+#if _MYSTL_CXX_VERSION >= 20
+    // 将 forward_range 转为一对同类型的迭代器
+    // 连续存储且已知长度的范围解包为原生指针
+    template <class _Range>
+    static constexpr auto __range_bounds(_Range& __range) {
+        if constexpr (std::ranges::contiguous_range<_Range> && std::ranges::sized_range<_Range>) {
+            auto __first = std::ranges::data(__range);
+            return std::pair(__first, __first + std::ranges::size(__range));
+        } else if constexpr (std::ranges::common_range<_Range>) {
+            return std::pair(std::ranges::begin(__range), std::ranges::end(__range));
+        } else {
+            auto __first = std::ranges::begin(__range);
+            return std::pair(__first, std::ranges::next(__first, std::ranges::end(__range)));
+        }
+    }
+
+    // 在 __p 开始的 _Np 个未初始化位置依次构造 *__first, *++__first, ...
+    // 失败时析构已构造的元素
+    template <size_type _Np, class _InputIterator>
+    constexpr void __construct_fixed(pointer __p, _InputIterator __first) {
+        if constexpr (__is_memcpy_source<_InputIterator>) {
+            if (!std::is_constant_evaluated()) {
+                std::memcpy(std::to_address(__p), std::to_address(__first), _Np * sizeof(value_type));
+                return;
+            }
+        }
+        pointer __pos = __p;
+        auto __guard  = mystl::__make_exception_guard(_AllocatorDestroyRangeReverse<allocator_type, pointer>(__alloc_, __p, __pos));
+        [&]<size_t... _Is>(std::index_sequence<_Is...>) {
+            ((alloc_traits::construct(__alloc_, std::to_address(__pos), *__first), ++__first, ++__pos, void(_Is)), ...);
+        }(std::make_index_sequence<_Np>());
+        __guard.__complete();
+    }
+#endif // _MYSTL_CXX_VERSION >= 20
+
+    // 可以用 memcpy 从 _Iter 拷贝 value_type：连续存储、元素类型相同且平凡可拷贝
+#if _MYSTL_CXX_VERSION >= 20
+    template <class _Iter>
+    static constexpr bool __is_memcpy_source = std::contiguous_iterator<_Iter> && std::is_same_v<std::iter_value_t<_Iter>, value_type> &&
+                                               std::is_trivially_copyable_v<value_type>;
+#else
+    template <class _Iter>
+    static constexpr bool __is_memcpy_source = std::is_pointer_v<_Iter> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<_Iter>>, value_type> &&
+                                               std::is_trivially_copyable_v<value_type>;
+#endif
+
     _MYSTL_CONSTEXPR_SINCE_CXX20 iterator __make_iter(pointer __p) noexcept { return iterator(__p); }
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 const_iterator __make_iter(const_pointer __p) const noexcept { return const_iterator(__p); }
@@ -880,9 +1458,21 @@ private:
         }
     }
 
+    // 容量足够时复用已有存储：已有元素拷贝赋值，超出部分在尾部容量中构造，多余的元素析构
+    // 平凡可拷贝的元素从连续存储中拷贝时直接 memcpy 全部 __n 个元素
+    // Precondition: [__first, __last) 不是 *this 中的元素
     template <class _ForwardIterator, class _Sentinel>
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __assign_with_size(_ForwardIterator __first, _Sentinel __last, difference_type __n) {
         size_type __new_size = static_cast<size_type>(__n);
+        if constexpr (__is_memcpy_source<_ForwardIterator>) {
+            if (!IS_CONSTANT_EVALUATED() && __new_size <= capacity()) {
+                if (__new_size != 0) {
+                    mystl::__bulk_memcpy(std::addressof(*__begin_), std::addressof(*__first), __new_size * sizeof(value_type));
+                }
+                __end_ = __begin_ + __new_size;
+                return;
+            }
+        }
         if (__new_size <= capacity()) {
             if (__new_size <= size()) {
                 std::copy(std::move(__first), std::move(__last), __begin_);
@@ -926,7 +1516,7 @@ private:
 
     _MYSTL_CONSTEXPR_SINCE_CXX20 void __move_assign_alloc(vector& __x, std::false_type) noexcept {}
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 void __move_assign(vector& __x, std::true_type) noexcept(std::is_nothrow_move_assignable<allocator_type>::type) {
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __move_assign(vector& __x, std::true_type) noexcept(std::is_nothrow_move_assignable<allocator_type>::value) {
         __vdeallocate();
         __move_assign_alloc(__x);
         __begin_     = __x.__begin_;
@@ -935,11 +1525,11 @@ private:
         __x.__begin_ = __x.__end_ = __x.__cap_ = nullptr;
     }
 
-    _MYSTL_CONSTEXPR_SINCE_CXX20 void __move__assign(vector& __x, std::false_type) noexcept(alloc_traits::is_always_equal::value) {
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __move_assign(vector& __x, std::false_type) noexcept(alloc_traits::is_always_equal::value) {
         if (__alloc_ != __x.__alloc_) {
             assign(__x.begin(), __x.end());
         } else {
-            __move__assign(__x, std::true_type());
+            __move_assign(__x, std::true_type());
         }
     }
 };
@@ -955,6 +1545,44 @@ template <class _InputIterator, class _Alloc = allocator<typename iterator_trait
           typename = std::enable_if_t<mystl::is_allocator<_Alloc>::value>>
 vector(_InputIterator, _InputIterator, _Alloc) -> vector<typename iterator_traits<_InputIterator>::value_type, _Alloc>;
 
+// 将 [__first, __last) 中不满足 __pred 的元素按顺序移动到前部，返回新的末尾
+// 平凡可拷贝的类型每个元素都无条件写入 __out，再根据谓词的结果决定 __out 是否前进，循环中不含分支，编译器可以将其向量化
+template <class _Tp, class _Predicate>
+_MYSTL_CONSTEXPR_SINCE_CXX20 _Tp* __compact_if(_Tp* __first, _Tp* __last, _Predicate& __pred) {
+    if constexpr (std::is_trivially_copyable_v<_Tp> && std::is_trivially_copy_assignable_v<_Tp>) {
+        _Tp* __out = __first;
+        for (; __first != __last; ++__first) {
+            _Tp __x = *__first;
+            *__out  = __x;
+            __out += !static_cast<bool>(__pred(__x));
+        }
+        return __out;
+    } else {
+        return std::remove_if(__first, __last, std::ref(__pred));
+    }
+}
+
+// 删除所有满足 __pred 的元素，只压缩一遍，尾部的元素一次性析构，返回删除的元素个数
+template <class _Tp, class _Allocator, class _Predicate>
+_MYSTL_CONSTEXPR_SINCE_CXX20 typename vector<_Tp, _Allocator>::size_type erase_if(vector<_Tp, _Allocator>& __c, _Predicate __pred) {
+    typename vector<_Tp, _Allocator>::size_type __old_size = __c.size();
+    if (__old_size == 0) return 0;
+    if constexpr (std::is_same_v<_Tp, bool>) {
+        __c.erase(std::remove_if(__c.begin(), __c.end(), std::ref(__pred)), __c.end());
+    } else {
+        _Tp* __new_last = mystl::__compact_if(__c.data(), __c.data() + __old_size, __pred);
+        __c.erase(__c.begin() + (__new_last - __c.data()), __c.end());
+    }
+    return __old_size - __c.size();
+}
+
+template <class _Tp, class _Allocator, class _Up>
+_MYSTL_CONSTEXPR_SINCE_CXX20 typename vector<_Tp, _Allocator>::size_type erase(vector<_Tp, _Allocator>& __c, const _Up& __value) {
+    return mystl::erase_if(__c, [&](const auto& __e) { return __e == __value; });
+}
+
 _MYSTL_END_NAMESPACE_MYSTL
 
+#include <vector_bool.h>
+
 #endif // _MYSTL_VECTOR_H
\ No newline at end of file
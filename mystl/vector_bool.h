@@ -0,0 +1,569 @@
+//===-------------------------------------===//
+//
+// vector_bool.h
+// vector<bool> 的特化，每个元素只占用一位
+// 由 vector.h 引入，不需要单独包含
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_VECTOR_BOOL_H
+#define _MYSTL_VECTOR_BOOL_H
+
+#include <algorithm>
+#include <allocator.h>
+#include <bit_reference.h>
+#include <climits>
+#include <config.h>
+#include <hardening.h>
+#include <initializer_list>
+#include <iterator.h>
+#include <limits>
+#include <stdexcept>
+#include <throw.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+template <typename _Tp, class _Allocator>
+class vector;
+
+// 元素按位存储在 __storage_type 类型的字中，第 i 个元素为第 i / __bits_per_word 个字的第 i % __bits_per_word 位
+// 不变式：最后一个字中超出 size() 的位始终为 0，因此 count(), find_first() 与比较运算可以直接按字处理
+// 按字的循环 (count, 位运算, set/reset/flip) 不含分支，编译器可以将其向量化，popcount 使用硬件指令
+template <class _Allocator>
+class vector<bool, _Allocator> {
+public:
+    using value_type             = bool;
+    using allocator_type         = _Allocator;
+    using alloc_traits           = std::allocator_traits<allocator_type>;
+    using size_type              = typename alloc_traits::size_type;
+    using difference_type        = typename alloc_traits::difference_type;
+    using __storage_type         = size_type;
+    using __storage_allocator    = typename alloc_traits::template rebind_alloc<__storage_type>;
+    using __storage_traits       = std::allocator_traits<__storage_allocator>;
+    using __storage_pointer      = typename __storage_traits::pointer;
+    using reference              = __bit_reference<__storage_pointer>;
+    using const_reference        = bool;
+    using iterator               = __bit_iterator<__storage_pointer, false>;
+    using const_iterator         = __bit_iterator<__storage_pointer, true>;
+    using reverse_iterator       = mystl::reverse_iterator<iterator>;
+    using const_reverse_iterator = mystl::reverse_iterator<const_iterator>;
+
+    static_assert(std::is_same_v<typename allocator_type::value_type, value_type>, "Allocator::value_type must be same type as value_type");
+
+    static constexpr unsigned __bits_per_word = sizeof(__storage_type) * CHAR_BIT;
+    static constexpr size_type npos           = static_cast<size_type>(-1);
+
+private:
+    __storage_pointer __begin_ = nullptr;
+    size_type __size_          = 0; // 元素 (位) 的数量
+    size_type __cap_           = 0; // 已分配的字的数量
+    __storage_allocator __alloc_;
+
+public:
+    //
+    // construct/copy/destroy
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector() noexcept(std::is_nothrow_default_constructible<__storage_allocator>::value) {}
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 explicit vector(const allocator_type& __a) noexcept : __alloc_(__a) {}
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 explicit vector(size_type __n, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        resize(__n, false);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector(size_type __n, const value_type& __x, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        resize(__n, __x);
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector(_InputIterator __first, _InputIterator __last, const allocator_type& __a = allocator_type())
+        : __alloc_(__a) {
+        assign(__first, __last);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector(std::initializer_list<value_type> __il, const allocator_type& __a = allocator_type()) : __alloc_(__a) {
+        assign(__il.begin(), __il.end());
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector(const vector& __other)
+        : __alloc_(__storage_traits::select_on_container_copy_construction(__other.__alloc_)) {
+        __copy_words_from(__other);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector(vector&& __other) noexcept
+        : __begin_(__other.__begin_), __size_(__other.__size_), __cap_(__other.__cap_), __alloc_(std::move(__other.__alloc_)) {
+        __other.__begin_ = nullptr;
+        __other.__size_ = __other.__cap_ = 0;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 ~vector() { __vdeallocate(); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator=(const vector& __other) {
+        if (this != std::addressof(__other)) {
+            if constexpr (__storage_traits::propagate_on_container_copy_assignment::value) {
+                if (__alloc_ != __other.__alloc_) { __vdeallocate(); }
+                __alloc_ = __other.__alloc_;
+            }
+            __copy_words_from(__other);
+        }
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator=(vector&& __other) noexcept {
+        if (this != std::addressof(__other)) {
+            __vdeallocate();
+            if constexpr (__storage_traits::propagate_on_container_move_assignment::value) { __alloc_ = std::move(__other.__alloc_); }
+            __begin_         = __other.__begin_;
+            __size_          = __other.__size_;
+            __cap_           = __other.__cap_;
+            __other.__begin_ = nullptr;
+            __other.__size_ = __other.__cap_ = 0;
+        }
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator=(std::initializer_list<value_type> __il) {
+        assign(__il.begin(), __il.end());
+        return *this;
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void assign(_InputIterator __first, _InputIterator __last) {
+        clear();
+        if constexpr (mystl::is_based_on_forward_iterator<_InputIterator>::value) {
+            size_type __n = static_cast<size_type>(std::distance(__first, __last));
+            reserve(__n);
+            __size_ = __n;
+            __clear_tail();
+            std::copy(__first, __last, begin());
+        } else {
+            for (; __first != __last; ++__first) { push_back(*__first); }
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void assign(size_type __n, const value_type& __x) {
+        clear();
+        resize(__n, __x);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void assign(std::initializer_list<value_type> __il) { assign(__il.begin(), __il.end()); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 allocator_type get_allocator() const noexcept { return allocator_type(__alloc_); }
+
+    //
+    // Iterators
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator begin() noexcept { return iterator(__begin_, 0); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_iterator begin() const noexcept { return const_iterator(__begin_, 0); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator end() noexcept { return begin() + static_cast<difference_type>(__size_); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_iterator end() const noexcept { return begin() + static_cast<difference_type>(__size_); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_iterator cbegin() const noexcept { return begin(); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_iterator cend() const noexcept { return end(); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reverse_iterator crbegin() const noexcept { return rbegin(); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reverse_iterator crend() const noexcept { return rend(); }
+
+    //
+    // capacity
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type size() const noexcept { return __size_; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type capacity() const noexcept { return __cap_ * __bits_per_word; }
+
+    [[nodiscard]] _MYSTL_CONSTEXPR_SINCE_CXX20 bool empty() const noexcept { return __size_ == 0; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type max_size() const noexcept {
+        const size_type __amax = __storage_traits::max_size(__alloc_);
+        const size_type __nmax = std::numeric_limits<difference_type>::max();
+        if (__nmax / __bits_per_word <= __amax) { return __nmax; }
+        return __amax * __bits_per_word;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void reserve(size_type __n) {
+        if (__n > capacity()) {
+            if (__n > max_size()) { mystl::__throw_length_error("vector<bool>"); }
+            __reallocate(__words(__n));
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void shrink_to_fit() noexcept {
+        if (__words(__size_) < __cap_) {
+#if _MYSTL_HAS_EXCEPTIONS
+            try {
+#endif
+                __reallocate(__words(__size_));
+#if _MYSTL_HAS_EXCEPTIONS
+            } catch (...) {}
+#endif
+        }
+    }
+
+    //
+    // element access
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference operator[](size_type __n) noexcept { return reference(__begin_ + __n / __bits_per_word, __mask(__n)); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference operator[](size_type __n) const noexcept { return test(__n); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference at(size_type __n) {
+        if (__n >= size()) { mystl::__throw_out_of_range("vector<bool>"); }
+        return (*this)[__n];
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference at(size_type __n) const {
+        if (__n >= size()) { mystl::__throw_out_of_range("vector<bool>"); }
+        return (*this)[__n];
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference front() noexcept { return (*this)[0]; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference front() const noexcept { return (*this)[0]; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference back() noexcept { return (*this)[__size_ - 1]; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const_reference back() const noexcept { return (*this)[__size_ - 1]; }
+
+    // 底层按字存储的数据，共 __words(size()) 个字
+    _MYSTL_CONSTEXPR_SINCE_CXX20 const __storage_type* words() const noexcept { return __raw(__begin_); }
+
+    //
+    // modifiers
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void push_back(const value_type& __x) {
+        if (__size_ == capacity()) { __reallocate(__words(__recommend(__size_ + 1))); }
+        // 新的字中可能残留旧数据，先清零
+        if (__size_ % __bits_per_word == 0) { __begin_[__size_ / __bits_per_word] = 0; }
+        ++__size_;
+        set(__size_ - 1, __x);
+    }
+
+    template <class... _Args>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 reference emplace_back(_Args&&... __args) {
+        push_back(value_type(std::forward<_Args>(__args)...));
+        return back();
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void pop_back() noexcept {
+        --__size_;
+        __clear_tail();
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, const value_type& __x) { return insert(__position, 1, __x); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, size_type __n, const value_type& __x) {
+        size_type __offset = static_cast<size_type>(__position - cbegin());
+        __make_gap(__offset, __n);
+        __fill(__offset, __n, __x);
+        return begin() + static_cast<difference_type>(__offset);
+    }
+
+#if _MYSTL_CXX_VERSION <= 17
+    template <class _InputIterator,
+              std::enable_if_t<mystl::is_based_on_input_iterator<_InputIterator>::value &&
+                                   std::is_constructible<value_type, typename iterator_traits<_InputIterator>::reference>::value,
+                               int> = 0>
+#else
+    template <BasedOnInputIterator _InputIterator,
+              std::enable_if_t<std::is_constructible_v<value_type, typename iterator_traits<_InputIterator>::reference>, int> = 0>
+#endif
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, _InputIterator __first, _InputIterator __last) {
+        size_type __offset = static_cast<size_type>(__position - cbegin());
+        if constexpr (mystl::is_based_on_forward_iterator<_InputIterator>::value) {
+            size_type __n = static_cast<size_type>(std::distance(__first, __last));
+            __make_gap(__offset, __n);
+            std::copy(__first, __last, begin() + static_cast<difference_type>(__offset));
+        } else {
+            // 长度未知时先构造到临时的 vector 中
+            vector __tmp(__first, __last, get_allocator());
+            return insert(cbegin() + static_cast<difference_type>(__offset), __tmp.cbegin(), __tmp.cend());
+        }
+        return begin() + static_cast<difference_type>(__offset);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator insert(const_iterator __position, std::initializer_list<value_type> __il) {
+        return insert(__position, __il.begin(), __il.end());
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator erase(const_iterator __position) { return erase(__position, __position + 1); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 iterator erase(const_iterator __first, const_iterator __last) {
+        iterator __p = begin() + (__first - cbegin());
+        if (__first != __last) {
+            std::copy(__last, cend(), __p);
+            __size_ -= static_cast<size_type>(__last - __first);
+            __clear_tail();
+        }
+        return __p;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void clear() noexcept { __size_ = 0; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void resize(size_type __size, value_type __x = false) {
+        if (__size > __size_) {
+            if (__size > capacity()) { __reallocate(__words(__recommend(__size))); }
+            size_type __old_size = __size_;
+            __size_              = __size;
+            __fill(__old_size, __size - __old_size, __x);
+            __clear_tail();
+        } else {
+            __size_ = __size;
+            __clear_tail();
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(vector& __other) noexcept {
+        _MYSTL_ASSERT_DEBUG(__storage_traits::propagate_on_container_swap::value || __alloc_ == __other.__alloc_,
+                            "vector<bool>::swap: allocators must compare equal when propagate_on_container_swap is false");
+        std::swap(__begin_, __other.__begin_);
+        std::swap(__size_, __other.__size_);
+        std::swap(__cap_, __other.__cap_);
+        std::swap(__alloc_, __other.__alloc_);
+    }
+
+    static _MYSTL_CONSTEXPR_SINCE_CXX20 void swap(reference __x, reference __y) noexcept { mystl::swap(__x, __y); }
+
+    //
+    // 按位操作
+    //
+    _MYSTL_CONSTEXPR_SINCE_CXX20 bool test(size_type __n) const noexcept { return static_cast<bool>(__begin_[__n / __bits_per_word] & __mask(__n)); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void set(size_type __n, bool __x = true) noexcept {
+        if (__x) {
+            __begin_[__n / __bits_per_word] |= __mask(__n);
+        } else {
+            __begin_[__n / __bits_per_word] &= ~__mask(__n);
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void reset(size_type __n) noexcept { set(__n, false); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void flip(size_type __n) noexcept { __begin_[__n / __bits_per_word] ^= __mask(__n); }
+
+    // 将所有位置为 1
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void set() noexcept {
+        std::fill_n(__begin_, __words(__size_), ~__storage_type(0));
+        __clear_tail();
+    }
+
+    // 将所有位置为 0
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void reset() noexcept { std::fill_n(__begin_, __words(__size_), __storage_type(0)); }
+
+    // 翻转所有位
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void flip() noexcept {
+        __storage_pointer __p = __begin_;
+        for (size_type __i = 0, __n = __words(__size_); __i < __n; ++__i) { __p[__i] = ~__p[__i]; }
+        __clear_tail();
+    }
+
+    // 为 1 的位的数量
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type count() const noexcept {
+        size_type __c = 0;
+        for (size_type __i = 0, __n = __words(__size_); __i < __n; ++__i) { __c += mystl::__popcount(__begin_[__i]); }
+        return __c;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 bool any() const noexcept { return find_first() != npos; }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 bool none() const noexcept { return !any(); }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 bool all() const noexcept { return count() == __size_; }
+
+    // 第一个为 1 的位的下标，不存在时返回 npos
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type find_first() const noexcept { return __find_from(0); }
+
+    // __pos 之后 (不包含 __pos) 第一个为 1 的位的下标，不存在时返回 npos
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type find_next(size_type __pos) const noexcept {
+        if (__pos == npos || __pos + 1 >= __size_) { return npos; }
+        return __find_from(__pos + 1);
+    }
+
+    // 按字的位运算
+    // Precondition: size() == __other.size()
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator&=(const vector& __other) noexcept {
+        _MYSTL_ASSERT_DEBUG(__size_ == __other.__size_, "vector<bool>: bitwise operations require equal sizes");
+        __word_op(__other, [](__storage_type __a, __storage_type __b) { return __a & __b; });
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator|=(const vector& __other) noexcept {
+        _MYSTL_ASSERT_DEBUG(__size_ == __other.__size_, "vector<bool>: bitwise operations require equal sizes");
+        __word_op(__other, [](__storage_type __a, __storage_type __b) { return __a | __b; });
+        return *this;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& operator^=(const vector& __other) noexcept {
+        _MYSTL_ASSERT_DEBUG(__size_ == __other.__size_, "vector<bool>: bitwise operations require equal sizes");
+        __word_op(__other, [](__storage_type __a, __storage_type __b) { return __a ^ __b; });
+        return *this;
+    }
+
+    // 从 *this 中去掉 __other 中为 1 的位, 即 *this &= ~__other
+    _MYSTL_CONSTEXPR_SINCE_CXX20 vector& and_not(const vector& __other) noexcept {
+        _MYSTL_ASSERT_DEBUG(__size_ == __other.__size_, "vector<bool>: bitwise operations require equal sizes");
+        __word_op(__other, [](__storage_type __a, __storage_type __b) { return __a & ~__b; });
+        return *this;
+    }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator==(const vector& __x, const vector& __y) noexcept {
+        return __x.__size_ == __y.__size_ && std::equal(__x.__begin_, __x.__begin_ + __words(__x.__size_), __y.__begin_);
+    }
+
+    friend _MYSTL_CONSTEXPR_SINCE_CXX20 bool operator!=(const vector& __x, const vector& __y) noexcept { return !(__x == __y); }
+
+private:
+    static _MYSTL_CONSTEXPR_SINCE_CXX20 __storage_type* __raw(__storage_pointer __p) noexcept { return __p ? std::addressof(*__p) : nullptr; }
+
+    // 存放 __n 位需要的字数
+    static _MYSTL_CONSTEXPR_SINCE_CXX20 size_type __words(size_type __n) noexcept { return (__n + __bits_per_word - 1) / __bits_per_word; }
+
+    static _MYSTL_CONSTEXPR_SINCE_CXX20 __storage_type __mask(size_type __n) noexcept {
+        return __storage_type(1) << (__n % __bits_per_word);
+    }
+
+    // 容量变化逻辑，与 vector 相同，总体上将容量翻倍
+    // Precondition: __new_size > capacity()
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type __recommend(size_type __new_size) const {
+        const size_type __ms = max_size();
+        if (__new_size > __ms) { mystl::__throw_length_error("vector<bool>"); }
+        const size_type __cap = capacity();
+        if (__cap >= __ms / 2) { return __ms; }
+        return std::max<size_type>(2 * __cap, (__new_size + __bits_per_word - 1) & ~size_type(__bits_per_word - 1));
+    }
+
+    // 将存储迁移到 __n 个字的新空间中
+    // Precondition: __n >= __words(size())
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __reallocate(size_type __n) {
+        __storage_pointer __new_begin = nullptr;
+        if (__n > 0) {
+            __new_begin = __storage_traits::allocate(__alloc_, __n);
+            std::copy_n(__begin_, __words(__size_), __new_begin);
+        }
+        if (__begin_ != nullptr) { __storage_traits::deallocate(__alloc_, __begin_, __cap_); }
+        __begin_ = __new_begin;
+        __cap_   = __n;
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __vdeallocate() noexcept {
+        if (__begin_ != nullptr) {
+            __storage_traits::deallocate(__alloc_, __begin_, __cap_);
+            __begin_ = nullptr;
+            __size_ = __cap_ = 0;
+        }
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __copy_words_from(const vector& __other) {
+        size_type __n = __words(__other.__size_);
+        if (__n > __cap_) {
+            __vdeallocate();
+            __reallocate(__n);
+        }
+        std::copy_n(__other.__begin_, __n, __begin_);
+        __size_ = __other.__size_;
+    }
+
+    // 将最后一个字中超出 size() 的位清零，维持不变式
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __clear_tail() noexcept {
+        size_type __tail = __size_ % __bits_per_word;
+        if (__tail != 0) { __begin_[__size_ / __bits_per_word] &= (__storage_type(1) << __tail) - 1; }
+    }
+
+    // 将 [__pos, __pos + __n) 中的位置为 __x，中间完整的字整体写入
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __fill(size_type __pos, size_type __n, bool __x) noexcept {
+        if (__n == 0) return;
+        size_type __first_word = __pos / __bits_per_word;
+        size_type __last_word  = (__pos + __n - 1) / __bits_per_word;
+        __storage_type __head  = ~__storage_type(0) << (__pos % __bits_per_word);
+        __storage_type __tail  = ~__storage_type(0) >> (__bits_per_word - 1 - (__pos + __n - 1) % __bits_per_word);
+        if (__first_word == __last_word) {
+            __fill_word(__first_word, __head & __tail, __x);
+            return;
+        }
+        __fill_word(__first_word, __head, __x);
+        std::fill(__begin_ + __first_word + 1, __begin_ + __last_word, __x ? ~__storage_type(0) : __storage_type(0));
+        __fill_word(__last_word, __tail, __x);
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __fill_word(size_type __i, __storage_type __m, bool __x) noexcept {
+        if (__x) {
+            __begin_[__i] |= __m;
+        } else {
+            __begin_[__i] &= ~__m;
+        }
+    }
+
+    // 在 __offset 处留出 __n 位，之后的元素向后移动
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __make_gap(size_type __offset, size_type __n) {
+        if (__n == 0) return;
+        size_type __old_size = __size_;
+        resize(__size_ + __n);
+        std::copy_backward(begin() + static_cast<difference_type>(__offset), begin() + static_cast<difference_type>(__old_size), end());
+    }
+
+    _MYSTL_CONSTEXPR_SINCE_CXX20 size_type __find_from(size_type __pos) const noexcept {
+        size_type __n = __words(__size_);
+        size_type __i = __pos / __bits_per_word;
+        if (__i >= __n) { return npos; }
+        __storage_type __w = __begin_[__i] & (~__storage_type(0) << (__pos % __bits_per_word));
+        while (true) {
+            if (__w != 0) { return __i * __bits_per_word + mystl::__countr_zero(__w); }
+            if (++__i == __n) { return npos; }
+            __w = __begin_[__i];
+        }
+    }
+
+    // 对每个字执行 __op，不含分支，编译器可以将其向量化
+    template <class _Op>
+    _MYSTL_CONSTEXPR_SINCE_CXX20 void __word_op(const vector& __other, _Op __op) noexcept {
+        __storage_type* __a       = __raw(__begin_);
+        const __storage_type* __b = __raw(__other.__begin_);
+        for (size_type __i = 0, __n = __words(__size_); __i < __n; ++__i) { __a[__i] = __op(__a[__i], __b[__i]); }
+    }
+};
+
+template <class _Allocator>
+_MYSTL_CONSTEXPR_SINCE_CXX20 vector<bool, _Allocator> operator&(const vector<bool, _Allocator>& __x, const vector<bool, _Allocator>& __y) {
+    vector<bool, _Allocator> __r(__x);
+    __r &= __y;
+    return __r;
+}
+
+template <class _Allocator>
+_MYSTL_CONSTEXPR_SINCE_CXX20 vector<bool, _Allocator> operator|(const vector<bool, _Allocator>& __x, const vector<bool, _Allocator>& __y) {
+    vector<bool, _Allocator> __r(__x);
+    __r |= __y;
+    return __r;
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_VECTOR_BOOL_H
@@ -0,0 +1,106 @@
+//===-------------------------------------===//
+//
+// vector_io.h
+// 将 read/readv/pread 的结果直接写入 vector 的空余容量，省去中间缓冲区的一次拷贝
+// 依赖 POSIX
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_VECTOR_IO_H
+#define _MYSTL_VECTOR_IO_H
+
+#include <array>
+#include <cerrno>
+#include <config.h>
+#include <hardening.h>
+#include <memory>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 系统调用以字节为单位返回，只允许单字节的元素类型，避免读到不完整的元素
+template <class _Tp>
+inline constexpr bool __is_io_byte_v = std::is_trivially_copyable_v<_Tp> && sizeof(_Tp) == 1 && !std::is_same_v<_Tp, bool>;
+
+// 保证 __v 至少有 __min_bytes 字节的空余容量，返回覆盖全部空余容量的 iovec
+// 空余容量可能大于 __min_bytes，此时一次读取可以接收更多数据
+template <class _Tp, class _Allocator>
+iovec spare_iovec(vector<_Tp, _Allocator>& __v, size_t __min_bytes) {
+    static_assert(__is_io_byte_v<_Tp>, "vector I/O requires a byte-sized trivially copyable value_type");
+    __v.reserve_spare(__min_bytes);
+    auto __spare = __v.spare_capacity();
+    return iovec{__spare.data(), __spare.size()};
+}
+
+// 以下函数的返回值与对应的系统调用相同：成功时返回读取的字节数并计入 __v.size()，失败时返回 -1 并设置 errno，__v 不变
+// 被信号中断 (EINTR) 时自动重试
+
+// 至少读取 1 字节，最多读取 __max_bytes 字节追加到 __v 的末尾
+template <class _Tp, class _Allocator>
+ssize_t read_append(int __fd, vector<_Tp, _Allocator>& __v, size_t __max_bytes) {
+    static_assert(__is_io_byte_v<_Tp>, "vector I/O requires a byte-sized trivially copyable value_type");
+    __v.reserve_spare(__max_bytes);
+    ssize_t __r;
+    do {
+        __r = ::read(__fd, __v.spare_capacity().data(), __max_bytes);
+    } while (__r < 0 && errno == EINTR);
+    if (__r > 0) { __v.commit_spare(static_cast<size_t>(__r)); }
+    return __r;
+}
+
+// 从文件偏移 __offset 处读取，不改变文件的当前偏移
+template <class _Tp, class _Allocator>
+ssize_t pread_append(int __fd, vector<_Tp, _Allocator>& __v, size_t __max_bytes, off_t __offset) {
+    static_assert(__is_io_byte_v<_Tp>, "vector I/O requires a byte-sized trivially copyable value_type");
+    __v.reserve_spare(__max_bytes);
+    ssize_t __r;
+    do {
+        __r = ::pread(__fd, __v.spare_capacity().data(), __max_bytes, __offset);
+    } while (__r < 0 && errno == EINTR);
+    if (__r > 0) { __v.commit_spare(static_cast<size_t>(__r)); }
+    return __r;
+}
+
+// 一次 readv 依次填满每个 vector 的空余容量，第 i 个 vector 接收 __bytes[i] 字节，
+// 例如将定长的报文头与报文体分别读入不同的 vector：readv_append(fd, {16, 4096}, head, body)
+// 读取的字节按顺序计入各个 vector，只有最后一个被写入的 vector 可能不满
+// Precondition: __vs 中没有重复的 vector，否则多个 iovec 指向同一段空余容量
+template <class... _Vectors>
+ssize_t readv_append(int __fd, const std::array<size_t, sizeof...(_Vectors)>& __bytes, _Vectors&... __vs) {
+    static_assert(sizeof...(_Vectors) > 0, "readv_append requires at least one vector");
+    static_assert((__is_io_byte_v<typename _Vectors::value_type> && ...), "vector I/O requires a byte-sized trivially copyable value_type");
+    constexpr size_t __n           = sizeof...(_Vectors);
+    const void* const __addrs[__n] = {std::addressof(__vs)...};
+    for (size_t __i = 0; __i < __n; ++__i) {
+        for (size_t __j = __i + 1; __j < __n; ++__j) { _MYSTL_ASSERT(__addrs[__i] != __addrs[__j], "readv_append: the same vector is passed twice"); }
+    }
+
+    size_t __i = 0;
+    (__vs.reserve_spare(__bytes[__i++]), ...);
+    __i              = 0;
+    iovec __iov[__n] = {iovec{__vs.spare_capacity().data(), __bytes[__i++]}...};
+    ssize_t __r;
+    do {
+        __r = ::readv(__fd, __iov, static_cast<int>(__n));
+    } while (__r < 0 && errno == EINTR);
+    if (__r > 0) {
+        size_t __left = static_cast<size_t>(__r);
+        __i           = 0;
+        auto __commit = [&](auto& __v) {
+            size_t __k = __left < __bytes[__i] ? __left : __bytes[__i];
+            __v.commit_spare(__k);
+            __left -= __k;
+            ++__i;
+        };
+        (__commit(__vs), ...);
+    }
+    return __r;
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_VECTOR_IO_H
@@ -0,0 +1,57 @@
+//===-------------------------------------===//
+//
+// vector_shrink.h
+// vector 的自动收缩策略
+// 编译时定义 _MYSTL_VECTOR_SHRINK_POLICY=1 后，erase/pop_back/clear 使元素数远小于容量时 vector 自动收缩
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_VECTOR_SHRINK_H
+#define _MYSTL_VECTOR_SHRINK_H
+
+#include <atomic>
+#include <config.h>
+#include <hardening.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// size() * shrink_divisor < capacity() 时，容量按 1 / shrink_step 逐级缩小，直到不再满足该条件
+// 收缩后 size() 至少占容量的 1 / shrink_divisor，而再次扩容需要写满容量，两者之间留有余地，
+// push_back/pop_back 在边界附近交替时不会反复分配
+// 自动收缩不会使容量低于 min_bytes，例如 clear 后重新填充的 vector 保留一部分空间
+struct vector_shrink_policy {
+    size_t shrink_divisor = 4;
+    size_t shrink_step    = 2;
+    size_t min_bytes      = 4096;
+};
+
+inline std::atomic<size_t> __vector_shrink_divisor{vector_shrink_policy{}.shrink_divisor};
+inline std::atomic<size_t> __vector_shrink_step{vector_shrink_policy{}.shrink_step};
+inline std::atomic<size_t> __vector_shrink_min_bytes{vector_shrink_policy{}.min_bytes};
+
+// Precondition: __p.shrink_divisor > __p.shrink_step >= 2
+inline void set_vector_shrink_policy(const vector_shrink_policy& __p) noexcept {
+    _MYSTL_ASSERT_DEBUG(__p.shrink_step >= 2 && __p.shrink_divisor > __p.shrink_step,
+                        "set_vector_shrink_policy: shrink_divisor must exceed shrink_step");
+    __vector_shrink_divisor.store(__p.shrink_divisor, std::memory_order_relaxed);
+    __vector_shrink_step.store(__p.shrink_step, std::memory_order_relaxed);
+    __vector_shrink_min_bytes.store(__p.min_bytes, std::memory_order_relaxed);
+}
+
+inline vector_shrink_policy get_vector_shrink_policy() noexcept {
+    return vector_shrink_policy{__vector_shrink_divisor.load(std::memory_order_relaxed), __vector_shrink_step.load(std::memory_order_relaxed),
+                                __vector_shrink_min_bytes.load(std::memory_order_relaxed)};
+}
+
+// 按策略计算收缩后的容量，不需要收缩时返回 __cap
+constexpr size_t __shrink_target(size_t __size, size_t __cap, size_t __elem_size, const vector_shrink_policy& __p) noexcept {
+    size_t __min = __p.min_bytes / __elem_size;
+    if (__size * __p.shrink_divisor >= __cap || __cap <= __min) return __cap;
+    size_t __target = __cap;
+    while (__size * __p.shrink_divisor < __target && __target / __p.shrink_step >= __min) { __target /= __p.shrink_step; }
+    return __target;
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#endif // _MYSTL_VECTOR_SHRINK_H
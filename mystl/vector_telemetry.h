@@ -0,0 +1,174 @@
+//===-------------------------------------===//
+//
+// vector_telemetry.h
+// vector 扩容统计，用于找出应当预先 reserve 的 vector
+// 编译时定义 _MYSTL_VECTOR_TELEMETRY=1 后 vector 的每次扩容都会报告给 reallocation_registry
+//
+//===-------------------------------------===//
+
+#ifndef _MYSTL_VECTOR_TELEMETRY_H
+#define _MYSTL_VECTOR_TELEMETRY_H
+
+#include <algorithm>
+#include <config.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL
+
+// 调用点，由 _MYSTL_REALLOCATION_SITE() 在当前作用域内登记
+struct reallocation_site {
+    const char* file;
+    unsigned line;
+    const char* function;
+};
+
+// 一次扩容
+// bytes_moved 为迁移到新空间的原有元素的字节数，site 在没有登记调用点时为空
+struct reallocation_event {
+    std::string_view element_type;
+    size_t element_size;
+    size_t old_capacity;
+    size_t new_capacity;
+    size_t bytes_moved;
+    const reallocation_site* site;
+};
+
+// 当前线程最内层的调用点
+inline thread_local const reallocation_site* __current_reallocation_site = nullptr;
+
+// 在作用域内登记调用点，作用域结束时恢复外层的调用点
+class __reallocation_site_scope {
+public:
+    explicit __reallocation_site_scope(const reallocation_site& __site) noexcept : __prev_(__current_reallocation_site) {
+        __current_reallocation_site = &__site;
+    }
+
+    __reallocation_site_scope(const __reallocation_site_scope&)            = delete;
+    __reallocation_site_scope& operator=(const __reallocation_site_scope&) = delete;
+
+    ~__reallocation_site_scope() { __current_reallocation_site = __prev_; }
+
+private:
+    const reallocation_site* __prev_;
+};
+
+// 由编译器生成的函数签名中取出 _Tp 的名字，不依赖 RTTI
+template <class _Tp>
+std::string_view __telemetry_type_name() noexcept {
+    std::string_view __s = __PRETTY_FUNCTION__;
+    size_t __b           = __s.find("_Tp = ");
+    if (__b == std::string_view::npos) return __s;
+    __b += 6;
+    return __s.substr(__b, __s.find_first_of(";]", __b) - __b);
+}
+
+// 按 (元素类型, 调用点) 汇总扩容事件，线程安全
+// 内部使用 std 容器，避免统计本身触发统计
+class reallocation_registry {
+public:
+    using sink_type = void (*)(const reallocation_event&);
+
+    struct site_stats {
+        std::string_view element_type;
+        reallocation_site site; // file 为空表示未登记调用点
+        size_t count;
+        size_t bytes_moved;
+        size_t max_capacity;
+    };
+
+    static reallocation_registry& instance() {
+        static reallocation_registry __registry;
+        return __registry;
+    }
+
+    void record(const reallocation_event& __e) {
+        sink_type __sink;
+        {
+            std::lock_guard<std::mutex> __lock(__m_);
+            reallocation_site __site = __e.site ? *__e.site : reallocation_site{nullptr, 0, nullptr};
+            site_stats& __s          = __sites_.try_emplace(__key(__e.element_type, __site), site_stats{__e.element_type, __site, 0, 0, 0}).first->second;
+            ++__s.count;
+            __s.bytes_moved += __e.bytes_moved;
+            __s.max_capacity = std::max(__s.max_capacity, __e.new_capacity);
+            __sink           = __sink_;
+        }
+        if (__sink) { __sink(__e); }
+    }
+
+    // 每次扩容时额外调用 __sink，例如写入日志，传入 nullptr 取消
+    void set_sink(sink_type __sink) {
+        std::lock_guard<std::mutex> __lock(__m_);
+        __sink_ = __sink;
+    }
+
+    // 扩容次数最多的 __n 个调用点，次数相同时按迁移的字节数排序
+    std::vector<site_stats> top_sites(size_t __n) const {
+        std::vector<site_stats> __r;
+        {
+            std::lock_guard<std::mutex> __lock(__m_);
+            for (const auto& __kv : __sites_) { __r.push_back(__kv.second); }
+        }
+        std::sort(__r.begin(), __r.end(), [](const site_stats& __x, const site_stats& __y) {
+            return std::tie(__y.count, __y.bytes_moved) < std::tie(__x.count, __x.bytes_moved);
+        });
+        if (__r.size() > __n) { __r.resize(__n); }
+        return __r;
+    }
+
+    // 输出扩容次数最多的 __n 个调用点
+    void report(std::ostream& __os, size_t __n = 10) const {
+        std::vector<site_stats> __top = top_sites(__n);
+        __os << "vector reallocations (top " << __top.size() << " sites)\n";
+        for (const site_stats& __s : __top) {
+            __os << "  " << __s.count << " reallocations, " << __s.bytes_moved << " bytes moved, max capacity " << __s.max_capacity << ": vector<"
+                 << __s.element_type << "> at ";
+            if (__s.site.file) {
+                __os << __s.site.file << ":" << __s.site.line << " (" << __s.site.function << ")";
+            } else {
+                __os << "<unknown site>";
+            }
+            __os << "\n";
+        }
+    }
+
+    void reset() {
+        std::lock_guard<std::mutex> __lock(__m_);
+        __sites_.clear();
+    }
+
+private:
+    using __key_type = std::tuple<std::string_view, const char*, unsigned>;
+
+    static __key_type __key(std::string_view __type, const reallocation_site& __site) noexcept { return __key_type(__type, __site.file, __site.line); }
+
+    mutable std::mutex __m_;
+    std::map<__key_type, site_stats> __sites_;
+    sink_type __sink_ = nullptr;
+
+    reallocation_registry() = default;
+};
+
+template <class _Tp>
+void __report_reallocation(size_t __old_cap, size_t __new_cap, size_t __moved) {
+    reallocation_registry::instance().record(reallocation_event{mystl::__telemetry_type_name<_Tp>(), sizeof(_Tp), __old_cap, __new_cap,
+                                                                __moved * sizeof(_Tp), __current_reallocation_site});
+}
+
+_MYSTL_END_NAMESPACE_MYSTL
+
+#define _MYSTL_TELEMETRY_CONCAT_IMPL(__a, __b) __a##__b
+#define _MYSTL_TELEMETRY_CONCAT(__a, __b)      _MYSTL_TELEMETRY_CONCAT_IMPL(__a, __b)
+
+// 将当前作用域内发生的扩容归到这一行，未开启统计时 vector.h 将其定义为空语句
+#undef _MYSTL_REALLOCATION_SITE
+#define _MYSTL_REALLOCATION_SITE()                                                                                                           \
+    static constexpr ::mystl::reallocation_site _MYSTL_TELEMETRY_CONCAT(__mystl_site_, __LINE__){__FILE__, __LINE__, __func__};              \
+    ::mystl::__reallocation_site_scope _MYSTL_TELEMETRY_CONCAT(__mystl_site_scope_, __LINE__)(_MYSTL_TELEMETRY_CONCAT(__mystl_site_, __LINE__))
+
+#endif // _MYSTL_VECTOR_TELEMETRY_H
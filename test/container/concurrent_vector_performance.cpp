@@ -0,0 +1,84 @@
+#include "concurrent_vector.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 多个生产者同时追加，线程数从 1 增加到 hardware_concurrency
+// 比较 mystl::concurrent_vector (push_back / grow_by) 与加锁的 mystl::vector
+
+constexpr size_t NUM_ELEMS  = 20000000;
+constexpr size_t BULK       = 256;
+constexpr size_t NUM_ROUNDS = 3;
+
+template <class F>
+void run(const char* name, unsigned threads, F f) {
+    mystl_test::Timer timer;
+    size_t result = f(threads);
+    timer.stop();
+    std::cout << "  " << name << " x" << threads << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+// 每个线程执行 body(线程编号, 该线程追加的元素数)
+template <class Body>
+void parallel(unsigned threads, Body body) {
+    std::vector<std::thread> ts;
+    for (unsigned t = 0; t < threads; ++t) { ts.emplace_back(body, t, NUM_ELEMS / threads); }
+    for (auto& th : ts) th.join();
+}
+
+size_t concurrent_push_back(unsigned threads) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        mystl::concurrent_vector<size_t> v;
+        parallel(threads, [&](unsigned, size_t n) {
+            for (size_t i = 0; i < n; ++i) { v.push_back(i); }
+        });
+        sum += v.size();
+    }
+    return sum;
+}
+
+size_t concurrent_grow_by(unsigned threads) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        mystl::concurrent_vector<size_t> v;
+        parallel(threads, [&](unsigned, size_t n) {
+            for (size_t i = 0; i < n; i += BULK) { v.grow_by(std::min(BULK, n - i), i); }
+        });
+        sum += v.size();
+    }
+    return sum;
+}
+
+size_t locked_push_back(unsigned threads) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        mystl::vector<size_t> v;
+        std::mutex m;
+        parallel(threads, [&](unsigned, size_t n) {
+            for (size_t i = 0; i < n; ++i) {
+                std::lock_guard<std::mutex> lock(m);
+                v.push_back(i);
+            }
+        });
+        sum += v.size();
+    }
+    return sum;
+}
+
+int main() {
+    unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1;; threads = std::min(threads * 2, max_threads)) {
+        std::cout << threads << " producer(s)" << std::endl;
+        run("mystl::concurrent_vector push_back", threads, concurrent_push_back);
+        run("mystl::concurrent_vector grow_by", threads, concurrent_grow_by);
+        run("mystl::vector + mutex", threads, locked_push_back);
+        if (threads == max_threads) break;
+    }
+    return 0;
+}
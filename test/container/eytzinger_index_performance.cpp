@@ -0,0 +1,65 @@
+#include "eytzinger_index.h"
+#include "sorted_search.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+
+// 在不同大小的有序 uint64_t 键上随机查找，比较有序数组上的二分查找与 eytzinger_index
+// 键的数量超出缓存后，二分查找的每一步都是一次缓存缺失，eytzinger_index 通过预取与批量查找隐藏延迟
+
+constexpr size_t NUM_QUERIES = 4000000;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    std::mt19937_64 gen(42);
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20, size_t(1) << 24}) {
+        mystl::vector<uint64_t> keys;
+        for (size_t i = 0; i < n; ++i) { keys.push_back(gen()); }
+        std::sort(keys.begin(), keys.end());
+        mystl::vector<uint64_t> queries;
+        for (size_t i = 0; i < NUM_QUERIES; ++i) { queries.push_back(gen()); }
+        mystl::vector<size_t> ranks(NUM_QUERIES);
+
+        std::cout << "n = " << n << ", " << NUM_QUERIES << " lookups" << std::endl;
+        mystl::eytzinger_index<uint64_t> index;
+        run("eytzinger_index build", [&] {
+            index.assign(keys);
+            return index.size();
+        });
+        run("std::lower_bound", [&] {
+            size_t sum = 0;
+            for (uint64_t q : queries) { sum += size_t(std::lower_bound(keys.begin(), keys.end(), q) - keys.begin()); }
+            return sum;
+        });
+        run("branchless lower_bound", [&] {
+            std::less<uint64_t> comp;
+            size_t sum = 0;
+            for (uint64_t q : queries) { sum += size_t(mystl::__branchless_lower_bound(keys.begin(), keys.size(), q, comp) - keys.begin()); }
+            return sum;
+        });
+        run("eytzinger_index lower_bound", [&] {
+            size_t sum = 0;
+            for (uint64_t q : queries) { sum += index.lower_bound(q); }
+            return sum;
+        });
+        run("eytzinger_index lower_bound_batch", [&] {
+            index.lower_bound_batch(queries.begin(), queries.end(), ranks.begin());
+            size_t sum = 0;
+            for (size_t r : ranks) { sum += r; }
+            return sum;
+        });
+    }
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "flat_map.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+
+// 几千个元素的查找表，比较 mystl::flat_map 与红黑树 std::map
+// 构建 (逐个插入 / 有序批量插入) 与随机查找
+
+constexpr size_t NUM_LOOKUPS = 20000000;
+constexpr size_t NUM_BUILDS  = 500;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+template <class Map>
+size_t lookup(const Map& m, const mystl::vector<int>& queries) {
+    size_t sum = 0;
+    for (size_t i = 0; i < NUM_LOOKUPS; ++i) {
+        auto it = m.find(queries[i % queries.size()]);
+        if (it != m.end()) sum += it->second;
+    }
+    return sum;
+}
+
+int main() {
+    std::mt19937 gen(42);
+    for (size_t n : {1000, 4000, 16000}) {
+        mystl::vector<std::pair<int, int>> items;
+        for (size_t i = 0; i < n; ++i) { items.emplace_back(int(gen() % (n * 4)), int(i)); }
+        mystl::vector<std::pair<int, int>> sorted = items;
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end(), [](const auto& a, const auto& b) { return a.first == b.first; }), sorted.end());
+        mystl::vector<int> queries;
+        for (size_t i = 0; i < 1 << 16; ++i) { queries.push_back(int(gen() % (n * 4))); }
+
+        std::cout << "n = " << n << std::endl;
+        std::cout << " build" << std::endl;
+        run("std::map insert", [&] {
+            size_t sum = 0;
+            for (size_t r = 0; r < NUM_BUILDS; ++r) {
+                std::map<int, int> m;
+                for (auto& kv : items) m.insert(kv);
+                sum += m.size();
+            }
+            return sum;
+        });
+        run("mystl::flat_map insert(first, last)", [&] {
+            size_t sum = 0;
+            for (size_t r = 0; r < NUM_BUILDS; ++r) {
+                mystl::flat_map<int, int> m(items.begin(), items.end());
+                sum += m.size();
+            }
+            return sum;
+        });
+        run("mystl::flat_map insert(sorted_unique, ...)", [&] {
+            size_t sum = 0;
+            for (size_t r = 0; r < NUM_BUILDS; ++r) {
+                mystl::flat_map<int, int> m(mystl::sorted_unique, sorted.begin(), sorted.end());
+                sum += m.size();
+            }
+            return sum;
+        });
+
+        std::map<int, int> tree(items.begin(), items.end());
+        mystl::flat_map<int, int> flat(items.begin(), items.end());
+        std::cout << " lookup" << std::endl;
+        run("std::map", [&] { return lookup(tree, queries); });
+        run("mystl::flat_map", [&] { return lookup(flat, queries); });
+    }
+    return 0;
+}
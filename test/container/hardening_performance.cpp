@@ -0,0 +1,97 @@
+// 分别以 _MYSTL_HARDENING_MODE=0/1/2 编译为 hardening_performance_none/fast/debug，见 CMakeLists.txt
+#include "timer.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <iostream>
+
+// 比较各模式下 operator[]、back/pop_back 的开销，none 模式应当与原生指针的循环相同
+
+constexpr size_t NUM_ELEMS  = 1 << 16;
+constexpr size_t NUM_ROUNDS = 4000;
+
+static const char* mode_name() {
+#if _MYSTL_HARDENING_MODE == _MYSTL_HARDENING_MODE_NONE
+    return "none";
+#elif _MYSTL_HARDENING_MODE == _MYSTL_HARDENING_MODE_FAST
+    return "fast";
+#else
+    return "debug";
+#endif
+}
+
+// 阻止编译器把各轮相同的计算合并为一次
+static inline void clobber() { asm volatile("" ::: "memory"); }
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    uint64_t result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+// 不内联，便于对比各模式生成的代码
+__attribute__((noinline)) uint64_t sum_raw(const uint32_t* p, size_t n) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < n; ++i) { s += p[i]; }
+    return s;
+}
+
+__attribute__((noinline)) uint64_t sum_index(const mystl::vector<uint32_t>& v) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < v.size(); ++i) { s += v[i]; }
+    return s;
+}
+
+__attribute__((noinline)) uint64_t gather_index(const mystl::vector<uint32_t>& v, const mystl::vector<uint32_t>& idx) {
+    uint64_t s = 0;
+    for (size_t i = 0; i < idx.size(); ++i) { s += v[idx[i]]; }
+    return s;
+}
+
+int main() {
+    mystl::vector<uint32_t> v, idx;
+    for (size_t i = 0; i < NUM_ELEMS; ++i) {
+        v.push_back(uint32_t(i));
+        idx.push_back(uint32_t((i * 2654435761u) % NUM_ELEMS));
+    }
+
+    std::cout << "hardening mode " << mode_name() << std::endl;
+    run("raw pointer sum", [&] {
+        uint64_t s = 0;
+        for (size_t r = 0; r < NUM_ROUNDS; ++r) {
+            clobber();
+            s += sum_raw(v.data(), v.size());
+        }
+        return s;
+    });
+    run("operator[] sum", [&] {
+        uint64_t s = 0;
+        for (size_t r = 0; r < NUM_ROUNDS; ++r) {
+            clobber();
+            s += sum_index(v);
+        }
+        return s;
+    });
+    run("operator[] gather", [&] {
+        uint64_t s = 0;
+        for (size_t r = 0; r < NUM_ROUNDS; ++r) {
+            clobber();
+            s += gather_index(v, idx);
+        }
+        return s;
+    });
+    run("back + pop_back", [&] {
+        uint64_t s = 0;
+        for (size_t r = 0; r < NUM_ROUNDS / 16; ++r) {
+            mystl::vector<uint32_t> w(v);
+            while (!w.empty()) {
+                s += w.back();
+                w.pop_back();
+            }
+        }
+        return s;
+    });
+    return 0;
+}
@@ -0,0 +1,44 @@
+#include "incremental_vector.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+// 逐次测量 push_back 的耗时，比较 mystl::vector 与 mystl::incremental_vector 的尾延迟
+// vector 扩容时单次 push_back 需要迁移全部元素，incremental_vector 把迁移分摊到之后的 push_back 中
+
+constexpr size_t NUM_ELEMS = 20000000;
+
+template <class Vec>
+void run(const char* name, std::vector<int64_t>& latency) {
+    Vec v;
+    mystl_test::Timer timer;
+    for (size_t i = 0; i < NUM_ELEMS; ++i) {
+        auto t0 = std::chrono::steady_clock::now();
+        v.push_back(i);
+        auto t1    = std::chrono::steady_clock::now();
+        latency[i] = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+    timer.stop();
+
+    std::sort(latency.begin(), latency.end());
+    auto pct = [&](double p) { return latency[static_cast<size_t>(p * (NUM_ELEMS - 1))]; };
+    std::cout << "  " << name << ": total " << timer.elapsedMilliseconds() << "ms, p50 " << pct(0.5) << "ns, p99 " << pct(0.99) << "ns, p99.9 "
+              << pct(0.999) << "ns, p99.99 " << pct(0.9999) << "ns, max " << latency.back() << "ns (" << v[NUM_ELEMS - 1] << ")" << std::endl;
+}
+
+int main() {
+    // 预先分配并写入，避免测量过程中的缺页影响结果
+    std::vector<int64_t> latency(NUM_ELEMS, 1);
+
+    std::cout << "push_back " << NUM_ELEMS << " x size_t" << std::endl;
+    for (int round = 0; round < 2; ++round) {
+        run<mystl::vector<size_t>>("mystl::vector", latency);
+        run<mystl::incremental_vector<size_t>>("mystl::incremental_vector", latency);
+    }
+    return 0;
+}
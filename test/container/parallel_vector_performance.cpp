@@ -0,0 +1,54 @@
+#include "parallel.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+#include <thread>
+
+// 比较大 vector 的串行构造与并行构造 (mystl::par)
+// 构造完成后由多个线程分别读取各自的部分，模拟首次访问位置对之后访问的影响
+
+constexpr size_t NUM_ELEMS = size_t(1) << 27; // 1 GiB 的 uint64_t
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "threads: " << std::thread::hardware_concurrency() << ", elements: " << NUM_ELEMS << std::endl;
+
+    run("serial fill", [] {
+        mystl::vector<uint64_t> v(NUM_ELEMS, 1);
+        return v.size();
+    });
+    run("parallel fill", [] {
+        mystl::vector<uint64_t> v(mystl::par, NUM_ELEMS, 1);
+        return v.size();
+    });
+
+    mystl::vector<uint64_t> src(mystl::par, NUM_ELEMS, 3);
+    run("serial copy", [&] {
+        mystl::vector<uint64_t> v(src);
+        return v.size();
+    });
+    run("parallel copy", [&] {
+        mystl::vector<uint64_t> v(mystl::par, src);
+        return v.size();
+    });
+
+    run("serial assign", [&] {
+        mystl::vector<uint64_t> v;
+        v.assign(NUM_ELEMS, 5);
+        return v.size();
+    });
+    run("parallel assign", [&] {
+        mystl::vector<uint64_t> v;
+        v.assign(mystl::par, NUM_ELEMS, 5);
+        return v.size();
+    });
+    return 0;
+}
@@ -0,0 +1,89 @@
+#include "segmented_vector.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <deque>
+#include <iostream>
+#include <random>
+
+// 比较 mystl::segmented_vector, mystl::vector 与 std::deque
+// push_back 增长、顺序遍历与随机访问三种负载
+
+constexpr size_t NUM_ELEMS  = 10000000;
+constexpr size_t NUM_ROUNDS = 10;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+template <class Container>
+size_t push_back() {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        Container c;
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { c.push_back(i); }
+        sum += c.size();
+    }
+    return sum;
+}
+
+template <class Container>
+size_t iterate(const Container& c) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        for (size_t x : c) { sum += x; }
+    }
+    return sum;
+}
+
+template <class Container>
+size_t random_access(const Container& c, const mystl::vector<size_t>& idx) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        for (size_t i : idx) { sum += c[i]; }
+    }
+    return sum;
+}
+
+int main() {
+    mystl::vector<size_t> v;
+    mystl::segmented_vector<size_t> s;
+    std::deque<size_t> d;
+    for (size_t i = 0; i < NUM_ELEMS; ++i) {
+        v.push_back(i);
+        s.push_back(i);
+        d.push_back(i);
+    }
+    mystl::vector<size_t> idx;
+    std::mt19937_64 gen(42);
+    for (size_t i = 0; i < NUM_ELEMS; ++i) { idx.push_back(gen() % NUM_ELEMS); }
+
+    std::cout << "push_back" << std::endl;
+    run("mystl::vector", push_back<mystl::vector<size_t>>);
+    run("mystl::segmented_vector", push_back<mystl::segmented_vector<size_t>>);
+    run("std::deque", push_back<std::deque<size_t>>);
+
+    std::cout << "iterate" << std::endl;
+    run("mystl::vector", [&] { return iterate(v); });
+    run("mystl::segmented_vector", [&] { return iterate(s); });
+    run("mystl::segmented_vector (for_each_segment)", [&] {
+        size_t sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            s.for_each_segment([&](const size_t* first, const size_t* last) {
+                for (; first != last; ++first) sum += *first;
+            });
+        }
+        return sum;
+    });
+    run("std::deque", [&] { return iterate(d); });
+
+    std::cout << "random access" << std::endl;
+    run("mystl::vector", [&] { return random_access(v, idx); });
+    run("mystl::segmented_vector", [&] { return random_access(s, idx); });
+    run("std::deque", [&] { return random_access(d, idx); });
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "small_vector.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+#include <string>
+
+// 比较 mystl::small_vector 与 mystl::vector 在小规模场景下的性能
+// 每轮创建一个容器并写入少量元素，模拟每个请求使用的临时容器
+
+constexpr size_t NUM_ROUNDS = 2000000;
+
+template <class Vec>
+size_t fill_and_sum(size_t n) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        Vec v;
+        for (size_t i = 0; i < n; ++i) { v.push_back(static_cast<int>(i + round)); }
+        for (auto x : v) { sum += static_cast<size_t>(x); }
+    }
+    return sum;
+}
+
+// 混合负载：大部分请求很小，偶尔出现超过内联容量的请求
+template <class Vec>
+size_t mixed(size_t inline_n) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+        size_t n = (round % 16 == 0) ? inline_n * 4 : round % inline_n + 1;
+        Vec v;
+        for (size_t i = 0; i < n; ++i) { v.emplace_back(static_cast<int>(i)); }
+        if (n > 2) { v.erase(v.begin() + 1); }
+        v.insert(v.begin(), 1);
+        sum += v.size() + static_cast<size_t>(v.back());
+    }
+    return sum;
+}
+
+template <class Vec>
+size_t strings(size_t n) {
+    size_t sum = 0;
+    for (size_t round = 0; round < NUM_ROUNDS / 4; ++round) {
+        Vec v;
+        for (size_t i = 0; i < n; ++i) { v.emplace_back("key"); }
+        sum += v.size();
+    }
+    return sum;
+}
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    for (size_t n : {1, 4, 8}) {
+        std::cout << "fill " << n << " ints" << std::endl;
+        run("  mystl::vector         ", [n] { return fill_and_sum<mystl::vector<int>>(n); });
+        run("  mystl::small_vector<8>", [n] { return fill_and_sum<mystl::small_vector<int, 8>>(n); });
+    }
+
+    std::cout << "mixed workload" << std::endl;
+    run("  mystl::vector         ", [] { return mixed<mystl::vector<int>>(8); });
+    run("  mystl::small_vector<8>", [] { return mixed<mystl::small_vector<int, 8>>(8); });
+
+    std::cout << "fill 4 strings" << std::endl;
+    run("  mystl::vector         ", [] { return strings<mystl::vector<std::string>>(4); });
+    run("  mystl::small_vector<8>", [] { return strings<mystl::small_vector<std::string, 8>>(4); });
+
+    return 0;
+}
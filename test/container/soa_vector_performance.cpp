@@ -0,0 +1,80 @@
+#include "soa_vector.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+
+// 10 个字段的记录，循环只读取其中的 1-2 个字段
+// 比较 mystl::vector<Record> (AoS) 与 mystl::soa_vector (SoA)
+
+constexpr size_t NUM_ELEMS  = 4000000;
+constexpr size_t NUM_ROUNDS = 20;
+
+struct Record {
+    long id;
+    double price;
+    double qty;
+    double f3, f4, f5, f6, f7, f8, f9;
+};
+
+using Columns = mystl::soa_vector<long, double, double, double, double, double, double, double, double, double>;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    double result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+int main() {
+    mystl::vector<Record> aos;
+    Columns soa;
+    for (size_t i = 0; i < NUM_ELEMS; ++i) {
+        double x = static_cast<double>(i % 1000);
+        aos.push_back(Record{long(i), x, x * 0.5, 0, 0, 0, 0, 0, 0, 0});
+        soa.emplace_back(long(i), x, x * 0.5, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0);
+    }
+
+    std::cout << "sum(price)" << std::endl;
+    run("mystl::vector<Record>", [&] {
+        double sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            for (const Record& r : aos) { sum += r.price; }
+        }
+        return sum;
+    });
+    run("mystl::soa_vector column", [&] {
+        double sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            for (double p : soa.column<1>()) { sum += p; }
+        }
+        return sum;
+    });
+
+    std::cout << "sum(price * qty)" << std::endl;
+    run("mystl::vector<Record>", [&] {
+        double sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            for (const Record& r : aos) { sum += r.price * r.qty; }
+        }
+        return sum;
+    });
+    run("mystl::soa_vector column", [&] {
+        double sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            const double* price = soa.data<1>();
+            const double* qty   = soa.data<2>();
+            for (size_t i = 0; i < soa.size(); ++i) { sum += price[i] * qty[i]; }
+        }
+        return sum;
+    });
+    run("mystl::soa_vector proxy iteration", [&] {
+        double sum = 0;
+        for (size_t round = 0; round < NUM_ROUNDS; ++round) {
+            for (auto&& r : soa) { sum += std::get<1>(r) * std::get<2>(r); }
+        }
+        return sum;
+    });
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "sorted_search.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <random>
+
+// 在不同大小的有序 uint64_t 数组中查找大量互不相关的随机键
+// 比较逐个 std::lower_bound、逐个无分支二分查找与不同组大小的 lower_bound_batch
+
+constexpr size_t NUM_QUERIES = 4000000;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+template <size_t Batch>
+void run_batch(const char* name, const mystl::vector<uint64_t>& keys, const mystl::vector<uint64_t>& queries, mystl::vector<const uint64_t*>& out) {
+    run(name, [&] {
+        mystl::lower_bound_batch<Batch>(keys.data(), keys.data() + keys.size(), queries.begin(), queries.end(), out.begin());
+        size_t sum = 0;
+        for (const uint64_t* p : out) { sum += size_t(p - keys.data()); }
+        return sum;
+    });
+}
+
+int main() {
+    std::mt19937_64 gen(42);
+    for (size_t n : {size_t(1) << 10, size_t(1) << 16, size_t(1) << 20, size_t(1) << 24}) {
+        mystl::vector<uint64_t> keys;
+        for (size_t i = 0; i < n; ++i) { keys.push_back(gen()); }
+        std::sort(keys.begin(), keys.end());
+        mystl::vector<uint64_t> queries;
+        for (size_t i = 0; i < NUM_QUERIES; ++i) { queries.push_back(gen()); }
+        mystl::vector<const uint64_t*> out(NUM_QUERIES);
+
+        std::cout << "n = " << n << ", " << NUM_QUERIES << " lookups" << std::endl;
+        run("std::lower_bound", [&] {
+            size_t sum = 0;
+            for (uint64_t q : queries) { sum += size_t(std::lower_bound(keys.begin(), keys.end(), q) - keys.begin()); }
+            return sum;
+        });
+        run("branchless lower_bound", [&] {
+            std::less<uint64_t> comp;
+            size_t sum = 0;
+            for (uint64_t q : queries) { sum += size_t(mystl::__branchless_lower_bound(keys.begin(), keys.size(), q, comp) - keys.begin()); }
+            return sum;
+        });
+        run_batch<4>("lower_bound_batch<4>", keys, queries, out);
+        run_batch<8>("lower_bound_batch<8>", keys, queries, out);
+        run_batch<16>("lower_bound_batch<16>", keys, queries, out);
+        run_batch<32>("lower_bound_batch<32>", keys, queries, out);
+        run_batch<64>("lower_bound_batch<64>", keys, queries, out);
+    }
+    return 0;
+}
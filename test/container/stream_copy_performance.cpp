@@ -0,0 +1,95 @@
+#include "stream_copy.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// 1. 大块拷贝的吞吐：memcpy 与各指令集的非临时写入
+// 2. 缓存污染：另一个线程在拷贝进行时反复随机读取一块常驻缓存的工作集，比较它在拷贝期间完成的读取次数
+//    以及拷贝结束后重新遍历工作集的耗时
+
+constexpr size_t COPY_BYTES    = size_t(512) << 20;
+constexpr size_t WORKING_SET   = size_t(8) << 20;
+constexpr size_t NUM_ROUNDS    = 4;
+constexpr size_t VICTIM_ROUNDS = 4;
+
+using kernel = void (*)(void*, const void*, size_t);
+
+const char* isa_name(mystl::stream_copy_isa isa) {
+    switch (isa) {
+    case mystl::stream_copy_isa::avx512: return "stream (avx512)";
+    case mystl::stream_copy_isa::avx2: return "stream (avx2)";
+    case mystl::stream_copy_isa::sse2: return "stream (sse2)";
+    default: return "memcpy";
+    }
+}
+
+void copy_with(mystl::stream_copy_isa isa, char* dst, const char* src, size_t n) {
+    if (isa == mystl::stream_copy_isa::none) {
+        std::memcpy(dst, src, n);
+    } else {
+        mystl::set_stream_copy_isa(isa);
+        mystl::stream_copy(dst, src, n);
+    }
+}
+
+// 遍历工作集，返回耗时 (ms)
+double scan(const mystl::vector<size_t>& ws, size_t& sink) {
+    mystl_test::Timer timer;
+    for (size_t x : ws) sink += x;
+    timer.stop();
+    return timer.elapsedMilliseconds();
+}
+
+int main() {
+    mystl::vector<char> src(COPY_BYTES, 1), dst(COPY_BYTES, 0);
+    mystl::vector<size_t> ws(WORKING_SET / sizeof(size_t), 1);
+    mystl::vector<mystl::stream_copy_isa> isas = {mystl::stream_copy_isa::none};
+    for (auto isa : {mystl::stream_copy_isa::sse2, mystl::stream_copy_isa::avx2, mystl::stream_copy_isa::avx512}) {
+        if (static_cast<int>(isa) <= static_cast<int>(mystl::stream_copy_supported_isa())) isas.push_back(isa);
+    }
+
+    std::cout << "throughput (" << (COPY_BYTES >> 20) << " MiB)" << std::endl;
+    for (auto isa : isas) {
+        mystl_test::Timer timer;
+        for (size_t r = 0; r < NUM_ROUNDS; ++r) copy_with(isa, dst.data(), src.data(), COPY_BYTES);
+        timer.stop();
+        double gbps = double(COPY_BYTES) * NUM_ROUNDS / (timer.elapsedMilliseconds() / 1000.0) / 1e9;
+        std::cout << "  " << isa_name(isa) << ": " << gbps << " GB/s" << std::endl;
+    }
+
+    std::cout << "cache pollution (working set " << (WORKING_SET >> 20) << " MiB)" << std::endl;
+    size_t sink = 0;
+    for (auto isa : isas) {
+        // 拷贝期间并发的随机读取
+        std::atomic<bool> done{false};
+        std::atomic<size_t> reads{0};
+        std::thread victim([&] {
+            std::mt19937_64 gen(1);
+            size_t local = 0, n = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 1024; ++i) local += ws[gen() % ws.size()];
+                n += 1024;
+            }
+            reads = n + (local & 1);
+        });
+        for (size_t r = 0; r < NUM_ROUNDS; ++r) copy_with(isa, dst.data(), src.data(), COPY_BYTES);
+        done = true;
+        victim.join();
+
+        // 拷贝结束后重新遍历工作集，第一次遍历的耗时反映有多少工作集被挤出缓存
+        double warm = 0;
+        for (size_t r = 0; r < VICTIM_ROUNDS; ++r) scan(ws, sink);
+        for (size_t r = 0; r < VICTIM_ROUNDS; ++r) warm += scan(ws, sink);
+        copy_with(isa, dst.data(), src.data(), COPY_BYTES);
+        double after = scan(ws, sink);
+        std::cout << "  " << isa_name(isa) << ": concurrent reads " << reads.load() << ", rescan after copy " << after << "ms (warm "
+                  << warm / VICTIM_ROUNDS << "ms)" << std::endl;
+    }
+    std::cout << "(" << sink << ")" << std::endl;
+    return 0;
+}
@@ -0,0 +1,211 @@
+#ifndef _MYSTL_TEST_CONCURRENT_VECTOR_H
+#define _MYSTL_TEST_CONCURRENT_VECTOR_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <concurrent_vector.h>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class concurrent_vector_test {
+public:
+    static void test_all() {
+        test_basic();
+        test_concurrent_push();
+        test_concurrent_read();
+        test_exception();
+        test_block_allocation();
+    }
+
+    static void test_basic() {
+        mystl::concurrent_vector<std::string> v;
+        assert(v.empty() && !v.is_published(0));
+
+        auto it = v.push_back("a");
+        assert(it.index() == 0 && *it == "a" && v.size() == 1 && v.is_published(0));
+        std::string* p = &v[0];
+        for (int i = 1; i < 10000; ++i) { v.emplace_back(std::to_string(i)); }
+        // 增长过程中元素不移动
+        assert(p == &v[0] && v[9999] == "9999");
+
+        auto first = v.grow_by(100, "x");
+        assert(first.index() == 10000 && v.size() == 10100);
+        assert(std::count(first, v.end(), "x") == 100);
+        auto empty = v.grow_by(0);
+        assert(empty == v.end());
+
+        bool thrown = false;
+        try {
+            v.at(v.size());
+        } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown);
+
+        v.reserve(100000);
+        v.clear();
+        assert(v.empty());
+        v.push_back("b");
+        assert(v[0] == "b");
+
+        std::cout << "Concurrent vector basic test passed" << std::endl;
+    }
+
+    static void test_concurrent_push() {
+        constexpr int THREADS = 4, PER_THREAD = 20000, BULK = 50;
+        mystl::concurrent_vector<long> v;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([&v, t] {
+                for (int i = 0; i < PER_THREAD; ++i) { v.push_back(long(t) * PER_THREAD + i); }
+                // grow_by 得到的区间是连续的
+                auto it = v.grow_by(BULK, -1 - t);
+                for (int i = 0; i < BULK; ++i) { assert(it[i] == -1 - t); }
+            });
+        }
+        for (auto& th : threads) th.join();
+
+        assert(v.size() == size_t(THREADS) * (PER_THREAD + BULK));
+        std::vector<long> values(v.begin(), v.end());
+        std::sort(values.begin(), values.end());
+        for (int t = 0; t < THREADS; ++t) { assert(std::count(values.begin(), values.end(), -1 - t) == BULK); }
+        values.erase(values.begin(), values.begin() + THREADS * BULK);
+        for (long i = 0; i < long(THREADS) * PER_THREAD; ++i) { assert(values[i] == i); }
+
+        std::cout << "Concurrent vector push test passed" << std::endl;
+    }
+
+    static void test_concurrent_read() {
+        constexpr size_t N = 50000;
+        mystl::concurrent_vector<std::string> v;
+        std::atomic<bool> done{false};
+
+        // 读者只访问已发布的元素，值总是完整的
+        std::thread reader([&] {
+            size_t checked = 0;
+            while (!done.load(std::memory_order_acquire) || checked < v.size()) {
+                size_t n = v.size();
+                for (size_t i = checked; i < n && v.is_published(i); ++i, ++checked) { assert(v[i] == std::to_string(i % 1000)); }
+            }
+            size_t seen = 0;
+            v.for_each_published([&](const std::string&) { ++seen; });
+            assert(seen == N);
+        });
+        for (size_t i = 0; i < N; ++i) { v.push_back(std::to_string(i % 1000)); }
+        done.store(true, std::memory_order_release);
+        reader.join();
+
+        std::cout << "Concurrent vector read test passed" << std::endl;
+    }
+
+    struct throwing {
+        int value;
+
+        throwing(int x) : value(x) {
+            if (x < 0) throw std::runtime_error("throwing");
+        }
+    };
+
+    static void test_exception() {
+        mystl::concurrent_vector<throwing> v;
+        v.emplace_back(1);
+        bool thrown = false;
+        try {
+            v.emplace_back(-1);
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown);
+        v.emplace_back(3);
+
+        // 构造失败的位置保留但不发布
+        assert(v.size() == 3 && v.is_published(0) && !v.is_published(1) && v.is_published(2));
+        int sum = 0;
+        v.for_each_published([&](const throwing& x) { sum += x.value; });
+        assert(sum == 4);
+
+        // 超出 max_size() 时不预留下标
+        thrown = false;
+        try {
+            v.grow_by(v.max_size(), throwing(0));
+        } catch (const std::length_error&) { thrown = true; }
+        assert(thrown && v.size() == 3);
+
+        std::cout << "Concurrent vector exception test passed" << std::endl;
+    }
+
+    // 统计仍未释放的分配
+    template <class T>
+    struct counting_allocator {
+        using value_type = T;
+
+        static inline std::atomic<int> allocations{0};
+        static inline std::atomic<int> live{0};
+
+        counting_allocator() = default;
+
+        template <class U>
+        counting_allocator(const counting_allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) {
+            ++allocations;
+            ++live;
+            return static_cast<T*>(::operator new(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, size_t) noexcept {
+            --live;
+            ::operator delete(p);
+        }
+
+        friend bool operator==(const counting_allocator&, const counting_allocator&) noexcept { return true; }
+    };
+
+    static void test_block_allocation() {
+        using alloc   = counting_allocator<long>;
+        using counter = counting_allocator<unsigned char>;
+        constexpr int THREADS = 8, PER_THREAD = 5000;
+
+        // 获得块的第一个下标的线程预先分配下一个块
+        counter::allocations = 0;
+        int expected         = 0;
+        {
+            mystl::concurrent_vector<long, alloc> v;
+            v.push_back(0);
+            assert(counter::allocations == 2);
+            for (int i = 1; i < THREADS * PER_THREAD; ++i) { v.push_back(i); }
+            expected = counter::live.load();
+        }
+        assert(counter::live == 0);
+
+        // 多个线程同时追加时，重复分配的块被释放，保留的块与单线程时相同
+        for (int round = 0; round < 10; ++round) {
+            {
+                mystl::concurrent_vector<long, alloc> v;
+                std::atomic<bool> go{false};
+                std::vector<std::thread> threads;
+                for (int t = 0; t < THREADS; ++t) {
+                    threads.emplace_back([&] {
+                        while (!go.load(std::memory_order_acquire)) {}
+                        for (int i = 0; i < PER_THREAD; ++i) { v.push_back(i); }
+                    });
+                }
+                go.store(true, std::memory_order_release);
+                for (auto& th : threads) th.join();
+                assert(v.size() == size_t(THREADS) * PER_THREAD);
+                assert(counter::live == expected);
+            }
+            assert(counter::live == 0);
+        }
+
+        std::cout << "Concurrent vector block allocation test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_CONCURRENT_VECTOR_H
@@ -0,0 +1,104 @@
+#ifndef _MYSTL_TEST_EYTZINGER_INDEX_H
+#define _MYSTL_TEST_EYTZINGER_INDEX_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <eytzinger_index.h>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector.h>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class eytzinger_index_test {
+public:
+    static void test_all() {
+        test_lower_bound();
+        test_batch();
+        test_heterogeneous();
+    }
+
+    // 各种大小 (包括不满的最后一层) 与重复的键，结果与 std::lower_bound 一致
+    static void test_lower_bound() {
+        for (size_t n = 0; n < 70; ++n) {
+            mystl::vector<int> keys;
+            for (size_t i = 0; i < n; ++i) { keys.push_back(int(i / 3 * 2)); }
+            mystl::eytzinger_index<int> index(keys);
+            assert(index.size() == n && index.empty() == (n == 0));
+            for (int x = -1; x <= int(n); ++x) {
+                size_t expected = size_t(std::lower_bound(keys.begin(), keys.end(), x) - keys.begin());
+                assert(index.lower_bound(x) == expected);
+                assert(index.contains(x) == std::binary_search(keys.begin(), keys.end(), x));
+            }
+        }
+
+        // 降序的比较器
+        mystl::vector<int> desc = {9, 7, 7, 4, 1};
+        mystl::eytzinger_index<int, std::greater<int>> index(desc.begin(), desc.end());
+        assert(index.lower_bound(7) == 1 && index.lower_bound(5) == 3 && index.lower_bound(0) == 5);
+        assert(index.contains(4) && !index.contains(5));
+
+        // 重建时复用存储
+        index.assign(desc.begin(), desc.begin() + 2);
+        assert(index.size() == 2 && index.lower_bound(8) == 1);
+        index.clear();
+        assert(index.empty() && index.lower_bound(1) == 0 && !index.contains(1));
+
+        std::cout << "Eytzinger index lower_bound test passed" << std::endl;
+    }
+
+    static void test_batch() {
+        std::mt19937_64 gen(7);
+        mystl::vector<uint64_t> keys;
+        for (size_t i = 0; i < 5000; ++i) { keys.push_back(gen() % 20000); }
+        std::sort(keys.begin(), keys.end());
+        mystl::eytzinger_index<uint64_t> index(keys);
+
+        // 查找数不是组大小的整数倍
+        std::vector<uint64_t> queries;
+        for (size_t i = 0; i < 1000; ++i) { queries.push_back(gen() % 20010); }
+        std::vector<size_t> ranks(queries.size());
+        std::vector<bool> found;
+        assert(index.lower_bound_batch(queries.begin(), queries.end(), ranks.begin()) == ranks.end());
+        index.contains_batch(queries.begin(), queries.end(), std::back_inserter(found));
+        for (size_t i = 0; i < queries.size(); ++i) {
+            assert(ranks[i] == index.lower_bound(queries[i]));
+            assert(ranks[i] == size_t(std::lower_bound(keys.begin(), keys.end(), queries[i]) - keys.begin()));
+            assert(found[i] == index.contains(queries[i]));
+        }
+
+        // 空索引与空的查找区间
+        mystl::eytzinger_index<uint64_t> empty;
+        empty.lower_bound_batch(queries.begin(), queries.begin() + 3, ranks.begin());
+        assert(ranks[0] == 0 && ranks[2] == 0);
+        assert(index.lower_bound_batch(queries.begin(), queries.begin(), ranks.begin()) == ranks.begin());
+
+        std::cout << "Eytzinger index batch test passed" << std::endl;
+    }
+
+    // std::less<> 是透明的比较器，可以直接用 const char* 查找 std::string 的键，不构造临时的 std::string
+    static void test_heterogeneous() {
+        mystl::vector<std::string> keys = {"apple", "banana", "cherry", "grape", "melon"};
+        mystl::eytzinger_index<std::string, std::less<>> index(keys);
+        assert(index.lower_bound("cherry") == 2 && index.lower_bound("date") == 3 && index.lower_bound("zzz") == 5);
+        assert(index.contains("grape") && !index.contains("kiwi"));
+        assert(index.contains(std::string("melon")));
+
+        const char* queries[] = {"a", "banana", "fig", "melon"};
+        size_t ranks[4];
+        index.lower_bound_batch(std::begin(queries), std::end(queries), ranks);
+        assert(ranks[0] == 0 && ranks[1] == 1 && ranks[2] == 3 && ranks[3] == 4);
+
+        std::cout << "Eytzinger index heterogeneous lookup test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_EYTZINGER_INDEX_H
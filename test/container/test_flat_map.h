@@ -0,0 +1,238 @@
+#ifndef _MYSTL_TEST_FLAT_MAP_H
+#define _MYSTL_TEST_FLAT_MAP_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <flat_map.h>
+#include <flat_set.h>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class flat_map_test {
+public:
+    static void test_all() {
+        test_search();
+        test_batch_search();
+        test_flat_set();
+        test_flat_map();
+        test_bulk_insert();
+        test_merge_exception();
+    }
+
+    // 无分支二分查找与 std::lower_bound/upper_bound 的结果一致
+    static void test_search() {
+        std::less<int> comp;
+        for (int n = 0; n < 40; ++n) {
+            std::vector<int> v;
+            for (int i = 0; i < n; ++i) { v.push_back(i / 3 * 2); }
+            for (int x = -1; x <= n; ++x) {
+                assert(mystl::__branchless_lower_bound(v.begin(), v.size(), x, comp) == std::lower_bound(v.begin(), v.end(), x));
+                assert(mystl::__branchless_upper_bound(v.begin(), v.size(), x, comp) == std::upper_bound(v.begin(), v.end(), x));
+            }
+        }
+
+        std::cout << "Branchless binary search test passed" << std::endl;
+    }
+
+    // 批量查找与逐个 std::lower_bound 的结果一致，包括查找数不是组大小整数倍、空区间、重复的键
+    static void test_batch_search() {
+        std::mt19937 gen(3);
+        for (size_t n : {0, 1, 2, 7, 64, 1000}) {
+            mystl::vector<int> v;
+            for (size_t i = 0; i < n; ++i) { v.push_back(int(gen() % (n + 1))); }
+            std::sort(v.begin(), v.end());
+            std::vector<int> keys;
+            for (size_t i = 0; i < 37; ++i) { keys.push_back(int(gen() % (n + 3)) - 1); }
+
+            std::vector<mystl::vector<int>::const_iterator> out;
+            mystl::lower_bound_batch(v.cbegin(), v.cend(), keys.begin(), keys.end(), std::back_inserter(out));
+            std::vector<mystl::vector<int>::const_iterator> out4(keys.size());
+            assert(mystl::lower_bound_batch<4>(v.cbegin(), v.cend(), keys.begin(), keys.end(), out4.begin()) == out4.end());
+            std::vector<int*> out1(keys.size());
+            mystl::lower_bound_batch<1>(v.data(), v.data() + v.size(), keys.begin(), keys.end(), out1.begin());
+            for (size_t i = 0; i < keys.size(); ++i) {
+                auto expected = std::lower_bound(v.cbegin(), v.cend(), keys[i]);
+                assert(out[i] == expected && out4[i] == expected && out1[i] == v.data() + (expected - v.cbegin()));
+            }
+        }
+
+        // 范围版本与自定义比较器
+        mystl::vector<int> desc = {9, 7, 7, 4, 1};
+        int keys[]              = {10, 7, 5, 0};
+        mystl::vector<int>::iterator out[4];
+        mystl::lower_bound_batch(desc, keys, out, std::greater<int>());
+        assert(out[0] == desc.begin() && out[1] == desc.begin() + 1 && out[2] == desc.begin() + 3 && out[3] == desc.end());
+
+        std::cout << "Batched lower_bound test passed" << std::endl;
+    }
+
+    static void test_flat_set() {
+        mystl::flat_set<int> s = {5, 1, 3, 1, 5, 2};
+        assert(s.size() == 4 && std::is_sorted(s.begin(), s.end()));
+        assert(s.contains(3) && !s.contains(4) && s.count(1) == 1);
+        assert(*s.lower_bound(4) == 5 && s.upper_bound(5) == s.end());
+
+        auto [it, inserted] = s.insert(4);
+        assert(inserted && *it == 4 && s.size() == 5);
+        assert(!s.insert(4).second && s.size() == 5);
+        assert(s.erase(1) == 1 && s.erase(1) == 0);
+
+        auto keys = std::move(s).extract();
+        assert(s.empty() && keys.size() == 4 && keys[0] == 2);
+        keys.push_back(10);
+        s.replace(std::move(keys));
+        assert(s.size() == 5 && *(s.end() - 1) == 10);
+
+        mystl::flat_set<int, std::greater<int>> g(mystl::vector<int>{1, 4, 2, 4});
+        assert(g.size() == 3 && *g.begin() == 4);
+
+        assert(mystl::erase_if(s, [](int x) { return x % 2 == 0; }) == 3 && s.size() == 2 && *s.begin() == 3);
+
+        std::cout << "Flat set test passed" << std::endl;
+    }
+
+    static void test_flat_map() {
+        mystl::flat_map<std::string, int> m = {{"b", 2}, {"a", 1}, {"c", 3}, {"a", 10}};
+        assert(m.size() == 3 && m.at("a") == 1);
+        assert(std::is_sorted(m.keys().begin(), m.keys().end()));
+
+        m["d"] = 4;
+        ++m["a"];
+        assert(m.size() == 4 && m["a"] == 2 && m.values()[3] == 4);
+
+        auto [it, inserted] = m.try_emplace("b", 20);
+        assert(!inserted && it->second == 2);
+        assert(!m.insert_or_assign("b", 20).second && m.at("b") == 20);
+        assert(m.emplace("e", 5).second && m.find("e")->second == 5);
+
+        // 代理引用
+        for (auto [k, v] : m) { v += 100; }
+        assert(m.at("c") == 103);
+        const auto& cm = m;
+        assert((*cm.find("c")).second == 103 && cm.find("z") == cm.end());
+
+        auto [lo, hi] = m.equal_range("c");
+        assert(hi - lo == 1 && lo->first == "c");
+        assert(m.lower_bound("bb")->first == "c" && m.upper_bound("c")->first == "d");
+
+        bool thrown = false;
+        try {
+            m.at("z");
+        } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown);
+
+        assert(m.erase("a") == 1 && !m.contains("a"));
+        auto next = m.erase(m.begin());
+        assert(next->first == "c" && m.size() == 3);
+
+        auto c = std::move(m).extract();
+        assert(m.empty() && c.keys.size() == 3 && c.values.size() == 3 && c.keys[0] == "c");
+        m.replace(std::move(c.keys), std::move(c.values));
+        assert(m.size() == 3);
+
+        assert(mystl::erase_if(m, [](const auto& kv) { return kv.second > 104; }) == 1 && m.size() == 2);
+
+        std::cout << "Flat map test passed" << std::endl;
+    }
+
+    static void test_bulk_insert() {
+        std::mt19937 gen(7);
+        std::map<int, int> ref;
+        mystl::flat_map<int, int> m;
+        for (int round = 0; round < 20; ++round) {
+            // 有序且唯一的批量插入，与已有的键部分重复
+            std::map<int, int> batch;
+            for (int i = 0; i < 200; ++i) { batch.emplace(int(gen() % 2000), round); }
+            std::vector<std::pair<int, int>> sorted(batch.begin(), batch.end());
+            m.insert(mystl::sorted_unique, sorted.begin(), sorted.end());
+            for (auto& kv : batch) { ref.emplace(kv); }
+
+            // 无序且有重复的批量插入
+            std::vector<std::pair<int, int>> unsorted;
+            for (int i = 0; i < 100; ++i) { unsorted.emplace_back(int(gen() % 2000), -round); }
+            m.insert(unsorted.begin(), unsorted.end());
+            for (auto& kv : unsorted) { ref.emplace(kv); }
+
+            assert(m.size() == ref.size());
+            assert(std::equal(ref.begin(), ref.end(), m.begin(), m.end(),
+                              [](const auto& a, const auto& b) { return a.first == b.first && a.second == b.second; }));
+        }
+
+        std::set<int> sref;
+        mystl::flat_set<int> s;
+        for (int round = 0; round < 20; ++round) {
+            std::set<int> batch;
+            for (int i = 0; i < 200; ++i) { batch.insert(int(gen() % 2000)); }
+            s.insert(mystl::sorted_unique, batch.begin(), batch.end());
+            sref.insert(batch.begin(), batch.end());
+            assert(std::equal(sref.begin(), sref.end(), s.begin(), s.end()));
+        }
+
+        mystl::flat_map<int, int> sm(mystl::sorted_unique, {{1, 1}, {2, 2}});
+        assert(sm.size() == 2 && sm.at(2) == 2);
+
+        std::cout << "Flat map bulk insert test passed" << std::endl;
+    }
+
+    // 拷贝到第 budget 次时抛出异常，移动构造没有声明 noexcept
+    struct throwing_value {
+        static inline int budget = -1;
+        int v                    = 0;
+
+        throwing_value(int x) : v(x) {}
+
+        throwing_value(const throwing_value& other) : v(other.v) {
+            if (budget == 0) { throw std::runtime_error("throwing_value"); }
+            if (budget > 0) { --budget; }
+        }
+
+        throwing_value(throwing_value&& other) : v(other.v) {}
+
+        throwing_value& operator=(const throwing_value&) = default;
+        throwing_value& operator=(throwing_value&&)      = default;
+    };
+
+    static void test_merge_exception() {
+        mystl::flat_map<std::string, throwing_value> m;
+        for (int i = 0; i < 20; i += 2) { m.try_emplace(std::to_string(100 + i), i); }
+
+        // 在每一次拷贝处抛出异常，覆盖拷贝新元素与归并原有元素的途中失败，失败时 m 不变
+        std::vector<std::pair<std::string, throwing_value>> batch;
+        for (int i = 1; i < 20; i += 2) { batch.emplace_back(std::to_string(100 + i), i); }
+        int failures = 0;
+        for (int budget = 0;; ++budget) {
+            throwing_value::budget = budget;
+            bool thrown            = false;
+            try {
+                m.insert(mystl::sorted_unique, batch.begin(), batch.end());
+            } catch (const std::runtime_error&) { thrown = true; }
+            throwing_value::budget = -1;
+            if (!thrown) { break; }
+            ++failures;
+            assert(m.size() == 10);
+            for (int i = 0; i < 20; i += 2) { assert(m.at(std::to_string(100 + i)).v == i); }
+        }
+        assert(failures > 10);
+
+        m.insert(mystl::sorted_unique, batch.begin(), batch.end());
+        assert(m.size() == 20);
+        for (int i = 0; i < 20; ++i) { assert(m.at(std::to_string(100 + i)).v == i); }
+
+        std::cout << "Flat map merge exception test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_FLAT_MAP_H
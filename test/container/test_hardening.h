@@ -0,0 +1,89 @@
+#ifndef _MYSTL_TEST_HARDENING_H
+#define _MYSTL_TEST_HARDENING_H
+
+#include "test.h"
+
+#include <cassert>
+#include <csignal>
+#include <iostream>
+#include <list.h>
+#include <memory>
+#include <segmented_vector.h>
+#include <soa_vector.h>
+#include <span>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector.h>
+#include <vector_io.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class hardening_test {
+public:
+    static void test_all() {
+#if _MYSTL_HARDENING_MODE >= _MYSTL_HARDENING_MODE_FAST
+        test_checks();
+#endif
+    }
+
+    // 在子进程中执行 f，返回子进程是否被信号终止
+    template <class F>
+    static bool dies(F f) {
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid == 0) {
+            // debug 模式的失败信息不需要输出到测试结果中
+            freopen("/dev/null", "w", stderr);
+            f();
+            _exit(0);
+        }
+        int status = 0;
+        waitpid(pid, &status, 0);
+        return WIFSIGNALED(status);
+    }
+
+    static void test_checks() {
+        mystl::vector<int> v = {1, 2, 3};
+        mystl::vector<int> e;
+        mystl::list<int> l;
+
+        assert(!dies([&] { v[2] = 4; }));
+        assert(dies([&] { v[3] = 4; }));
+        assert(dies([&] { e.front(); }));
+        assert(dies([&] { e.back(); }));
+        assert(dies([&] { e.pop_back(); }));
+        assert(dies([&] { v.erase(v.end()); }));
+        assert(dies([&] { v.erase(v.begin() + 2, v.begin() + 1); }));
+        assert(dies([&] { l.front(); }));
+        assert(dies([&] { l.pop_front(); }));
+        assert(dies([&] { l.erase(l.end()); }));
+
+        // 其他容器的检查同样由 _MYSTL_HARDENING_MODE 控制，而不是 NDEBUG
+        mystl::segmented_vector<int> sv;
+        mystl::soa_vector<int, double> soa;
+        assert(dies([&] { sv.pop_back(); }));
+        assert(dies([&] { (void)soa[0]; }));
+        // 同一个 vector 传入两次时两个 iovec 指向同一段空余容量
+        mystl::vector<char> io;
+        assert(dies([&] { (void)mystl::readv_append(-1, {1, 1}, io, io); }));
+
+#if _MYSTL_HARDENING_MODE >= _MYSTL_HARDENING_MODE_DEBUG
+        // 只在 debug 模式下检查
+        assert(dies([&] { v.insert(e.begin(), 1); }));
+        assert(dies([&] { v.erase(e.begin(), e.begin()); }));
+        assert(dies([&] { (void)*mystl::vector<int>::iterator(); }));
+        // 空容器的 begin() 为空指针，取地址不是解引用，不应触发检查
+        assert(!dies([&] { (void)std::to_address(e.begin()); }));
+        assert(!dies([&] { (void)std::span<int>(e.begin(), e.end()).size(); }));
+        assert(dies([&] { l.splice(l.begin(), l); }));
+        mystl::vector<bool> b1(3), b2(5);
+        assert(dies([&] { b1 &= b2; }));
+#endif
+
+        std::cout << "Hardening checks test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_HARDENING_H
@@ -0,0 +1,167 @@
+#ifndef _MYSTL_TEST_INCREMENTAL_VECTOR_H
+#define _MYSTL_TEST_INCREMENTAL_VECTOR_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <incremental_vector.h>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class incremental_vector_test {
+public:
+    static void test_all() {
+        test_push_back();
+        test_migration();
+        test_pop_back();
+        test_copy_move();
+        test_exception();
+    }
+
+    static void test_push_back() {
+        mystl::incremental_vector<std::string> v;
+        assert(v.empty() && v.capacity() == 0 && !v.migrating());
+        for (int i = 0; i < 10000; ++i) {
+            v.push_back(std::to_string(i));
+            // 容量翻倍时，新空间写满之前迁移已经完成
+            assert(v.size() < v.capacity() || !v.migrating());
+        }
+        assert(v.size() == 10000 && v.front() == "0" && v.back() == "9999");
+        for (int i = 0; i < 10000; ++i) { assert(v[i] == std::to_string(i)); }
+
+        // 参数引用容器中的元素，扩容后仍然有效
+        mystl::incremental_vector<std::string> w = {"a", "b"};
+        while (w.size() < w.capacity()) { w.push_back(w[0]); }
+        w.push_back(w[0]);
+        w.emplace_back(w[1]);
+        assert(w.back() == "b" && w[w.size() - 2] == "a");
+
+        bool thrown = false;
+        try {
+            v.at(10000);
+        } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown);
+
+        std::cout << "Incremental vector push_back test passed" << std::endl;
+    }
+
+    static void test_migration() {
+        mystl::incremental_vector<int> v;
+        v.set_migration_step(1);
+        v.reserve(1000);
+        for (int i = 0; i < 1000; ++i) { v.push_back(i); }
+        assert(!v.migrating());
+
+        // 扩容后旧元素留在旧空间中，每次 push_back 只迁移一部分
+        v.push_back(1000);
+        assert(v.migrating() && v.capacity() == 2000);
+        assert(v[0] == 0 && v[999] == 999 && v[1000] == 1000);
+        assert(std::is_sorted(v.begin(), v.end()) && v.end() - v.begin() == 1001);
+
+        // 迭代器跨越新旧空间
+        assert(std::accumulate(v.cbegin(), v.cend(), 0L) == 1000L * 1001 / 2);
+        for (int& x : v) { x *= 2; }
+        assert(v[500] == 1000 && v[1000] == 2000);
+
+        // 后台推进迁移
+        while (v.migrate_step(100)) {}
+        assert(!v.migrating() && v[999] == 1998);
+
+        v.reserve(5000);
+        assert(v.migrating());
+        int* p = v.data();
+        assert(!v.migrating() && p[1000] == 2000);
+
+        std::cout << "Incremental vector migration test passed" << std::endl;
+    }
+
+    static void test_pop_back() {
+        mystl::incremental_vector<std::string> v;
+        v.set_migration_step(1);
+        for (int i = 0; i < 64; ++i) { v.push_back(std::to_string(i)); }
+        v.push_back("64");
+        assert(v.migrating());
+
+        // 删除新空间中的元素后继续删除旧空间中的元素，旧空间的元素删完后释放旧空间
+        while (v.size() > 10) { v.pop_back(); }
+        assert(v.migrating() && v.back() == "9" && v[5] == "5");
+        v.push_back("x");
+        assert(v.size() == 11 && v[10] == "x" && v[9] == "9");
+        while (v.size() > 1) { v.pop_back(); }
+        assert(!v.migrating() && v.back() == "0");
+
+        v.clear();
+        assert(v.empty() && !v.migrating());
+
+        std::cout << "Incremental vector pop_back test passed" << std::endl;
+    }
+
+    static void test_copy_move() {
+        mystl::incremental_vector<std::string> v;
+        v.set_migration_step(1);
+        for (int i = 0; i < 33; ++i) { v.push_back(std::to_string(i)); }
+        assert(v.migrating());
+
+        mystl::incremental_vector<std::string> c(v);
+        assert(c.size() == 33 && !c.migrating() && std::equal(c.begin(), c.end(), v.begin()));
+
+        mystl::incremental_vector<std::string> m(std::move(v));
+        assert(v.empty() && m.migrating() && m[20] == "20");
+
+        v = m;
+        assert(v.size() == 33 && v[32] == "32");
+        c = std::move(m);
+        assert(m.empty() && c.size() == 33 && c[0] == "0");
+
+        swap(c, m);
+        assert(c.empty() && m.size() == 33);
+
+        std::cout << "Incremental vector copy/move test passed" << std::endl;
+    }
+
+    // 移动构造可能抛出异常时迁移使用拷贝构造，拷贝构造抛出异常时未迁移的元素保持在旧空间中
+    struct ThrowOnCopy {
+        static inline int budget = -1;
+        int value;
+
+        ThrowOnCopy(int x) : value(x) {}
+
+        ThrowOnCopy(const ThrowOnCopy& other) : value(other.value) {
+            if (budget == 0) { throw std::runtime_error("copy"); }
+            if (budget > 0) { --budget; }
+        }
+
+        ThrowOnCopy(ThrowOnCopy&& other) : value(other.value) {}
+    };
+
+    static void test_exception() {
+        mystl::incremental_vector<ThrowOnCopy> v;
+        v.set_migration_step(4);
+        for (int i = 0; i < 16; ++i) { v.emplace_back(i); }
+        v.emplace_back(16);
+        assert(v.migrating());
+
+        ThrowOnCopy::budget = 1;
+        bool thrown         = false;
+        try {
+            v.migrate_step(4);
+        } catch (const std::runtime_error&) { thrown = true; }
+        ThrowOnCopy::budget = -1;
+        assert(thrown && v.migrating() && v.size() == 17);
+        for (int i = 0; i < 17; ++i) { assert(v[i].value == i); }
+
+        v.finish_migration();
+        assert(!v.migrating() && v[3].value == 3);
+
+        std::cout << "Incremental vector exception test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_INCREMENTAL_VECTOR_H
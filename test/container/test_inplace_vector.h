@@ -0,0 +1,147 @@
+#ifndef _MYSTL_TEST_INPLACE_VECTOR_H
+#define _MYSTL_TEST_INPLACE_VECTOR_H
+
+#include "test.h"
+
+#include <cassert>
+#include <cstdint>
+#include <inplace_vector.h>
+#include <iostream>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class inplace_vector_test {
+public:
+    static void test_all() {
+        test_layout();
+        test_construct();
+        test_modifier();
+        test_copy_move();
+    }
+
+    static void test_layout() {
+        // 平凡可拷贝的元素类型使 inplace_vector 同样平凡可拷贝
+        static_assert(std::is_trivially_copyable_v<mystl::inplace_vector<int, 8>>);
+        static_assert(!std::is_trivially_copyable_v<mystl::inplace_vector<std::string, 8>>);
+        // size 使用最小的整数类型存储
+        static_assert(sizeof(mystl::inplace_vector<uint8_t, 15>) == 16);
+        static_assert(sizeof(mystl::inplace_vector<uint32_t, 4>) == 20);
+        static_assert(mystl::inplace_vector<int, 8>::capacity() == 8);
+
+        std::cout << "Inplace vector layout test passed" << std::endl;
+    }
+
+    static void test_construct() {
+        mystl::inplace_vector<int, 8> v0;
+        assert(v0.empty());
+
+        mystl::inplace_vector<int, 8> v1(5, 3);
+        std::vector<int> sv1(5, 3);
+        assert(is_same(sv1, v1));
+
+        mystl::inplace_vector<std::string, 4> v2 = {"a", "b", "c"};
+        std::vector<std::string> sv2             = {"a", "b", "c"};
+        assert(is_same(sv2, v2));
+
+        bool thrown = false;
+        try {
+            mystl::inplace_vector<int, 2> v3 = {1, 2, 3};
+            (void)v3;
+        } catch (const std::bad_alloc&) { thrown = true; }
+        assert(thrown);
+
+        std::cout << "Inplace vector construction test passed" << std::endl;
+    }
+
+    static void test_modifier() {
+        mystl::inplace_vector<int, 4> v;
+        assert(v.try_push_back(1) != nullptr);
+        v.unchecked_push_back(2);
+        v.push_back(3);
+        assert(*v.try_emplace_back(4) == 4);
+        assert(v.full());
+
+        // 已满时 try_push_back 返回 nullptr 且不修改容器
+        assert(v.try_push_back(5) == nullptr && v.size() == 4);
+        bool thrown = false;
+        try {
+            v.push_back(5);
+        } catch (const std::bad_alloc&) { thrown = true; }
+        assert(thrown && v.size() == 4);
+
+        std::vector<int> sv = {1, 2, 3, 4};
+        v.erase(v.begin() + 1);
+        sv.erase(sv.begin() + 1);
+        assert(is_same(sv, v));
+
+        v.insert(v.begin(), 10);
+        sv.insert(sv.begin(), 10);
+        assert(is_same(sv, v));
+
+        v.pop_back();
+        sv.pop_back();
+        v.pop_back();
+        sv.pop_back();
+        v.insert(v.begin() + 1, {20, 21});
+        sv.insert(sv.begin() + 1, {20, 21});
+        assert(is_same(sv, v));
+
+        v.resize(1);
+        sv.resize(1);
+        v.resize(3, 7);
+        sv.resize(3, 7);
+        assert(is_same(sv, v));
+
+        v.assign(2, 9);
+        sv.assign(2, 9);
+        assert(is_same(sv, v));
+
+        std::cout << "Inplace vector modifier test passed" << std::endl;
+    }
+
+    static void test_copy_move() {
+        mystl::inplace_vector<std::string, 4> a = {"a", "b", "c"};
+        mystl::inplace_vector<std::string, 4> b(a);
+        assert(b.size() == 3 && b[2] == "c");
+
+        mystl::inplace_vector<std::string, 4> c(std::move(b));
+        assert(c.size() == 3 && c[0] == "a");
+
+        mystl::inplace_vector<std::string, 4> d = {"x"};
+        d                                       = a;
+        assert(d.size() == 3 && d[1] == "b");
+        d = {"y"};
+        assert(d.size() == 1 && d[0] == "y");
+
+        d.swap(a);
+        assert(d.size() == 3 && a.size() == 1 && a[0] == "y" && d[2] == "c");
+
+        mystl::inplace_vector<int, 4> e = {1, 2};
+        mystl::inplace_vector<int, 4> f = e;
+        assert(f.size() == 2 && f[1] == 2);
+
+        std::cout << "Inplace vector copy/move test passed" << std::endl;
+    }
+
+private:
+    template <class T, size_t N>
+    static bool is_same(const std::vector<T>& sv, const mystl::inplace_vector<T, N>& v) {
+        if (sv.size() != v.size()) return false;
+        auto it1 = sv.begin();
+        auto it2 = v.begin();
+        while (it1 != sv.end() && it2 != v.end()) {
+            if (*it1 != *it2) return false;
+            ++it1;
+            ++it2;
+        }
+        return true;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_INPLACE_VECTOR_H
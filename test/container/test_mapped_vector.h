@@ -0,0 +1,95 @@
+#ifndef _MYSTL_TEST_MAPPED_VECTOR_H
+#define _MYSTL_TEST_MAPPED_VECTOR_H
+
+#include "test.h"
+
+#include <cassert>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mapped_vector.h>
+#include <string>
+#include <system_error>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class mapped_vector_test {
+public:
+    static void test_all() {
+        test_read_write();
+        test_read_only();
+    }
+
+    static void test_read_write() {
+        std::string path = temp_path();
+        std::remove(path.c_str());
+
+        {
+            mystl::mapped_vector<int> v(path.c_str(), mystl::map_mode::read_write);
+            assert(v.is_open() && v.empty());
+            // 第一次增长至少映射一页
+            v.push_back(0);
+            assert(v.capacity() >= 4096 / sizeof(int));
+            v.pop_back();
+            for (int i = 0; i < 5000; ++i) { v.push_back(i); }
+            assert(v.size() == 5000 && v.capacity() >= 5000);
+            int extra[3] = {-1, -2, -3};
+            v.append(extra, 3);
+            v.flush();
+            v.resize(5010, 7);
+            assert(v[5002] == -3 && v.back() == 7);
+        }
+        // 关闭后文件长度等于 size() * sizeof(int)
+        assert(std::filesystem::file_size(path) == 5010 * sizeof(int));
+
+        {
+            // 重新打开后继续增长
+            mystl::mapped_vector<int> v(path.c_str(), mystl::map_mode::read_write);
+            assert(v.size() == 5010 && v[4999] == 4999);
+            v.pop_back();
+            v.emplace_back(42);
+            v.shrink_to_fit();
+            assert(v.capacity() == v.size());
+            v.close();
+            assert(!v.is_open());
+        }
+
+        std::remove(path.c_str());
+        std::cout << "Mapped vector read/write test passed" << std::endl;
+    }
+
+    static void test_read_only() {
+        std::string path = temp_path();
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            for (int i = 0; i < 1000; ++i) { out.write(reinterpret_cast<const char*>(&i), sizeof(i)); }
+        }
+
+        mystl::mapped_vector<int> v(path.c_str());
+        assert(v.mode() == mystl::map_mode::read_only && v.size() == 1000);
+        long long sum = 0;
+        for (int x : v) { sum += x; }
+        assert(sum == 999LL * 1000 / 2);
+
+        mystl::mapped_vector<int> w(std::move(v));
+        assert(!v.is_open() && w.size() == 1000 && w.at(10) == 10);
+
+        bool thrown = false;
+        try {
+            mystl::mapped_vector<int> bad("/nonexistent/mapped_vector.bin");
+        } catch (const std::system_error&) { thrown = true; }
+        assert(thrown);
+
+        w.close();
+        std::remove(path.c_str());
+        std::cout << "Mapped vector read-only test passed" << std::endl;
+    }
+
+private:
+    static std::string temp_path() { return (std::filesystem::temp_directory_path() / "mystl_mapped_vector_test.bin").string(); }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_MAPPED_VECTOR_H
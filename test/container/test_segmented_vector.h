@@ -0,0 +1,100 @@
+#ifndef _MYSTL_TEST_SEGMENTED_VECTOR_H
+#define _MYSTL_TEST_SEGMENTED_VECTOR_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <segmented_vector.h>
+#include <string>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class segmented_vector_test {
+public:
+    static void test_all() {
+        test_construct();
+        test_stability();
+        test_modifier();
+    }
+
+    static void test_construct() {
+        mystl::segmented_vector<int> v0;
+        assert(v0.empty() && v0.capacity() == 0);
+
+        mystl::segmented_vector<int> v1(1000, 3);
+        assert(v1.size() == 1000 && std::count(v1.begin(), v1.end(), 3) == 1000);
+
+        mystl::segmented_vector<std::string> v2 = {"a", "b", "c"};
+        assert(v2.size() == 3 && v2[2] == "c");
+
+        mystl::segmented_vector<std::string> v3(v2);
+        assert(v3.size() == 3 && v3.front() == "a");
+        mystl::segmented_vector<std::string> v4(std::move(v3));
+        assert(v4.size() == 3 && v3.empty());
+        v3 = v4;
+        assert(v3.size() == 3 && v3.back() == "c");
+
+        std::vector<int> src(5000);
+        std::iota(src.begin(), src.end(), 0);
+        mystl::segmented_vector<int> v5(src.begin(), src.end());
+        assert(std::equal(src.begin(), src.end(), v5.begin(), v5.end()));
+
+        std::cout << "Segmented vector construction test passed" << std::endl;
+    }
+
+    static void test_stability() {
+        mystl::segmented_vector<int> v;
+        std::vector<int*> ptrs;
+        for (int i = 0; i < 100000; ++i) { ptrs.push_back(&v.emplace_back(i)); }
+        // 增长过程中没有元素被移动
+        for (int i = 0; i < 100000; ++i) {
+            assert(ptrs[i] == &v[i] && *ptrs[i] == i);
+        }
+
+        // 随机访问与迭代器
+        auto it = v.begin() + 70000;
+        assert(*it == 70000 && it[5] == 70005 && v.end() - it == 30000);
+        assert(*(v.rbegin()) == 99999);
+        long long sum = 0;
+        v.for_each_segment([&](int* first, int* last) {
+            for (; first != last; ++first) sum += *first;
+        });
+        assert(sum == 99999LL * 100000 / 2);
+
+        std::cout << "Segmented vector stability test passed" << std::endl;
+    }
+
+    static void test_modifier() {
+        mystl::segmented_vector<std::string> v;
+        for (int i = 0; i < 300; ++i) { v.push_back(std::to_string(i)); }
+        v.pop_back();
+        assert(v.size() == 299 && v.back() == "298");
+
+        v.resize(10);
+        assert(v.size() == 10 && v[9] == "9");
+        size_t cap = v.capacity();
+        v.shrink_to_fit();
+        assert(v.capacity() < cap && v.capacity() >= 10);
+        v.resize(20, "x");
+        assert(v[19] == "x");
+
+        mystl::segmented_vector<std::string> w = {"y"};
+        v.swap(w);
+        assert(v.size() == 1 && w.size() == 20);
+
+        v.clear();
+        assert(v.empty());
+        v.reserve(1000);
+        assert(v.capacity() >= 1000);
+
+        std::cout << "Segmented vector modifier test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_SEGMENTED_VECTOR_H
@@ -0,0 +1,213 @@
+#ifndef _MYSTL_TEST_SERIALIZE_H
+#define _MYSTL_TEST_SERIALIZE_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <serialize.h>
+#include <sstream>
+#include <streambuf>
+#include <string>
+
+namespace mystl {
+
+// 自定义 codec：长度前缀加字符
+template <>
+struct codec<std::string> {
+    static void encode(std::ostream& os, const std::string& s) {
+        uint32_t n = static_cast<uint32_t>(s.size());
+        os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+        os.write(s.data(), n);
+    }
+
+    static std::string decode(std::istream& is) {
+        uint32_t n = 0;
+        is.read(reinterpret_cast<char*>(&n), sizeof(n));
+        std::string s(n, '\0');
+        is.read(s.data(), n);
+        return s;
+    }
+};
+
+} // namespace mystl
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class serialize_test {
+public:
+    static void test_all() {
+        test_vector();
+        test_list();
+        test_error();
+    }
+
+    struct point {
+        int x;
+        double y;
+    };
+
+    static void test_vector() {
+        mystl::vector<point> v;
+        for (int i = 0; i < 10000; ++i) { v.push_back({i, i * 0.5}); }
+        std::stringstream ss;
+        mystl::save(ss, v);
+        // 头部加一次整体写入
+        assert(ss.str().size() == 24 + v.size() * sizeof(point));
+
+        mystl::vector<point> w = {{-1, -1.0}};
+        mystl::load(ss, w);
+        assert(w.size() == v.size());
+        for (size_t i = 0; i < v.size(); ++i) { assert(w[i].x == v[i].x && w[i].y == v[i].y); }
+
+        mystl::vector<std::string> vs = {"alpha", "", "gamma"};
+        std::stringstream ss2;
+        mystl::save(ss2, vs);
+        mystl::vector<std::string> ws;
+        mystl::load(ss2, ws);
+        assert(ws.size() == 3 && ws[0] == "alpha" && ws[1].empty() && ws[2] == "gamma");
+
+        mystl::vector<int> empty;
+        std::stringstream ss3;
+        mystl::save(ss3, empty);
+        mystl::vector<int> we = {1, 2};
+        mystl::load(ss3, we);
+        assert(we.empty());
+
+        std::cout << "Serialize vector test passed" << std::endl;
+    }
+
+    static void test_list() {
+        // 超过一个块的元素数量
+        mystl::list<uint64_t> l;
+        for (uint64_t i = 0; i < 5000; ++i) { l.push_back(i * i); }
+        std::stringstream ss;
+        mystl::save(ss, l);
+
+        mystl::list<uint64_t> m;
+        mystl::load(ss, m);
+        assert(m.size() == l.size());
+        uint64_t i = 0;
+        for (uint64_t x : m) {
+            assert(x == i * i);
+            ++i;
+        }
+
+        // list 与 vector 的快照格式相同
+        std::stringstream ss2;
+        mystl::save(ss2, l);
+        mystl::vector<uint64_t> v;
+        mystl::load(ss2, v);
+        assert(v.size() == 5000 && v[4999] == 4999ull * 4999ull);
+
+        mystl::list<std::string> ls = {"a", "bc"};
+        std::stringstream ss3;
+        mystl::save(ss3, ls);
+        mystl::list<std::string> ms;
+        mystl::load(ss3, ms);
+        assert(ms.size() == 2 && ms.back() == "bc");
+
+        std::cout << "Serialize list test passed" << std::endl;
+    }
+
+    // 只能顺序读取的流缓冲区，seekoff/seekpos 使用 std::streambuf 默认的实现，总是失败
+    struct no_seek_buf : std::streambuf {
+        explicit no_seek_buf(std::string& s) { setg(s.data(), s.data(), s.data() + s.size()); }
+    };
+
+    static void test_error() {
+        mystl::vector<int> v = {1, 2, 3};
+        std::stringstream ss;
+        mystl::save(ss, v);
+        std::string bytes = ss.str();
+
+        // 元素类型不同
+        {
+            std::stringstream in(bytes);
+            mystl::vector<double> w;
+            bool thrown = false;
+            try {
+                mystl::load(in, w);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown);
+        }
+        // 数据被截断时保留读取成功的前缀
+        {
+            std::stringstream in(bytes.substr(0, bytes.size() - 2));
+            mystl::vector<int> w;
+            bool thrown = false;
+            try {
+                mystl::load(in, w);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown && w.size() == 2 && w[1] == 2);
+        }
+        // 快照头声称 2^40 个元素，实际只有 3 个：不按头中的元素数分配内存，报告截断并保留已读取的元素
+        {
+            std::string forged = bytes;
+            uint64_t count     = uint64_t(1) << 40;
+            std::memcpy(&forged[16], &count, sizeof(count));
+            std::stringstream in(forged);
+            mystl::vector<int> w;
+            bool thrown = false;
+            try {
+                mystl::load(in, w);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown && w.size() == 3 && w[2] == 3 && w.capacity() < 1024);
+
+            // 不支持定位的流，从一块开始按倍数增长
+            no_seek_buf buf(forged);
+            std::istream in_no_seek(&buf);
+            mystl::vector<int> w2;
+            thrown = false;
+            try {
+                mystl::load(in_no_seek, w2);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown && w2.size() == 3 && w2[2] == 3);
+
+            // 自定义 codec 的元素
+            mystl::vector<std::string> ws = {"a", "bc"};
+            std::stringstream out;
+            mystl::save(out, ws);
+            std::string forged_ws = out.str();
+            std::memcpy(&forged_ws[16], &count, sizeof(count));
+            std::stringstream in2(forged_ws);
+            thrown = false;
+            try {
+                mystl::load(in2, ws);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown && ws.size() == 2 && ws[1] == "bc");
+        }
+        // 不能定位的流中多于一块的 codec 元素，容量随读到的数据增长
+        {
+            mystl::vector<std::string> ws;
+            for (int i = 0; i < 5000; ++i) { ws.push_back(std::to_string(i)); }
+            std::stringstream out;
+            mystl::save(out, ws);
+            std::string saved = out.str();
+            no_seek_buf buf(saved);
+            std::istream in(&buf);
+            mystl::vector<std::string> loaded;
+            mystl::load(in, loaded);
+            assert(loaded.size() == 5000 && std::equal(loaded.begin(), loaded.end(), ws.begin()));
+        }
+        // 魔数错误
+        {
+            std::stringstream in("garbage that is long enough to be a header");
+            mystl::list<int> l;
+            bool thrown = false;
+            try {
+                mystl::load(in, l);
+            } catch (const mystl::snapshot_error&) { thrown = true; }
+            assert(thrown);
+        }
+
+        std::cout << "Serialize error test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_SERIALIZE_H
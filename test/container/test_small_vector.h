@@ -0,0 +1,194 @@
+#ifndef _MYSTL_TEST_SMALL_VECTOR_H
+#define _MYSTL_TEST_SMALL_VECTOR_H
+
+#include "test.h"
+
+#include <cassert>
+#include <iostream>
+#include <small_vector.h>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class small_vector_test {
+public:
+    static void test_all() {
+        test_construct();
+        test_spill();
+        test_modifier();
+        test_copy_move();
+    }
+
+    static void test_construct() {
+        mystl::small_vector<int, 4> v0;
+        assert(v0.empty() && v0.is_inline() && v0.capacity() == 4);
+
+        mystl::small_vector<int, 4> v1(3, 7);
+        std::vector<int> sv1(3, 7);
+        assert(v1.is_inline() && is_same(sv1, v1));
+
+        mystl::small_vector<int, 4> v2(10);
+        assert(!v2.is_inline() && v2.size() == 10);
+
+        mystl::small_vector<std::string, 2> v3 = {"a", "b", "c"};
+        std::vector<std::string> sv3           = {"a", "b", "c"};
+        assert(!v3.is_inline() && is_same(sv3, v3));
+
+        std::cout << "Small vector construction test passed" << std::endl;
+    }
+
+    static void test_spill() {
+        mystl::small_vector<int, 8> v;
+        std::vector<int> sv;
+        for (int i = 0; i < 8; ++i) {
+            v.push_back(i);
+            sv.push_back(i);
+        }
+        assert(v.is_inline() && is_same(sv, v));
+
+        // 超出内联容量后迁移到堆上
+        v.push_back(8);
+        sv.push_back(8);
+        assert(!v.is_inline() && v.capacity() == 16 && is_same(sv, v));
+
+        // 元素数量足够少时 shrink_to_fit 迁回内联存储
+        v.erase(v.begin() + 2, v.end());
+        sv.erase(sv.begin() + 2, sv.end());
+        v.shrink_to_fit();
+        assert(v.is_inline() && is_same(sv, v));
+
+        // push_back 引用自身元素
+        mystl::small_vector<std::string, 1> vs = {"x"};
+        vs.push_back(vs[0]);
+        vs.push_back(vs[1]);
+        assert(vs.size() == 3 && vs[2] == "x");
+
+        std::cout << "Small vector spill test passed" << std::endl;
+    }
+
+    static void test_modifier() {
+        mystl::small_vector<int, 4> v = {1, 2, 3};
+        std::vector<int> sv           = {1, 2, 3};
+
+        v.insert(v.begin() + 1, 10);
+        sv.insert(sv.begin() + 1, 10);
+        assert(is_same(sv, v));
+
+        v.insert(v.begin(), 3, v[2]);
+        sv.insert(sv.begin(), 3, sv[2]);
+        assert(is_same(sv, v));
+
+        std::vector<int> src = {7, 8, 9};
+        v.insert(v.begin() + 2, src.begin(), src.end());
+        sv.insert(sv.begin() + 2, src.begin(), src.end());
+        assert(is_same(sv, v));
+
+        v.emplace(v.end(), 42);
+        sv.emplace(sv.end(), 42);
+        v.emplace(v.begin() + 3, 43);
+        sv.emplace(sv.begin() + 3, 43);
+        assert(is_same(sv, v));
+
+        v.erase(v.begin());
+        sv.erase(sv.begin());
+        v.pop_back();
+        sv.pop_back();
+        assert(is_same(sv, v));
+
+        v.resize(20, 5);
+        sv.resize(20, 5);
+        assert(is_same(sv, v));
+        v.resize(2);
+        sv.resize(2);
+        assert(is_same(sv, v));
+
+        v.assign(3, 9);
+        sv.assign(3, 9);
+        assert(is_same(sv, v));
+
+        v.clear();
+        assert(v.empty());
+
+        std::cout << "Small vector modifier test passed" << std::endl;
+    }
+
+    // 带状态的分配器，id 不同的分配器互不相等，移动赋值时不传播
+    template <class T>
+    struct id_allocator {
+        using value_type = T;
+
+        int id = 0;
+
+        explicit id_allocator(int i = 0) noexcept : id(i) {}
+
+        template <class U>
+        id_allocator(const id_allocator<U>& other) noexcept : id(other.id) {}
+
+        T* allocate(size_t n) { return static_cast<T*>(::operator new(n * sizeof(T))); }
+
+        void deallocate(T* p, size_t) noexcept { ::operator delete(p); }
+
+        friend bool operator==(const id_allocator& x, const id_allocator& y) noexcept { return x.id == y.id; }
+    };
+
+    static void test_copy_move() {
+        mystl::small_vector<std::string, 2> a = {"a", "b"};
+        mystl::small_vector<std::string, 2> b = {"c", "d", "e"};
+
+        // 内联存储的拷贝与移动
+        mystl::small_vector<std::string, 2> c(a);
+        assert(c.size() == 2 && c.is_inline() && c[1] == "b");
+        mystl::small_vector<std::string, 2> d(std::move(c));
+        assert(d.size() == 2 && d.is_inline() && c.empty() && c.is_inline());
+
+        // 堆存储的移动直接转移指针
+        const std::string* p = b.data();
+        mystl::small_vector<std::string, 2> e(std::move(b));
+        assert(e.data() == p && e.size() == 3 && b.empty() && b.is_inline());
+
+        a = e;
+        assert(a.size() == 3 && a[2] == "e");
+        e = std::move(d);
+        assert(e.size() == 2 && e.is_inline() && e[0] == "a");
+
+        a.swap(e);
+        assert(a.size() == 2 && e.size() == 3 && a[1] == "b" && e[2] == "e");
+
+        // 分配器不传播且可能不相等时，移动赋值需要重新分配，不是 noexcept
+        using stateful = mystl::small_vector<int, 2, id_allocator<int>>;
+        static_assert(std::is_nothrow_move_constructible_v<mystl::small_vector<std::string, 2>>);
+        static_assert(std::is_nothrow_move_assignable_v<mystl::small_vector<std::string, 2>>);
+        static_assert(std::is_nothrow_move_constructible_v<stateful>);
+        static_assert(!std::is_nothrow_move_assignable_v<stateful>);
+        stateful f(id_allocator<int>(1));
+        for (int i = 1; i <= 3; ++i) { f.push_back(i); }
+        stateful g(id_allocator<int>(2));
+        const int* q = f.data();
+        g            = std::move(f);
+        assert(g.size() == 3 && g[2] == 3 && g.data() != q && g.get_allocator().id == 2);
+        stateful h(std::move(g));
+        assert(h.size() == 3 && h.get_allocator().id == 2 && g.empty());
+
+        std::cout << "Small vector copy/move test passed" << std::endl;
+    }
+
+private:
+    template <class T, size_t N>
+    static bool is_same(const std::vector<T>& sv, const mystl::small_vector<T, N>& v) {
+        if (sv.size() != v.size()) return false;
+        auto it1 = sv.begin();
+        auto it2 = v.begin();
+        while (it1 != sv.end() && it2 != v.end()) {
+            if (*it1 != *it2) return false;
+            ++it1;
+            ++it2;
+        }
+        return true;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_SMALL_VECTOR_H
@@ -0,0 +1,183 @@
+#ifndef _MYSTL_TEST_SOA_VECTOR_H
+#define _MYSTL_TEST_SOA_VECTOR_H
+
+#include "test.h"
+
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <soa_vector.h>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class soa_vector_test {
+public:
+    static void test_all() {
+        test_construct();
+        test_access();
+        test_modifier();
+        test_exception();
+    }
+
+    using record = mystl::soa_vector<int, double, std::string>;
+
+    static void test_construct() {
+        record v0;
+        assert(v0.empty() && v0.capacity() == 0);
+
+        record v1(3, {1, 2.0, "x"});
+        assert(v1.size() == 3 && v1[2] == std::make_tuple(1, 2.0, "x"));
+
+        record v2 = {{1, 1.5, "a"}, {2, 2.5, "b"}};
+        assert(v2.size() == 2 && std::get<2>(v2.back()) == "b");
+
+        record v3(v2);
+        assert(v3 == v2);
+        record v4(std::move(v3));
+        assert(v4 == v2 && v3.empty());
+        v3 = v4;
+        assert(v3 == v4);
+        v3 = std::move(v4);
+        assert(v3 == v2 && v4.empty());
+
+        record v5(4);
+        assert(v5.size() == 4 && v5[3] == std::make_tuple(0, 0.0, ""));
+
+        std::cout << "SoA vector construction test passed" << std::endl;
+    }
+
+    static void test_access() {
+        record v;
+        for (int i = 0; i < 1000; ++i) { v.emplace_back(i, i * 0.5, std::to_string(i)); }
+
+        // 结构化绑定得到的是各列中元素的引用
+        auto [id, score, name] = v[10];
+        score                  = 100.0;
+        assert(std::get<1>(v[10]) == 100.0 && id == 10 && name == "10");
+
+        // 每一列连续存放
+        auto ids = v.column<0>();
+        assert(ids.size() == 1000 && ids.data() == v.data<0>());
+        assert(std::accumulate(ids.begin(), ids.end(), 0L) == 999L * 1000 / 2);
+        for (double& s : v.column<1>()) { s = 1.0; }
+        assert(std::get<1>(v[10]) == 1.0);
+
+        // 代理引用的迭代
+        int count = 0;
+        for (auto [i, s, n] : v) {
+            assert(std::to_string(i) == n && s == 1.0);
+            ++count;
+        }
+        assert(count == 1000);
+        auto it = v.begin() + 500;
+        assert(it.get<0>() == 500 && v.end() - it == 500 && it[1] == std::make_tuple(501, 1.0, "501"));
+        const record& cv = v;
+        assert(std::get<2>(*(cv.begin() + 3)) == "3");
+
+        // 整体赋值
+        v[0] = std::make_tuple(-1, -1.0, "neg");
+        assert(std::get<2>(v.front()) == "neg");
+
+        bool thrown = false;
+        try {
+            v.at(1000);
+        } catch (const std::out_of_range&) { thrown = true; }
+        assert(thrown);
+
+        std::cout << "SoA vector access test passed" << std::endl;
+    }
+
+    static void test_modifier() {
+        record v;
+        for (int i = 0; i < 10; ++i) { v.push_back({i, double(i), std::to_string(i)}); }
+
+        v.insert(v.begin() + 3, {30, 30.0, "30"});
+        assert(v.size() == 11 && v[3] == std::make_tuple(30, 30.0, "30") && v[4] == std::make_tuple(3, 3.0, "3"));
+        v.insert(v.end(), {99, 99.0, "99"});
+        assert(std::get<0>(v.back()) == 99);
+
+        auto it = v.erase(v.begin() + 3);
+        assert(it == v.begin() + 3 && v.size() == 11 && v[3] == std::make_tuple(3, 3.0, "3"));
+        v.erase(v.begin(), v.begin() + 5);
+        assert(v.size() == 6 && v.front() == std::make_tuple(5, 5.0, "5"));
+        for (size_t i = 0; i < v.size(); ++i) { assert(std::to_string(std::get<0>(v[i])) == std::get<2>(v[i])); }
+
+        v.pop_back();
+        assert(v.size() == 5 && std::get<0>(v.back()) == 9);
+
+        // 参数引用容器自身的元素时扩容也是安全的
+        v.shrink_to_fit();
+        assert(v.capacity() == v.size());
+        v.emplace_back(std::get<0>(v[0]), std::get<1>(v[0]), std::get<2>(v[0]));
+        assert(v.back() == v.front());
+
+        v.resize(2);
+        assert(v.size() == 2);
+        v.resize(4, {7, 7.0, "7"});
+        assert(v.size() == 4 && v[3] == std::make_tuple(7, 7.0, "7"));
+
+        v.clear();
+        assert(v.empty());
+        v.shrink_to_fit();
+        assert(v.capacity() == 0);
+
+        std::cout << "SoA vector modifier test passed" << std::endl;
+    }
+
+    struct throwing {
+        int value;
+
+        throwing(int x) : value(x) {
+            if (x < 0) throw std::runtime_error("throwing");
+        }
+
+        // 拷贝值为 13 的对象时抛出异常
+        throwing(const throwing& other) : value(other.value) {
+            if (value == 13) throw std::runtime_error("throwing copy");
+        }
+
+        throwing(throwing&& other) noexcept : value(other.value) {}
+    };
+
+    static void test_exception() {
+        mystl::soa_vector<std::string, throwing> v;
+        for (int i = 0; i < 8; ++i) { v.emplace_back(std::to_string(i), i); }
+        assert(v.size() == v.capacity());
+
+        // 第二列构造失败时第一列不会留下多余的元素，原有元素不变
+        bool thrown = false;
+        try {
+            v.emplace_back("bad", -1);
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown && v.size() == 8 && v.capacity() == 8);
+        for (int i = 0; i < 8; ++i) { assert(std::get<0>(v[i]) == std::to_string(i) && std::get<1>(v[i]).value == i); }
+
+        thrown = false;
+        try {
+            v.resize(20, {"x", throwing(13)});
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown && v.size() == 8);
+
+        // 构造函数中途失败时释放已分配的列与已构造的元素，由 ASan 检查泄漏
+        thrown = false;
+        try {
+            mystl::soa_vector<std::string, throwing> w = {
+                {std::string(40, 'a'), throwing(1)}, {std::string(40, 'b'), throwing(2)}, {"c", throwing(13)}};
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown);
+        thrown = false;
+        try {
+            mystl::soa_vector<std::string, throwing> w(3, {std::string(40, 'x'), throwing(13)});
+        } catch (const std::runtime_error&) { thrown = true; }
+        assert(thrown);
+
+        std::cout << "SoA vector exception test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_SOA_VECTOR_H
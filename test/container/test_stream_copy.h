@@ -0,0 +1,73 @@
+#ifndef _MYSTL_TEST_STREAM_COPY_H
+#define _MYSTL_TEST_STREAM_COPY_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <stream_copy.h>
+#include <vector.h>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class stream_copy_test {
+public:
+    static void test_all() {
+        test_kernels();
+        test_vector_paths();
+    }
+
+    // 每种 CPU 支持的指令集，各种长度与对齐都与 memcpy 结果一致
+    static void test_kernels() {
+        std::vector<unsigned char> src(1 << 16), dst(src.size() + 128);
+        for (size_t i = 0; i < src.size(); ++i) { src[i] = static_cast<unsigned char>(i * 131 + 7); }
+
+        mystl::stream_copy_isa isas[] = {mystl::stream_copy_isa::none, mystl::stream_copy_isa::sse2, mystl::stream_copy_isa::avx2,
+                                         mystl::stream_copy_isa::avx512};
+        for (auto isa : isas) {
+            if (!mystl::set_stream_copy_isa(isa)) continue;
+            for (size_t n : {0, 1, 63, 255, 256, 1000, 4096, 65000}) {
+                for (size_t dst_off : {0, 1, 17, 64}) {
+                    for (size_t src_off : {0, 3, 32}) {
+                        if (src_off + n > src.size()) continue;
+                        std::memset(dst.data(), 0xAA, dst.size());
+                        mystl::stream_copy(dst.data() + dst_off, src.data() + src_off, n);
+                        assert(std::memcmp(dst.data() + dst_off, src.data() + src_off, n) == 0);
+                        // 不写入范围之外
+                        assert(dst_off == 0 || dst[dst_off - 1] == 0xAA);
+                        assert(dst[dst_off + n] == 0xAA);
+                    }
+                }
+            }
+        }
+        mystl::set_stream_copy_isa(mystl::stream_copy_supported_isa());
+
+        std::cout << "Stream copy kernel test passed" << std::endl;
+    }
+
+    // 降低阈值后 vector 的拷贝、扩容与插入都经过非临时写入
+    static void test_vector_paths() {
+        auto old = mystl::get_stream_copy_config();
+        mystl::set_stream_copy_config({1024, 256});
+
+        mystl::vector<int> v(100000);
+        std::iota(v.begin(), v.end(), 0);
+        mystl::vector<int> copy(v);
+        assert(std::equal(copy.begin(), copy.end(), v.begin(), v.end()));
+        v.reserve(v.capacity() * 2 + 1);
+        assert(std::equal(copy.begin(), copy.end(), v.begin(), v.end()));
+        v.insert(v.begin() + 7, copy.begin(), copy.end());
+        assert(v.size() == 200000 && v[7] == 0 && v[8] == 1 && v[100007] == 7);
+
+        mystl::set_stream_copy_config(old);
+        std::cout << "Stream copy vector test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_STREAM_COPY_H
@@ -4,9 +4,16 @@
 #include "test.h"
 
 #include <cassert>
+#include <atomic>
+#include <list>
+#include <parallel.h>
+#include <ranges>
 #include <string>
+#include <test_structs.h>
+#include <thread>
 #include <utility>  
 #include <vector.h> 
+#include <vector_shrink.h>
 #include <vector>
 
 _MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
@@ -17,8 +24,19 @@ public:
         test_construct();
         test_iterator();
         test_capacity();
+        test_trim();
+        test_try();
         test_element_access();
         test_modifier();
+        test_assign_reuse();
+        test_emplace_back();
+        test_unchecked();
+        test_erase();
+        test_parallel();
+#if _MYSTL_CXX_VERSION >= 20
+        test_range();
+        test_fixed_count();
+#endif
     }
 
     static void test_construct() {
@@ -101,6 +119,124 @@ public:
         std::cout << "Vector capacity test passed" << std::endl;
     }
 
+    static void test_trim() {
+        mystl::vector<std::string> v(100, "x");
+        v.reserve(1000);
+        assert(v.trim(2000) == 0 && v.capacity() == 1000);
+        assert(v.trim(500) == 500 * sizeof(std::string) && v.capacity() == 500);
+        // 不会低于 size()
+        assert(v.trim(0) == 400 * sizeof(std::string) && v.capacity() == 100 && v[99] == "x");
+
+        // 收缩目标：size() * 4 < capacity() 时逐级减半，不低于 min_bytes
+        mystl::vector_shrink_policy p;
+        assert(mystl::__shrink_target(300, 1024, 8, p) == 1024);
+        assert(mystl::__shrink_target(255, 1024, 8, p) == 512);
+        assert(mystl::__shrink_target(10, 1 << 20, 8, p) == 512);
+        assert(mystl::__shrink_target(0, 1 << 20, 1, p) == 4096);
+        assert(mystl::__shrink_target(0, 100, 8, p) == 100);
+
+        // 收缩后 size() 在 [capacity() / 4, capacity()) 内变化时既不收缩也不扩容，push/pop 交替不会反复分配
+        p.min_bytes = 0;
+        size_t cap  = mystl::__shrink_target(255, 1024, 8, p);
+        for (size_t size = cap / 4; size < cap; ++size) { assert(mystl::__shrink_target(size, cap, 8, p) == cap); }
+        assert(mystl::__shrink_target(cap / 4 - 1, cap, 8, p) == cap / 2);
+
+        std::cout << "Vector trim test passed" << std::endl;
+    }
+
+    // 总共只能分配 budget 个元素的分配器，超出时 try_allocate 返回空指针
+    template <class T>
+    struct budget_allocator {
+        using value_type = T;
+
+        static inline size_t budget = 0;
+
+        budget_allocator() = default;
+
+        template <class U>
+        budget_allocator(const budget_allocator<U>&) {}
+
+        T* allocate(size_t n) {
+            T* p = try_allocate(n);
+            if (p == nullptr) { throw std::bad_alloc(); }
+            return p;
+        }
+
+        T* try_allocate(size_t n) noexcept {
+            if (n > budget) return nullptr;
+            budget -= n;
+            return std::allocator<T>().allocate(n);
+        }
+
+        void deallocate(T* p, size_t n) noexcept {
+            budget += n;
+            std::allocator<T>().deallocate(p, n);
+        }
+
+        bool operator==(const budget_allocator&) const { return true; }
+    };
+
+    static void test_try() {
+        using status = mystl::vector_status;
+        static_assert(mystl::__has_try_allocate<budget_allocator<int>>::value);
+        static_assert(mystl::__has_try_allocate<mystl::allocator<int>>::value);
+        static_assert(!mystl::__has_try_allocate<std::allocator<int>>::value);
+
+        budget_allocator<std::string>::budget = 16;
+        {
+            mystl::vector<std::string, budget_allocator<std::string>> v;
+            assert(v.try_reserve(32) == status::out_of_memory && v.capacity() == 0);
+            assert(v.try_reserve(v.max_size() + 1) == status::length_error);
+            assert(v.try_reserve(4) == status::ok && v.capacity() == 4);
+            for (int i = 0; i < 8; ++i) { assert(v.try_push_back(std::to_string(i)) == status::ok); }
+            assert(v.size() == 8 && v.capacity() == 8 && v[7] == "7");
+
+            // 扩容到 16 需要同时持有新旧两块内存，超出预算，vector 不变
+            std::string s = "x";
+            assert(v.try_push_back(s) == status::out_of_memory);
+            assert(v.try_emplace_back("y") == status::out_of_memory);
+            assert(v.try_insert(v.begin(), s) == status::out_of_memory);
+            assert(v.try_resize(9, s) == status::out_of_memory);
+            assert(v.size() == 8 && v.capacity() == 8 && v[0] == "0" && v[7] == "7");
+
+            // 容量足够时不需要分配
+            assert(v.try_resize(4) == status::ok && v.size() == 4 && v.capacity() == 8);
+            assert(v.try_resize(6, "z") == status::ok && v[5] == "z" && v.capacity() == 8);
+            assert(v.try_insert(v.begin() + 1, std::string("w")) == status::ok && v[1] == "w" && v[2] == "1");
+        }
+        assert(budget_allocator<std::string>::budget == 16);
+
+        // 使用 std::allocator 时捕获 bad_alloc
+        mystl::vector<int, std::allocator<int>> w;
+        assert(w.try_reserve(w.max_size()) == status::out_of_memory && w.capacity() == 0);
+        assert(w.try_resize(w.max_size() + 1) == status::length_error);
+
+        // 扩容时插入的元素来自 vector 本身
+        mystl::vector<std::string> u = {"a", "b", "c", "d"};
+        u.shrink_to_fit();
+        assert(u.try_insert(u.begin(), u[3]) == status::ok);
+        assert(u.size() == 5 && u[0] == "d" && u[4] == "d");
+        assert(u.try_resize(20, u[1]) == status::ok && u[19] == "a" && u.size() == 20);
+
+        // 元素类型与 size_type 相同时，扩容路径只构造一个元素
+        mystl::vector<size_t> z;
+        assert(z.try_insert(z.begin(), size_t(7)) == status::ok && z.size() == 1 && z[0] == 7);
+        assert(z.try_insert(z.begin(), size_t(1000)) == status::ok && z.size() == 2 && z[0] == 1000 && z[1] == 7);
+        z.shrink_to_fit();
+        z.emplace(z.begin() + 1, size_t(500));
+        assert(z.size() == 3 && z[0] == 1000 && z[1] == 500 && z[2] == 7);
+
+        // resize 在容量足够时原地构造，不重新分配
+        mystl::vector<int> r;
+        r.reserve(100);
+        const int* data = r.data();
+        r.resize(50, 1);
+        r.resize(100);
+        assert(r.data() == data && r[49] == 1 && r[99] == 0);
+
+        std::cout << "Vector try test passed" << std::endl;
+    }
+
     static void test_element_access() {
         mystl::vector<int> v = {10, 20, 30, 40, 50};
         std::vector<int> sv  = {10, 20, 30, 40, 50};
@@ -211,9 +347,352 @@ public:
         sv3.resize(3);
         assert(is_same(sv3, v3));
 
+        // insert 前向迭代器，插入的元素超出 __end_
+        mystl::vector<int> v4 = {1, 2, 3};
+        std::vector<int> sv4  = {1, 2, 3};
+        v4.reserve(10);
+        std::list<int> l4 = {7, 8, 9, 10};
+        v4.insert(v4.begin() + 2, l4.begin(), l4.end());
+        sv4.insert(sv4.begin() + 2, l4.begin(), l4.end());
+        assert(is_same(sv4, v4));
+
+        // insert 前向迭代器触发扩容时不应移动源元素
+        mystl::vector<std::string> vs2 = {"a"};
+        std::vector<std::string> src2  = {"b", "c", "d"};
+        vs2.insert(vs2.begin(), src2.begin(), src2.end());
+        assert(src2[0] == "b" && vs2.size() == 4 && vs2[0] == "b" && vs2[3] == "a");
+
         std::cout << "Vector modifier test passed" << std::endl;
     }
 
+    // 快慢两条路径都返回新元素的引用，且不产生额外的拷贝或移动
+    // 容量足够时拷贝赋值与 assign 复用已有存储
+    template <class T>
+    static void check_assign_reuse(const T& a, const T& b) {
+        mystl::vector<T> src(100, a);
+        mystl::vector<T> dst(80, b);
+        dst.reserve(200);
+        const T* data = dst.data();
+
+        dst = src;
+        assert(dst.data() == data && dst.size() == 100 && dst[99] == a);
+        mystl::vector<T> small(30, b);
+        dst = small;
+        assert(dst.data() == data && dst.size() == 30 && dst[29] == b);
+
+        std::list<T> l(150, a);
+        dst.assign(l.begin(), l.end());
+        assert(dst.data() == data && dst.size() == 150 && dst[149] == a);
+        dst.assign(src.begin() + 10, src.begin() + 50);
+        assert(dst.data() == data && dst.size() == 40 && dst[39] == a);
+
+        dst.assign(120, b);
+        assert(dst.data() == data && dst.size() == 120 && dst[0] == b && dst[119] == b);
+        dst.assign(5, dst[100]);
+        assert(dst.data() == data && dst.size() == 5 && dst[4] == b);
+
+        std::vector<T> ref(70, a);
+        dst.assign(ref.begin(), ref.end());
+        assert(dst.data() == data && is_same(ref, dst));
+
+        // 容量不足时重新分配
+        mystl::vector<T> big(300, a);
+        dst = big;
+        assert(dst.size() == 300 && dst.capacity() >= 300 && dst[299] == a);
+    }
+
+    static void test_assign_reuse() {
+        check_assign_reuse<int>(1, 2);
+        check_assign_reuse<std::string>(std::string(40, 'a'), "b");
+        check_assign_reuse<char>('x', 'y');
+
+        std::cout << "Vector assign reuse test passed" << std::endl;
+    }
+
+    static void test_emplace_back() {
+        mystl::vector<NonTrivialData> v;
+        v.reserve(2);
+        NonTrivialData x;
+        NonTrivialData::copies = NonTrivialData::moves = 0;
+
+        NonTrivialData& a = v.emplace_back(x);
+        assert(&a == &v[0] && NonTrivialData::copies == 1 && NonTrivialData::moves == 0);
+        NonTrivialData& b = v.emplace_back(std::move(x));
+        assert(&b == &v[1] && NonTrivialData::copies == 1 && NonTrivialData::moves == 1);
+
+        // 扩容：除了迁移原有的 2 个元素外没有其他移动
+        NonTrivialData& c = v.emplace_back();
+        assert(&c == &v[2] && NonTrivialData::copies == 1 && NonTrivialData::moves == 3);
+
+        mystl::vector<std::string> s;
+        std::string& r = s.emplace_back(3, 'x');
+        assert(r == "xxx" && &r == &s.back());
+
+        std::cout << "Vector emplace_back test passed" << std::endl;
+    }
+
+    static void test_unchecked() {
+        mystl::vector<int> v;
+        v.reserve(16);
+        for (int i = 0; i < 8; ++i) { v.push_back_unchecked(i); }
+        assert(v.emplace_back_unchecked(8) == 8);
+        assert(v.size() == 9 && v.capacity() == 16);
+
+        {
+            mystl::vector<int>::back_insert_cursor cursor(v);
+            assert(cursor.remaining() == 7);
+            for (int i = 9; i < 16; ++i) { cursor.push_back(i); }
+            assert(cursor.remaining() == 0);
+        }
+        assert(v.size() == 16 && v.capacity() == 16);
+        for (int i = 0; i < 16; ++i) { assert(v[i] == i); }
+
+        // 非平凡类型，提前 commit
+        mystl::vector<std::string> vs;
+        vs.reserve(4);
+        mystl::vector<std::string>::back_insert_cursor cursor(vs);
+        cursor.emplace_back(3, 'a');
+        cursor.push_back("b");
+        cursor.commit();
+        assert(vs.size() == 2 && vs[0] == "aaa" && vs[1] == "b");
+
+        std::cout << "Vector unchecked push test passed" << std::endl;
+    }
+
+    static void test_erase() {
+        mystl::vector<int> v = {0, 1, 2, 3, 4, 5};
+        auto it              = v.erase_unordered(v.begin() + 1);
+        assert(*it == 5 && v.size() == 5 && v[1] == 5);
+        it = v.erase_unordered(v.end() - 1);
+        assert(it == v.end() && v.size() == 4);
+
+        // 平凡类型，无分支压缩
+        mystl::vector<int> vi;
+        std::vector<int> svi;
+        for (int i = 0; i < 1000; ++i) {
+            vi.push_back(i % 7);
+            svi.push_back(i % 7);
+        }
+        assert(mystl::erase_if(vi, [](int x) { return x % 2 == 0; }) == std::erase_if(svi, [](int x) { return x % 2 == 0; }));
+        assert(is_same(svi, vi));
+        assert(mystl::erase(vi, 3) == std::erase(svi, 3));
+        assert(is_same(svi, vi));
+
+        // 非平凡类型
+        mystl::vector<std::string> vs = {"a", "bb", "c", "dd", "e"};
+        std::vector<std::string> svs  = {"a", "bb", "c", "dd", "e"};
+        auto pred                     = [](const std::string& s) { return s.size() == 2; };
+        assert(mystl::erase_if(vs, pred) == 2);
+        std::erase_if(svs, pred);
+        assert(is_same(svs, vs));
+
+        mystl::vector<bool> vb = {true, false, true, true};
+        assert(mystl::erase(vb, true) == 3 && vb.size() == 1 && !vb[0]);
+
+        std::cout << "Vector erase test passed" << std::endl;
+    }
+
+    // 构造次数达到 limit 时抛出异常，用于检查并行构造失败时的回滚
+    struct counted {
+        static inline std::atomic<int> live{0};
+        static inline std::atomic<int> constructed{0};
+        static inline int limit = -1;
+
+        int value;
+
+        counted() : counted(0) {}
+
+        counted(int v) : value(v) {
+            if (constructed.fetch_add(1) == limit) { throw std::runtime_error("counted"); }
+            ++live;
+        }
+
+        counted(const counted& other) : counted(other.value) {}
+
+        ~counted() { --live; }
+    };
+
+    static void test_parallel() {
+        // 阈值为 1 字节，强制分块
+        mystl::parallel_policy pol{1, 4};
+        const size_t n = 100000;
+
+        mystl::vector<int> v(pol, n, 7);
+        assert(v.size() == n && std::count(v.begin(), v.end(), 7) == static_cast<long>(n));
+        for (size_t i = 0; i < n; ++i) { v[i] = static_cast<int>(i); }
+        mystl::vector<int> w(pol, v);
+        assert(w.size() == n && std::equal(v.begin(), v.end(), w.begin()));
+        w.assign(pol, n / 2, 3);
+        assert(w.size() == n / 2 && w.front() == 3 && w.back() == 3);
+
+        mystl::vector<std::string> vs(pol, 5000, std::string("parallel"));
+        assert(vs.size() == 5000 && vs[4999] == "parallel");
+
+        // 同一下标在多次调用中由同一个线程执行
+        {
+            mystl::__thread_pool& pool = mystl::__thread_pool::__instance();
+            unsigned k                 = pool.__workers() + 1;
+            std::vector<std::thread::id> first(k), second(k);
+            auto record_first  = [&](unsigned i) { first[i] = std::this_thread::get_id(); };
+            auto record_second = [&](unsigned i) { second[i] = std::this_thread::get_id(); };
+            pool.__run(k, record_first);
+            for (int round = 0; round < 10; ++round) {
+                pool.__run(k, record_second);
+                assert(first == second);
+            }
+        }
+
+        // 默认的阈值较大，小的 vector 仍然串行构造
+        mystl::vector<int> small(mystl::par, 10);
+        assert(small.size() == 10 && small[9] == 0);
+
+        // 某一块构造失败时，所有已构造的元素都被析构
+        {
+            mystl::vector<counted> src(pol, 20000, counted(1));
+            counted::constructed = 0;
+            counted::limit       = 15000;
+            bool thrown          = false;
+            try {
+                mystl::vector<counted> dst(pol, src);
+            } catch (const std::runtime_error&) { thrown = true; }
+            assert(thrown && counted::live == 20000);
+            counted::limit = -1;
+        }
+        assert(counted::live == 0);
+
+        std::cout << "Vector parallel construction test passed" << std::endl;
+    }
+
+#if _MYSTL_CXX_VERSION >= 20
+    static void test_range() {
+        mystl::vector<int> v = {1, 2, 3};
+        std::vector<int> sv  = {1, 2, 3};
+
+        // append_range: 连续存储的范围
+        std::vector<int> src = {4, 5, 6, 7, 8};
+        v.append_range(src);
+        sv.insert(sv.end(), src.begin(), src.end());
+        assert(is_same(sv, v));
+
+        // append_range: 已知长度只扩容一次
+        mystl::vector<int> v1;
+        v1.append_range(std::views::iota(0, 100));
+        assert(v1.size() == 100 && v1.capacity() == 100 && v1[99] == 99);
+
+        // append_range: 非 common_range
+        auto nc = std::views::iota(0) | std::views::take_while([](int x) { return x < 5; });
+        v1.append_range(nc);
+        assert(v1.size() == 105 && v1.back() == 4);
+
+        // insert_range: 有空余容量与需要扩容两种情况
+        v.reserve(v.size() + 2);
+        v.insert_range(v.begin() + 1, std::list<int>{10, 11});
+        sv.insert(sv.begin() + 1, {10, 11});
+        assert(is_same(sv, v));
+        auto it = v.insert_range(v.begin() + 4, std::views::iota(20, 30));
+        sv.insert(sv.begin() + 4, {20, 21, 22, 23, 24, 25, 26, 27, 28, 29});
+        assert(is_same(sv, v) && *it == 20);
+
+        // insert_range: 长度未知的范围
+        v.insert_range(v.begin(), nc);
+        sv.insert(sv.begin(), {0, 1, 2, 3, 4});
+        assert(is_same(sv, v));
+
+        // assign_range
+        v.assign_range(std::views::iota(0, 3));
+        sv.assign({0, 1, 2});
+        assert(is_same(sv, v));
+        v.assign_range(nc);
+        sv.assign({0, 1, 2, 3, 4});
+        assert(is_same(sv, v));
+
+        // 非平凡类型
+        mystl::vector<std::string> vs = {"a"};
+        std::vector<std::string> svs  = {"b", "c"};
+        vs.append_range(svs);
+        vs.insert_range(vs.begin(), svs);
+        assert(vs.size() == 5 && vs[0] == "b" && vs[2] == "a" && vs[4] == "c" && svs[0] == "b");
+
+        std::cout << "Vector range test passed" << std::endl;
+    }
+
+    static constexpr int fixed_count_sum() {
+        mystl::vector<int, std::allocator<int>> v;
+        int a[4] = {1, 2, 3, 4};
+        v.append<4>(a);
+        v.append<4>(a);
+        v.insert<4>(v.begin() + 2, a);
+        v.assign<2>(a + 2);
+        v.append<4>(a);
+        int sum = 0;
+        for (int x : v) { sum += x; }
+        return sum;
+    }
+
+    static void test_fixed_count() {
+        static_assert(fixed_count_sum() == 17);
+
+        int a[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+        mystl::vector<int> v;
+        std::vector<int> sv;
+        v.append<4>(a);
+        sv.insert(sv.end(), a, a + 4);
+        v.append<8>(a);
+        sv.insert(sv.end(), a, a + 8);
+        assert(is_same(sv, v));
+
+        // 空余容量足够与需要扩容两种情况
+        v.reserve(v.size() + 4);
+        auto it = v.insert<4>(v.begin() + 3, a + 4);
+        sv.insert(sv.begin() + 3, a + 4, a + 8);
+        assert(is_same(sv, v) && *it == 4);
+        it = v.insert<8>(v.end() - 1, a);
+        sv.insert(sv.end() - 1, a, a + 8);
+        assert(is_same(sv, v) && it == v.end() - 9);
+
+        v.assign<2>(a + 6);
+        assert(v.size() == 2 && v[0] == 6 && v[1] == 7);
+        mystl::vector<int> small;
+        small.assign<8>(a);
+        assert(small.size() == 8 && small.back() == 7);
+
+        // 非平凡类型与非连续的输入
+        std::list<std::string> ls = {"a", "b", "c"};
+        mystl::vector<std::string> vs;
+        vs.append<3>(ls.begin());
+        vs.insert<3>(vs.begin() + 1, ls.begin());
+        assert(vs.size() == 6 && vs[0] == "a" && vs[1] == "a" && vs[3] == "c" && vs[4] == "b");
+        vs.assign<2>(ls.begin());
+        assert(vs.size() == 2 && vs[1] == "b");
+
+        // 扩容时迁移旧元素抛出异常：新构造的元素被析构，原 vector 不变
+        {
+            // std::string 成员持有堆内存，错误的析构或泄漏能被 ASan 发现
+            struct payload {
+                counted c;
+                std::string s;
+            };
+            const std::string text = "a string that does not fit in SSO";
+            payload src[2]         = {{counted(8), text}, {counted(9), text}};
+            mystl::vector<payload> vp(3, payload{counted(1), text});
+            vp.shrink_to_fit();
+            counted::constructed = 0;
+            counted::limit       = 3;
+            bool thrown          = false;
+            try {
+                vp.append<2>(src);
+            } catch (const std::runtime_error&) { thrown = true; }
+            assert(thrown && counted::live == 5 && vp.size() == 3 && vp[2].c.value == 1 && vp[2].s == text);
+            counted::limit = -1;
+            vp.append<2>(src);
+            assert(vp.size() == 5 && vp[3].c.value == 8 && vp[4].c.value == 9 && vp[4].s == text && counted::live == 7);
+        }
+        assert(counted::live == 0);
+
+        std::cout << "Vector fixed count test passed" << std::endl;
+    }
+#endif
+
 
 private:
     template <class T>
@@ -0,0 +1,170 @@
+#ifndef _MYSTL_TEST_VECTOR_BOOL_H
+#define _MYSTL_TEST_VECTOR_BOOL_H
+
+#include "test.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector.h>
+#include <vector>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class vector_bool_test {
+public:
+    static void test_all() {
+        test_construct();
+        test_modifier();
+        test_bit_ops();
+    }
+
+    static void test_construct() {
+        mystl::vector<bool> v0;
+        assert(v0.empty());
+
+        mystl::vector<bool> v1(100, true);
+        assert(v1.size() == 100 && v1.count() == 100 && v1.all());
+        // 按位存储
+        assert(v1.capacity() >= 100 && v1.capacity() % 64 == 0);
+
+        mystl::vector<bool> v2 = {true, false, true, true};
+        std::vector<bool> sv2  = {true, false, true, true};
+        assert(is_same(sv2, v2));
+
+        mystl::vector<bool> v3(v2);
+        assert(v3 == v2);
+        mystl::vector<bool> v4(std::move(v3));
+        assert(v4 == v2 && v3.empty());
+
+        v4 = v1;
+        assert(v4 == v1);
+
+        // max_size() 不超过 difference_type 能表示的范围，超出时 reserve 抛出 length_error
+        assert(v0.max_size() <= size_t(PTRDIFF_MAX));
+        bool thrown = false;
+        try {
+            v0.reserve(size_t(PTRDIFF_MAX) + 1);
+        } catch (const std::length_error&) { thrown = true; }
+        assert(thrown && v0.capacity() == 0);
+
+        std::cout << "Vector<bool> construction test passed" << std::endl;
+    }
+
+    static void test_modifier() {
+        std::mt19937 gen(42);
+        mystl::vector<bool> v;
+        std::vector<bool> sv;
+        for (int i = 0; i < 300; ++i) {
+            bool b = gen() & 1;
+            v.push_back(b);
+            sv.push_back(b);
+        }
+        assert(is_same(sv, v));
+
+        // 代理引用
+        v[3]  = !v[3];
+        sv[3] = !sv[3];
+        v[70].flip();
+        sv[70].flip();
+        mystl::swap(v[0], v[299]);
+        std::vector<bool>::swap(sv[0], sv[299]);
+        assert(is_same(sv, v));
+
+        // 跨字的插入与删除
+        v.insert(v.begin() + 5, 130, true);
+        sv.insert(sv.begin() + 5, 130, true);
+        assert(is_same(sv, v));
+        v.insert(v.begin() + 63, {false, true, false});
+        sv.insert(sv.begin() + 63, {false, true, false});
+        assert(is_same(sv, v));
+        v.erase(v.begin() + 10, v.begin() + 100);
+        sv.erase(sv.begin() + 10, sv.begin() + 100);
+        assert(is_same(sv, v));
+        v.erase(v.begin());
+        sv.erase(sv.begin());
+        assert(is_same(sv, v));
+
+        v.resize(500, true);
+        sv.resize(500, true);
+        assert(is_same(sv, v));
+        v.resize(65);
+        sv.resize(65);
+        assert(is_same(sv, v));
+
+        // clear 之后重新增长不应看到旧数据
+        v.clear();
+        for (int i = 0; i < 130; ++i) { v.push_back(false); }
+        assert(v.none() && v.count() == 0);
+
+        // 反向迭代器
+        v.back() = true;
+        mystl::vector<bool> rv(v.rbegin(), v.rend());
+        assert(rv.size() == 130 && rv.count() == 1 && rv.find_first() == 0);
+
+        std::cout << "Vector<bool> modifier test passed" << std::endl;
+    }
+
+    static void test_bit_ops() {
+        const size_t n = 1000;
+        mystl::vector<bool> a(n), b(n);
+        std::vector<bool> sa(n), sb(n);
+        std::mt19937 gen(7);
+        for (size_t i = 0; i < n; ++i) {
+            bool x = gen() % 3 == 0, y = gen() % 2 == 0;
+            a[i] = sa[i] = x;
+            b[i] = sb[i] = y;
+        }
+        assert(a.count() == static_cast<size_t>(std::count(sa.begin(), sa.end(), true)));
+
+        // find_first / find_next 遍历所有为 1 的位
+        std::vector<size_t> ones;
+        for (size_t i = a.find_first(); i != a.npos; i = a.find_next(i)) { ones.push_back(i); }
+        std::vector<size_t> sones;
+        for (size_t i = 0; i < n; ++i) {
+            if (sa[i]) sones.push_back(i);
+        }
+        assert(ones == sones);
+
+        mystl::vector<bool> c = a & b;
+        mystl::vector<bool> d = a | b;
+        mystl::vector<bool> e = a;
+        e ^= b;
+        mystl::vector<bool> f = a;
+        f.and_not(b);
+        for (size_t i = 0; i < n; ++i) {
+            assert(c[i] == (sa[i] && sb[i]));
+            assert(d[i] == (sa[i] || sb[i]));
+            assert(e[i] == (sa[i] != sb[i]));
+            assert(f[i] == (sa[i] && !sb[i]));
+        }
+
+        // 整体翻转后超出 size() 的位不能被计入
+        a.flip();
+        assert(a.count() == n - sones.size());
+        a.set();
+        assert(a.all() && a.count() == n);
+        a.reset();
+        assert(a.none() && a.find_first() == a.npos);
+        a.set(999);
+        assert(a.find_first() == 999 && a.find_next(999) == a.npos);
+
+        std::cout << "Vector<bool> bit operation test passed" << std::endl;
+    }
+
+private:
+    static bool is_same(const std::vector<bool>& sv, const mystl::vector<bool>& v) {
+        if (sv.size() != v.size()) return false;
+        for (size_t i = 0; i < sv.size(); ++i) {
+            if (sv[i] != v[i]) return false;
+        }
+        return std::equal(sv.begin(), sv.end(), v.begin());
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_VECTOR_BOOL_H
@@ -0,0 +1,90 @@
+#ifndef _MYSTL_TEST_VECTOR_IO_H
+#define _MYSTL_TEST_VECTOR_IO_H
+
+#include "test.h"
+
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector_io.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+class vector_io_test {
+public:
+    static void test_all() {
+        test_spare();
+        test_read();
+        test_readv();
+    }
+
+    static void test_spare() {
+        mystl::vector<char> v = {'a', 'b'};
+        v.reserve_spare(10);
+        assert(v.capacity() - v.size() >= 10);
+        auto spare = v.spare_capacity();
+        std::memcpy(spare.data(), "cdef", 4);
+        v.commit_spare(4);
+        assert(v.size() == 6 && std::string(v.begin(), v.end()) == "abcdef");
+
+        // 按照 __recommend 翻倍增长，而不是恰好扩容到需要的大小
+        mystl::vector<char> w(100, 'x');
+        w.shrink_to_fit();
+        w.reserve_spare(1);
+        assert(w.capacity() == 200);
+
+        std::cout << "Vector spare capacity test passed" << std::endl;
+    }
+
+    static void test_read() {
+        int fds[2];
+        assert(::pipe(fds) == 0);
+        const char msg[] = "hello, world";
+        assert(::write(fds[1], msg, sizeof(msg) - 1) == static_cast<ssize_t>(sizeof(msg) - 1));
+        ::close(fds[1]);
+
+        mystl::vector<char> v = {'>'};
+        ssize_t r             = mystl::read_append(fds[0], v, 5);
+        assert(r == 5 && std::string(v.begin(), v.end()) == ">hello");
+        while ((r = mystl::read_append(fds[0], v, 4)) > 0) {}
+        assert(r == 0 && std::string(v.begin(), v.end()) == ">hello, world");
+        ::close(fds[0]);
+
+        // 失败时不修改 vector
+        assert(mystl::read_append(-1, v, 16) == -1 && errno == EBADF && v.size() == 13);
+
+        std::string path = (std::filesystem::temp_directory_path() / "mystl_vector_io_test.bin").string();
+        int fd           = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        assert(fd >= 0 && ::write(fd, "0123456789", 10) == 10);
+        mystl::vector<unsigned char> u;
+        assert(mystl::pread_append(fd, u, 3, 4) == 3 && u.size() == 3 && u[0] == '4' && u[2] == '6');
+        ::close(fd);
+        std::filesystem::remove(path);
+
+        std::cout << "Vector read test passed" << std::endl;
+    }
+
+    static void test_readv() {
+        int fds[2];
+        assert(::pipe(fds) == 0);
+        assert(::write(fds[1], "HEADbody-bytes", 14) == 14);
+        ::close(fds[1]);
+
+        mystl::vector<char> head, body;
+        // 报文头与报文体的长度不同
+        ssize_t r = mystl::readv_append(fds[0], {4, 16}, head, body);
+        assert(r == 14);
+        assert(std::string(head.begin(), head.end()) == "HEAD" && std::string(body.begin(), body.end()) == "body-bytes");
+        ::close(fds[0]);
+
+        std::cout << "Vector readv test passed" << std::endl;
+    }
+};
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_VECTOR_IO_H
@@ -0,0 +1,68 @@
+#ifndef _MYSTL_TEST_VECTOR_TELEMETRY_H
+#define _MYSTL_TEST_VECTOR_TELEMETRY_H
+
+#include "test.h"
+
+#include <cassert>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector_telemetry.h>
+
+_MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
+
+// vector 本身的上报需要以 _MYSTL_VECTOR_TELEMETRY=1 编译，见 vector_telemetry_report.cpp
+class vector_telemetry_test {
+public:
+    static void test_all() { test_registry(); }
+
+    static size_t sink_calls;
+
+    static void test_registry() {
+        auto& registry = mystl::reallocation_registry::instance();
+        registry.reset();
+        registry.set_sink([](const mystl::reallocation_event&) { ++sink_calls; });
+
+        assert(mystl::__telemetry_type_name<int>() == "int");
+        assert(mystl::__current_reallocation_site == nullptr);
+
+        unsigned hot_line = 0;
+        {
+            _MYSTL_REALLOCATION_SITE();
+            hot_line = __LINE__ - 1;
+            for (size_t cap = 1; cap <= 64; cap *= 2) { mystl::__report_reallocation<double>(cap, cap * 2, cap); }
+            {
+                // 内层作用域覆盖外层的调用点
+                _MYSTL_REALLOCATION_SITE();
+                mystl::__report_reallocation<double>(1, 2, 1);
+            }
+            mystl::__report_reallocation<double>(128, 256, 128);
+        }
+        assert(mystl::__current_reallocation_site == nullptr);
+        mystl::__report_reallocation<char>(8, 16, 0);
+
+        auto top = registry.top_sites(10);
+        assert(top.size() == 3 && sink_calls == 10);
+        assert(top[0].count == 8 && top[0].site.line == hot_line && top[0].element_type == "double");
+        assert(top[0].bytes_moved == (1 + 2 + 4 + 8 + 16 + 32 + 64 + 128) * sizeof(double) && top[0].max_capacity == 256);
+        assert(registry.top_sites(1).size() == 1);
+
+        std::ostringstream os;
+        registry.report(os, 2);
+        std::string text = os.str();
+        assert(text.find("8 reallocations") != std::string::npos && text.find("vector<double>") != std::string::npos);
+        assert(text.find("vector<char>") == std::string::npos);
+
+        registry.set_sink(nullptr);
+        registry.reset();
+        assert(registry.top_sites(10).empty());
+
+        std::cout << "Vector telemetry registry test passed" << std::endl;
+    }
+};
+
+inline size_t vector_telemetry_test::sink_calls = 0;
+
+_MYSTL_END_NAMESPACE_MYSTL_TEST
+
+#endif // _MYSTL_TEST_VECTOR_TELEMETRY_H
@@ -0,0 +1,62 @@
+#include "timer.h"
+#include "vector.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+// 双缓冲：每帧将 front 拷贝赋值给 back，修改 back 后交换两者
+// 统计预热之后的分配次数，容量足够时拷贝赋值复用已有存储，稳态下应当为 0
+
+static size_t g_allocations = 0;
+
+void* operator new(size_t n) {
+    ++g_allocations;
+    if (void* p = std::malloc(n)) { return p; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+constexpr size_t NUM_ELEMS  = 1 << 16;
+constexpr size_t NUM_FRAMES = 2000;
+constexpr size_t WARMUP     = 2;
+
+template <class Vec, class T>
+void bench(const char* name, const T& init, const T& alt) {
+    Vec front(NUM_ELEMS, init);
+    Vec back;
+    mystl_test::Timer timer;
+    for (size_t f = 0; f < NUM_FRAMES; ++f) {
+        if (f == WARMUP) {
+            g_allocations = 0;
+            timer.start();
+        }
+        back                      = front;
+        back[f % NUM_ELEMS]       = alt;
+        back[(f * 7) % NUM_ELEMS] = init;
+        front.swap(back);
+    }
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms, " << g_allocations << " allocations in " << NUM_FRAMES - WARMUP
+              << " steady-state frames" << std::endl;
+}
+
+template <class T>
+void bench_both(const char* type, const T& init, const T& alt) {
+    std::cout << type << " x " << NUM_ELEMS << std::endl;
+    bench<mystl::vector<T>>("mystl::vector", init, alt);
+    bench<std::vector<T>>("std::vector", init, alt);
+}
+
+int main() {
+    bench_both<int>("int", 1, 2);
+    bench_both<double>("double", 1.0, 2.0);
+    // 短字符串不分配堆内存，拷贝赋值逐个调用 string::operator=
+    bench_both<std::string>("std::string (SSO)", std::string("abc"), std::string("xyz"));
+    return 0;
+}
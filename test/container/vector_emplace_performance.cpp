@@ -0,0 +1,60 @@
+#include "test_structs.h"
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+#include <vector>
+
+// 统计 push_back/emplace_back 每个元素的拷贝与移动次数，比较 mystl::vector 与 std::vector
+// 预先 reserve，不计扩容时的迁移，理想值为 push_back(const&) 1 次拷贝、push_back(&&) 1 次移动、emplace_back() 0 次
+
+using mystl_test::NonTrivialData;
+
+constexpr size_t NUM_ELEMS = 2000000;
+
+template <class F>
+void run(const char* name, F f) {
+    NonTrivialData::copies = NonTrivialData::moves = 0;
+    mystl_test::Timer timer;
+    f();
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms, " << double(NonTrivialData::copies) / NUM_ELEMS << " copies, "
+              << double(NonTrivialData::moves) / NUM_ELEMS << " moves per element" << std::endl;
+}
+
+template <class Vec>
+void bench(const char* name) {
+    std::cout << name << std::endl;
+    NonTrivialData x;
+    run("push_back(const&)", [&] {
+        Vec v;
+        v.reserve(NUM_ELEMS);
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.push_back(x); }
+    });
+    run("push_back(&&)", [&] {
+        Vec v;
+        v.reserve(NUM_ELEMS);
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.push_back(NonTrivialData()); }
+    });
+    run("emplace_back(const&)", [&] {
+        Vec v;
+        v.reserve(NUM_ELEMS);
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.emplace_back(x); }
+    });
+    run("emplace_back()", [&] {
+        Vec v;
+        v.reserve(NUM_ELEMS);
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.emplace_back(); }
+    });
+    // 不 reserve，迁移本身的移动约为每个元素 1 次
+    run("emplace_back() with growth", [&] {
+        Vec v;
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.emplace_back(); }
+    });
+}
+
+int main() {
+    bench<mystl::vector<NonTrivialData>>("mystl::vector");
+    bench<std::vector<NonTrivialData>>("std::vector");
+    return 0;
+}
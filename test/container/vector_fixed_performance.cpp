@@ -0,0 +1,82 @@
+#include "timer.h"
+#include "vector.h"
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+
+// 追加定长的小批量 POD，比较编译期长度的 append<N> 与运行期长度的 insert/append_range
+// vector 每写满 BUFFER_ELEMS 个元素清空一次，数据留在缓存中，测量的是追加本身的开销
+
+constexpr size_t NUM_BATCHES  = 20000000;
+constexpr size_t NUM_ROUNDS   = 5;
+constexpr size_t BUFFER_ELEMS = 4096;
+
+struct Field {
+    uint32_t tag;
+    uint32_t len;
+    uint64_t value;
+};
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t result = 0;
+    for (size_t round = 0; round < NUM_ROUNDS; ++round) { result += f(); }
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << result << ")" << std::endl;
+}
+
+template <size_t N>
+void bench() {
+    std::cout << N << " x " << sizeof(Field) << " bytes per batch" << std::endl;
+    Field src[64];
+    for (size_t i = 0; i < 64; ++i) { src[i] = Field{uint32_t(i), 8, i * 3}; }
+
+    mystl::vector<Field> v;
+    v.reserve(BUFFER_ELEMS);
+    run("insert(end, first, last)", [&] {
+        size_t total = 0;
+        v.clear();
+        for (size_t i = 0; i < NUM_BATCHES / N; ++i) {
+            if (v.size() == BUFFER_ELEMS) {
+                total += v.back().value;
+                v.clear();
+            }
+            const Field* p = src + (i & 31);
+            v.insert(v.end(), p, p + N);
+        }
+        return total;
+    });
+    run("append_range(span)", [&] {
+        size_t total = 0;
+        v.clear();
+        for (size_t i = 0; i < NUM_BATCHES / N; ++i) {
+            if (v.size() == BUFFER_ELEMS) {
+                total += v.back().value;
+                v.clear();
+            }
+            v.append_range(std::span<const Field>(src + (i & 31), N));
+        }
+        return total;
+    });
+    run("append<N>", [&] {
+        size_t total = 0;
+        v.clear();
+        for (size_t i = 0; i < NUM_BATCHES / N; ++i) {
+            if (v.size() == BUFFER_ELEMS) {
+                total += v.back().value;
+                v.clear();
+            }
+            v.template append<N>(src + (i & 31));
+        }
+        return total;
+    });
+}
+
+int main() {
+    bench<4>();
+    bench<8>();
+    bench<16>();
+    return 0;
+}
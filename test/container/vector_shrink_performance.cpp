@@ -0,0 +1,46 @@
+// 以 _MYSTL_VECTOR_SHRINK_POLICY=1 编译，见 CMakeLists.txt
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+
+// 1. 缓存中的 vector 突增后回落，比较回落后的容量
+// 2. 在收缩边界附近交替 push_back/pop_back，统计容量变化的次数
+
+constexpr size_t SPIKE_SIZE  = 10000000;
+constexpr size_t STEADY_SIZE = 1000;
+constexpr size_t NUM_ROUNDS  = 10000000;
+
+int main() {
+    mystl::vector<long> v;
+    mystl_test::Timer timer;
+    for (size_t i = 0; i < SPIKE_SIZE; ++i) { v.push_back(long(i)); }
+    size_t peak = v.capacity() * sizeof(long);
+    while (v.size() > STEADY_SIZE) { v.pop_back(); }
+    timer.stop();
+    std::cout << "spike to " << SPIKE_SIZE << " then pop_back to " << STEADY_SIZE << ": " << timer.elapsedMilliseconds() << "ms" << std::endl;
+    std::cout << "  capacity " << peak << " bytes -> " << v.capacity() * sizeof(long) << " bytes" << std::endl;
+
+    // 停在刚刚收缩之后的位置，每轮 push_back 一次再 pop_back 一次
+    size_t changes = 0;
+    size_t cap     = v.capacity();
+    timer.start();
+    for (size_t i = 0; i < NUM_ROUNDS; ++i) {
+        if (i % 2 == 0) {
+            v.push_back(long(i));
+        } else {
+            v.pop_back();
+        }
+        if (v.capacity() != cap) {
+            ++changes;
+            cap = v.capacity();
+        }
+    }
+    timer.stop();
+    std::cout << "alternating push_back/pop_back x " << NUM_ROUNDS << ": " << timer.elapsedMilliseconds() << "ms, " << changes
+              << " capacity changes" << std::endl;
+
+    size_t released = v.trim(0);
+    std::cout << "trim(0) released " << released << " bytes" << std::endl;
+    return 0;
+}
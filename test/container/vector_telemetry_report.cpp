@@ -0,0 +1,55 @@
+// 以 _MYSTL_VECTOR_TELEMETRY=1 编译，统计 vector 的扩容并列出扩容最多的调用点
+// 在自己的程序中使用时，以同样的宏编译，在关心的函数中加入 _MYSTL_REALLOCATION_SITE()，
+// 退出前调用 mystl::reallocation_registry::instance().report(std::cerr)
+
+#include "vector.h"
+
+#include <cassert>
+#include <iostream>
+#include <string>
+
+static_assert(_MYSTL_VECTOR_TELEMETRY, "vector_telemetry_report must be built with -D_MYSTL_VECTOR_TELEMETRY=1");
+
+// 没有预先 reserve，每次调用扩容约 log2(n) 次
+mystl::vector<int> collect_ids(size_t n) {
+    _MYSTL_REALLOCATION_SITE();
+    mystl::vector<int> ids;
+    for (size_t i = 0; i < n; ++i) { ids.push_back(int(i)); }
+    return ids;
+}
+
+// 预先 reserve，每次调用只分配一次
+mystl::vector<int> collect_ids_reserved(size_t n) {
+    _MYSTL_REALLOCATION_SITE();
+    mystl::vector<int> ids;
+    ids.reserve(n);
+    for (size_t i = 0; i < n; ++i) { ids.push_back(int(i)); }
+    return ids;
+}
+
+mystl::vector<std::string> build_names(size_t n) {
+    _MYSTL_REALLOCATION_SITE();
+    mystl::vector<std::string> names;
+    for (size_t i = 0; i < n; ++i) { names.insert(names.begin(), std::to_string(i)); }
+    names.shrink_to_fit();
+    return names;
+}
+
+int main() {
+    size_t total = 0;
+    for (int round = 0; round < 100; ++round) {
+        total += collect_ids(1000).size();
+        total += collect_ids_reserved(1000).size();
+        total += build_names(50).size();
+    }
+    // 没有登记调用点的扩容归入 <unknown site>
+    mystl::vector<double> unknown;
+    for (int i = 0; i < 100; ++i) unknown.push_back(i);
+
+    auto& registry = mystl::reallocation_registry::instance();
+    auto top       = registry.top_sites(1);
+    assert(!top.empty() && std::string(top[0].site.function) == "collect_ids");
+    registry.report(std::cout, 10);
+    std::cout << "(" << total << " elements)" << std::endl;
+    return 0;
+}
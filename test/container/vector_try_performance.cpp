@@ -0,0 +1,52 @@
+// 以 -fno-exceptions 编译，见 CMakeLists.txt
+#include "timer.h"
+#include "vector.h"
+
+#include <iostream>
+
+// 比较 push_back/resize 与不抛出异常的 try_push_back/try_resize
+// try_* 在热路径上与抛出版本相同，只在扩容时多一次分配结果的检查
+
+constexpr size_t NUM_ELEMS  = 20000000;
+constexpr size_t NUM_ROUNDS = 10;
+
+template <class F>
+void run(const char* name, F f) {
+    mystl_test::Timer timer;
+    size_t sum = 0;
+    for (size_t r = 0; r < NUM_ROUNDS; ++r) { sum += f(); }
+    timer.stop();
+    std::cout << "  " << name << ": " << timer.elapsedMilliseconds() << "ms (" << sum << ")" << std::endl;
+}
+
+int main() {
+    std::cout << "mystl::vector<int>, " << NUM_ELEMS << " elements x " << NUM_ROUNDS << " rounds" << std::endl;
+    run("push_back", [] {
+        mystl::vector<int> v;
+        for (size_t i = 0; i < NUM_ELEMS; ++i) { v.push_back(int(i)); }
+        return v.size();
+    });
+    run("try_push_back", [] {
+        mystl::vector<int> v;
+        for (size_t i = 0; i < NUM_ELEMS; ++i) {
+            if (v.try_push_back(int(i)) != mystl::vector_status::ok) { return size_t(0); }
+        }
+        return v.size();
+    });
+    run("resize", [] {
+        mystl::vector<int> v;
+        for (size_t i = 1; i <= NUM_ELEMS; i *= 2) { v.resize(i, 1); }
+        return v.size();
+    });
+    run("try_resize", [] {
+        mystl::vector<int> v;
+        for (size_t i = 1; i <= NUM_ELEMS; i *= 2) {
+            if (v.try_resize(i, 1) != mystl::vector_status::ok) { return size_t(0); }
+        }
+        return v.size();
+    });
+
+    mystl::vector<int> v;
+    if (v.try_reserve(v.max_size() + 1) != mystl::vector_status::length_error) { return 1; }
+    return 0;
+}
@@ -8,7 +8,7 @@ _MYSTL_BEGIN_NAMESPACE_MYSTL_TEST
 
 struct WrapInt {
     int value;
-    static unsigned int count;
+    static inline unsigned int count = 0;
 
     WrapInt() : value(count) { count += 1; }
 };
@@ -25,6 +25,8 @@ struct NonTrivialData {
     ~NonTrivialData() { delete[] data; }
 
     NonTrivialData(const NonTrivialData& other) {
+        copies += 1;
+
         c    = other.c;
         flag = other.flag;
         data = new int[10];
@@ -32,6 +34,7 @@ struct NonTrivialData {
     }
 
     NonTrivialData& operator=(const NonTrivialData& other) {
+        copies += 1;
         if (this != &other) {
             delete[] data;
             data = new int[10];
@@ -44,12 +47,15 @@ struct NonTrivialData {
 
     // 移动构造
     NonTrivialData(NonTrivialData&& other) noexcept {
+        moves += 1;
+
         data       = other.data;
         other.data = nullptr;
     }
 
     // 移动赋值
     NonTrivialData& operator=(NonTrivialData&& other) noexcept {
+        moves += 1;
         if (this != &other) {
             delete[] data;
             data       = other.data;
@@ -61,7 +67,11 @@ struct NonTrivialData {
     int c     = 0;
     bool flag = false;
     int* data = nullptr;
-    static unsigned int count;
+
+    static inline unsigned int count = 0;
+    // 拷贝与移动 (构造和赋值) 的次数
+    static inline unsigned int copies = 0;
+    static inline unsigned int moves  = 0;
 };
 
 // 平凡类
@@ -1,9 +1,39 @@
+#include "test_concurrent_vector.h"
+#include "test_eytzinger_index.h"
+#include "test_flat_map.h"
+#include "test_hardening.h"
+#include "test_incremental_vector.h"
+#include "test_inplace_vector.h"
 #include "test_list.h"
+#include "test_mapped_vector.h"
+#include "test_segmented_vector.h"
+#include "test_serialize.h"
+#include "test_small_vector.h"
+#include "test_soa_vector.h"
+#include "test_stream_copy.h"
 #include "test_vector.h"
+#include "test_vector_bool.h"
+#include "test_vector_io.h"
+#include "test_vector_telemetry.h"
 
 using namespace mystl_test;
 int main() {
     // list_test::test_all();
     vector_test::test_all();
+    vector_bool_test::test_all();
+    small_vector_test::test_all();
+    inplace_vector_test::test_all();
+    mapped_vector_test::test_all();
+    serialize_test::test_all();
+    vector_io_test::test_all();
+    segmented_vector_test::test_all();
+    concurrent_vector_test::test_all();
+    soa_vector_test::test_all();
+    flat_map_test::test_all();
+    vector_telemetry_test::test_all();
+    stream_copy_test::test_all();
+    incremental_vector_test::test_all();
+    hardening_test::test_all();
+    eytzinger_index_test::test_all();
     return 0;
-}
\ No newline at end of file
+}